@@ -31,11 +31,16 @@
 #include <bitcoin/database/locks/flush_lock.hpp>
 #include <bitcoin/database/locks/interprocess_lock.hpp>
 #include <bitcoin/database/locks/locks.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
 #include <bitcoin/database/memory/accessor.hpp>
+#include <bitcoin/database/memory/advice.hpp>
+#include <bitcoin/database/memory/anonymous_map.hpp>
 #include <bitcoin/database/memory/finalizer.hpp>
 #include <bitcoin/database/memory/map.hpp>
 #include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/memory/pool.hpp>
 #include <bitcoin/database/memory/reader.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
 #include <bitcoin/database/memory/simple_reader.hpp>
 #include <bitcoin/database/memory/simple_writer.hpp>
 #include <bitcoin/database/memory/streamers.hpp>
@@ -43,12 +48,18 @@
 #include <bitcoin/database/memory/interfaces/memory.hpp>
 #include <bitcoin/database/memory/interfaces/storage.hpp>
 #include <bitcoin/database/primitives/arraymap.hpp>
+#include <bitcoin/database/primitives/filter.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
 #include <bitcoin/database/primitives/hashmap.hpp>
 #include <bitcoin/database/primitives/head.hpp>
+#include <bitcoin/database/primitives/indexmap.hpp>
 #include <bitcoin/database/primitives/iterator.hpp>
 #include <bitcoin/database/primitives/linkage.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/matcher.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/primitives/probemap.hpp>
+#include <bitcoin/database/primitives/view.hpp>
 #include <bitcoin/database/tables/context.hpp>
 #include <bitcoin/database/tables/event.hpp>
 #include <bitcoin/database/tables/schema.hpp>
@@ -65,6 +76,8 @@
 #include <bitcoin/database/tables/caches/validated_bk.hpp>
 #include <bitcoin/database/tables/caches/validated_tx.hpp>
 #include <bitcoin/database/tables/indexes/height.hpp>
+#include <bitcoin/database/tables/indexes/lineage.hpp>
+#include <bitcoin/database/tables/indexes/strong.hpp>
 #include <bitcoin/database/tables/indexes/strong_tx.hpp>
 #include <bitcoin/database/tables/optionals/address.hpp>
 #include <bitcoin/database/tables/optionals/bootstrap.hpp>
@@ -49,6 +49,8 @@ enum error_t : uint8_t
     reload_locked,
     flush_unloaded,
     flush_failure,
+    sync_unloaded,
+    sync_failure,
     unload_locked,
     unload_failure,
 
@@ -59,6 +61,9 @@ enum error_t : uint8_t
     munmap_failure,
     madvise_failure,
     ftruncate_failure,
+    fallocate_failure,
+    pread_failure,
+    pwrite_failure,
     fsync_failure,
 
     /// locks
@@ -77,6 +82,7 @@ enum error_t : uint8_t
     /// store
     missing_snapshot,
     unloaded_file,
+    store_format,
 
     /// tables
     create_table,
@@ -84,6 +90,9 @@ enum error_t : uint8_t
     backup_table,
     restore_table,
     verify_table,
+    maintain_table,
+    scan_table,
+    scan_stopped,
 
     /// validation/confirmation
     tx_connected,
@@ -119,6 +128,8 @@ enum error_t : uint8_t
 
     /// header archive
     header_put,
+    header_lineage_set,
+    header_reserve,
 
     /// txs archive
     txs_header,
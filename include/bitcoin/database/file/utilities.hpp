@@ -54,6 +54,12 @@ BCD_API bool create_file(const path& to, const uint8_t* data,
 BCD_API code create_file_ex(const path& to, const uint8_t* data,
     size_t size) NOEXCEPT;
 
+/// Read file of exactly size bytes into data.
+/// False if did not exist/error or file is not of size.
+BCD_API bool read_file(const path& from, uint8_t* data, size_t size) NOEXCEPT;
+BCD_API code read_file_ex(const path& from, uint8_t* data,
+    size_t size) NOEXCEPT;
+
 /// Delete file or empty directory, false on error only.
 BCD_API bool remove(const path& name) NOEXCEPT;
 BCD_API code remove_ex(const path& name) NOEXCEPT;
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_RECYCLER_IPP
+#define LIBBITCOIN_DATABASE_MEMORY_RECYCLER_IPP
+
+#include <new>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_REINTERPRET_CAST)
+
+TEMPLATE
+inline Type* CLASS::allocate(size_t count) THROWS
+{
+    // Arrays are not recycled (allocate_shared allocates a single block).
+    if (count != one)
+        return static_cast<Type*>(::operator new(count * sizeof(Type),
+            std::align_val_t{ alignof(Type) }));
+
+    auto& list = local();
+    if (is_null(list.top))
+        return static_cast<Type*>(allocate_block());
+
+    const auto top = list.top;
+    list.top = top->next;
+    --list.count;
+    return reinterpret_cast<Type*>(top);
+}
+
+TEMPLATE
+inline void CLASS::deallocate(Type* ptr, size_t count) NOEXCEPT
+{
+    if (count != one)
+    {
+        ::operator delete(ptr, std::align_val_t{ alignof(Type) });
+        return;
+    }
+
+    auto& list = local();
+    if (list.count >= Limit)
+    {
+        deallocate_block(ptr);
+        return;
+    }
+
+    const auto top = reinterpret_cast<node*>(ptr);
+    top->next = list.top;
+    list.top = top;
+    ++list.count;
+}
+
+TEMPLATE
+inline size_t CLASS::cached() NOEXCEPT
+{
+    return local().count;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+inline CLASS::pool::~pool() NOEXCEPT
+{
+    while (!is_null(top))
+    {
+        const auto next = top->next;
+        deallocate_block(top);
+        top = next;
+    }
+}
+
+TEMPLATE
+inline typename CLASS::pool& CLASS::local() NOEXCEPT
+{
+    // One free list per thread per recycled type, released at thread exit.
+    thread_local pool list{};
+    return list;
+}
+
+TEMPLATE
+inline void* CLASS::allocate_block() THROWS
+{
+    return ::operator new(block, std::align_val_t{ align });
+}
+
+TEMPLATE
+inline void CLASS::deallocate_block(void* ptr) NOEXCEPT
+{
+    ::operator delete(ptr, std::align_val_t{ align });
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
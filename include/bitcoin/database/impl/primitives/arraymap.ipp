@@ -19,6 +19,10 @@
 #ifndef LIBBITCOIN_DATABASE_PRIMITIVES_ARRAYMAP_IPP
 #define LIBBITCOIN_DATABASE_PRIMITIVES_ARRAYMAP_IPP
 
+#include <algorithm>
+#include <atomic>
+#include <span>
+#include <thread>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 
@@ -58,8 +62,29 @@ TEMPLATE
 bool CLASS::restore() NOEXCEPT
 {
     Link count{};
-    return head_.verify() &&
-        head_.get_body_count(count) && manager_.truncate(count);
+    if (!head_.verify() || !head_.get_body_count(count))
+        return false;
+
+    // Truncated records may be reallocated by expansion, and are not set
+    // unless zeroed (see expand).
+    if constexpr (!is_slab)
+    {
+        const auto ptr = manager_.get_write();
+        if (!ptr)
+            return false;
+
+        const auto end = manager_.count().value;
+        for (auto index = count.value; index < end; ++index)
+        {
+            const auto offset = ptr->offset(manager::link_to_position(index));
+            if (is_null(offset))
+                return false;
+
+            std::fill_n(offset, Size, uint8_t{});
+        }
+    }
+
+    return manager_.truncate(count);
 }
 
 TEMPLATE
@@ -124,6 +149,104 @@ code CLASS::reload() NOEXCEPT
     return manager_.reload();
 }
 
+// scan
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+code CLASS::scan(const visitor<Element>& visit,
+    size_t threads) const NOEXCEPT
+{
+    using namespace system;
+    using integer = typename Link::integer;
+    const auto count = possible_narrow_cast<size_t>(manager_.count().value);
+
+    if constexpr (is_slab)
+    {
+        Element element{};
+        for (size_t start = zero; start < count;)
+        {
+            const auto ptr = manager_.get();
+            if (!ptr)
+                return error::scan_table;
+
+            const auto end = std::min(count, start + scan_bytes);
+            while (start < end)
+            {
+                const auto offset = ptr->offset(start);
+                if (is_null(offset))
+                    return error::scan_table;
+
+                iostream stream{ offset, ptr->size() -
+                    possible_narrow_and_sign_cast<ptrdiff_t>(start) };
+
+                reader source{ stream };
+                const Link link{ possible_narrow_cast<integer>(start) };
+                if (!element.from_data(source) ||
+                    is_zero(source.get_read_position()))
+                    return error::scan_table;
+
+                if (!visit(link, element))
+                    return error::scan_stopped;
+
+                start += source.get_read_position();
+            }
+        }
+
+        return error::success;
+    }
+    else
+    {
+        const auto ranges = ceilinged_divide(count, scan_records);
+        std::atomic<size_t> next{};
+        std::atomic<error::error_t> result{ error::success };
+
+        // The first stop (or failure) of any worker is the result.
+        const auto stop = [&](error::error_t ec) NOEXCEPT
+        {
+            auto expected = error::success;
+            result.compare_exchange_strong(expected, ec);
+        };
+
+        const auto work = [&]() NOEXCEPT
+        {
+            Element element{};
+            for (auto range = next++; (result == error::success) &&
+                range < ranges; range = next++)
+            {
+                const auto ptr = manager_.get();
+                const auto end = std::min(count, (range + one) * scan_records);
+                for (auto index = range * scan_records; index < end; ++index)
+                {
+                    const Link link{ possible_narrow_cast<integer>(index) };
+                    if (!read(ptr, link, element))
+                    {
+                        stop(error::scan_table);
+                        return;
+                    }
+
+                    if (!visit(link, element))
+                    {
+                        stop(error::scan_stopped);
+                        return;
+                    }
+                }
+            }
+        };
+
+        // The calling thread is the first worker.
+        std_vector<std::thread> workers{};
+        for (size_t worker = one; worker < std::min(threads, ranges); ++worker)
+            workers.emplace_back(work);
+
+        work();
+        for (auto& worker: workers)
+            worker.join();
+
+        return result.load();
+    }
+}
+
 // query interface
 // ----------------------------------------------------------------------------
 
@@ -136,10 +259,57 @@ bool CLASS::get(const Link& link, Element& element) const NOEXCEPT
     if (!ptr)
         return false;
 
-    iostream stream{ *ptr };
-    reader source{ stream };
-    if constexpr (!is_slab) { source.set_limit(Size); }
-    return element.from_data(source);
+    if constexpr (is_view<Element>)
+    {
+        // View reads fields from record at static offsets (no stream).
+        static_assert(!is_slab, "view requires fixed record size");
+        if (is_lesser(ptr->size(), Size))
+            return false;
+
+        return element.from_memory(ptr->begin());
+    }
+    else
+    {
+        iostream stream{ *ptr };
+        reader source{ stream };
+        if constexpr (!is_slab) { source.set_limit(Size); }
+        return element.from_data(source);
+    }
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get_many(const std::span<const Link>& links,
+    std_vector<Element>& elements) const NOEXCEPT
+{
+    const auto ptr = manager_.get();
+    elements.resize(links.size());
+    if (!ptr)
+        return false;
+
+    auto result = true;
+    for (size_t start = 0; start < links.size(); start += group)
+    {
+        const auto end = std::min(links.size(), start + group);
+
+        // Prefetch elements.
+        for (auto index = start; index < end; ++index)
+        {
+            const auto& link = links[index];
+            if (link.is_terminal())
+                continue;
+
+            const auto offset = ptr->offset(manager::link_to_position(link));
+            if (!is_null(offset))
+                prefetch(offset);
+        }
+
+        // Read elements.
+        for (auto index = start; index < end; ++index)
+            result &= read(ptr, links[index], elements.at(index));
+    }
+
+    return result;
 }
 
 TEMPLATE
@@ -157,7 +327,7 @@ bool CLASS::put_link(Link& link, const Element& element) NOEXCEPT
     using namespace system;
     const auto count = element.count();
     link = manager_.allocate(count);
-    const auto ptr = manager_.get(link);
+    const auto ptr = manager_.get_write(link);
     if (!ptr)
         return false;
 
@@ -175,6 +345,113 @@ Link CLASS::put_link(const Element& element) NOEXCEPT
     return put_link(link, element) ? link : Link{};
 }
 
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::set(const Link& link, const Element& element) NOEXCEPT
+{
+    return set_many({ &link, one }, element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::set_many(const std::span<const Link>& links,
+    const Element& element) NOEXCEPT
+{
+    using namespace system;
+    static_assert(!is_slab, "set requires fixed record size");
+    if (links.empty())
+        return true;
+
+    const auto last = *std::max_element(links.begin(), links.end(),
+        [](const Link& left, const Link& right) NOEXCEPT
+        {
+            return left.value < right.value;
+        });
+
+    // Expansion (which may remap) precedes memory.
+    if (last.is_terminal() || !expand(Link{ add1(last.value) }))
+        return false;
+
+    const auto ptr = manager_.get_write();
+    if (!ptr)
+        return false;
+
+    for (const auto& link: links)
+    {
+        const auto offset = ptr->offset(manager::link_to_position(link));
+        if (is_null(offset))
+            return false;
+
+        iostream stream{ offset, Size };
+        flipper sink{ stream };
+        BC_DEBUG_ONLY(sink.set_limit(Size);)
+        if (!element.to_data(sink))
+            return false;
+    }
+
+    return true;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::expand(const Link& count) NOEXCEPT
+{
+    using namespace system;
+    const auto current = manager_.count();
+    if (count.value <= current.value)
+        return true;
+
+    // A concurrent expansion may exceed count.
+    const Link size{ possible_narrow_cast<typename Link::integer>(
+        count.value - current.value) };
+
+    // Extended file is zero filled, and a zeroed record is not set. Records
+    // are published by allocation, so are not written here (a concurrent set
+    // of an expanded record may precede this return).
+    return !manager_.allocate(size).is_terminal();
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::read(const memory_ptr& ptr, const Link& link,
+    Element& element) NOEXCEPT
+{
+    if (!ptr || link.is_terminal())
+        return false;
+
+    using namespace system;
+    const auto start = manager::link_to_position(link);
+    if (is_limited<ptrdiff_t>(start))
+        return false;
+
+    const auto size = ptr->size();
+    const auto position = possible_narrow_and_sign_cast<ptrdiff_t>(start);
+    if (position > size)
+        return false;
+
+    const auto offset = ptr->offset(position);
+    if (is_null(offset))
+        return false;
+
+    if constexpr (is_view<Element>)
+    {
+        static_assert(!is_slab, "view requires fixed record size");
+        if (is_lesser(size - position, Size))
+            return false;
+
+        return element.from_memory(offset);
+    }
+    else
+    {
+        iostream stream{ offset, size - position };
+        reader source{ stream };
+        if constexpr (!is_slab) { source.set_limit(Size); }
+        return element.from_data(source);
+    }
+}
+
 } // namespace database
 } // namespace libbitcoin
 
@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_FILTER_IPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_FILTER_IPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+// Filters are not subject to resize/remap (other than reset, which is not
+// thread safe) and therefore do not require memory smart pointer with shared
+// remap lock. Using get_raw() saves that allocation.
+
+namespace libbitcoin {
+namespace database {
+
+TEMPLATE
+CLASS::filter(storage& file, size_t bytes) NOEXCEPT
+  : file_(file), blocks_(bytes / block)
+{
+}
+
+TEMPLATE
+bool CLASS::enabled() const NOEXCEPT
+{
+    return is_nonzero(blocks_);
+}
+
+TEMPLATE
+bool CLASS::create() NOEXCEPT
+{
+    return is_zero(file_.size()) && reset();
+}
+
+TEMPLATE
+bool CLASS::reset() NOEXCEPT
+{
+    if (!file_.truncate(zero))
+        return false;
+
+    if (!enabled())
+        return true;
+
+    const auto bytes = blocks_ * block;
+    if (file_.allocate(bytes) == storage::eof)
+        return false;
+
+    const auto raw = file_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    // Truncated memory is not cleared by storage.
+    std::fill_n(raw, bytes, uint8_t{});
+    return true;
+}
+
+TEMPLATE
+bool CLASS::verify() const NOEXCEPT
+{
+    return file_.size() == (blocks_ * block);
+}
+
+TEMPLATE
+void CLASS::add(const Key& key) NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    const auto at = to_position(key);
+    const auto raw = file_.get_raw(at.block * block);
+    if (is_null(raw))
+        return;
+
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto mask = at.mask.at(index);
+        if (is_zero(mask))
+            continue;
+
+        std::atomic_ref<word> value{ *system::pointer_cast<word>(
+            std::next(raw, index * sizeof(word))) };
+
+        // Avoid dirtying the page where bits are already set.
+        if ((value.load(std::memory_order_relaxed) & mask) != mask)
+            value.fetch_or(mask, std::memory_order_relaxed);
+    }
+}
+
+TEMPLATE
+bool CLASS::contains(const Key& key) const NOEXCEPT
+{
+    if (!enabled())
+        return true;
+
+    const auto at = to_position(key);
+    const auto raw = file_.get_raw(at.block * block);
+    if (is_null(raw))
+        return true;
+
+    for (size_t index = 0; index < words; ++index)
+    {
+        const auto mask = at.mask.at(index);
+        if (is_zero(mask))
+            continue;
+
+        const std::atomic_ref<word> value{ *system::pointer_cast<word>(
+            std::next(raw, index * sizeof(word))) };
+
+        if ((value.load(std::memory_order_relaxed) & mask) != mask)
+            return false;
+    }
+
+    return true;
+}
+
+TEMPLATE
+void CLASS::prefetch(const Key& key) const NOEXCEPT
+{
+    if (!enabled())
+        return;
+
+    const auto raw = file_.get_raw(to_position(key).block * block);
+    if (!is_null(raw))
+        database::prefetch(raw);
+}
+
+TEMPLATE
+double CLASS::rate() const NOEXCEPT
+{
+    if (!enabled())
+        return 1.0;
+
+    const auto raw = file_.get_raw();
+    if (is_null(raw))
+        return 1.0;
+
+    // An absent key is contained where all of its bits are set in its block.
+    double total{};
+    for (size_t index = 0; index < blocks_; ++index)
+    {
+        size_t bits{};
+        for (size_t offset = 0; offset < words; ++offset)
+        {
+            const std::atomic_ref<word> value{ *system::pointer_cast<word>(
+                std::next(raw, (index * words + offset) * sizeof(word))) };
+
+            bits += std::popcount(value.load(std::memory_order_relaxed));
+        }
+
+        total += std::pow(static_cast<double>(bits) / block_bits, selectors);
+    }
+
+    return total / blocks_;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+inline typename CLASS::position CLASS::to_position(
+    const Key& key) const NOEXCEPT
+{
+    using namespace system;
+    constexpr auto width = to_bits(sizeof(uint32_t));
+    BC_ASSERT(blocks_ <= add1<uint64_t>(max_uint32));
+
+    // Fingerprint is independent of head bucket and head fingerprint (mix).
+    const auto fingerprint = mix_hasher::mix(
+        bit_not(possible_narrow_cast<uint64_t>(Hash::hash(key))));
+
+    // Block is selected by multiply-shift of the high order 32 bits.
+    const auto high = possible_narrow_cast<uint32_t>(fingerprint >> width);
+    position at{};
+    at.block = possible_narrow_cast<size_t>((uint64_t{ high } * blocks_) >>
+        width);
+
+    // Bits within block are selected from a remix of the fingerprint.
+    auto selector = mix_hasher::mix(fingerprint);
+    for (size_t count = 0; count < selectors; ++count)
+    {
+        const auto bit = possible_narrow_cast<size_t>(selector %
+            block_bits);
+
+        at.mask.at(bit / word_bits) |= (word{ 1 } << (bit % word_bits));
+        selector >>= selector_bits;
+    }
+
+    return at;
+}
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
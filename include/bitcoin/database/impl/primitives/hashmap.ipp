@@ -20,6 +20,11 @@
 #define LIBBITCOIN_DATABASE_PRIMITIVES_HASHMAP_IPP
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 
@@ -27,8 +32,18 @@ namespace libbitcoin {
 namespace database {
 
 TEMPLATE
-CLASS::hashmap(storage& header, storage& body, const Link& buckets) NOEXCEPT
-  : head_(header, buckets), manager_(body)
+CLASS::hashmap(storage& header, storage& body, const Link& buckets,
+    bool aligned, size_t load) NOEXCEPT
+  : head_(header, buckets, aligned), manager_(body), load_(load)
+{
+}
+
+TEMPLATE
+CLASS::hashmap(storage& header, storage& body, storage& filter,
+    size_t filter_bytes, const Link& buckets, bool aligned,
+    size_t load) NOEXCEPT
+  : head_(header, buckets, aligned), manager_(body), load_(load),
+    filter_(std::in_place, filter, filter_bytes)
 {
 }
 
@@ -40,7 +55,7 @@ bool CLASS::create() NOEXCEPT
 {
     Link count{};
     return head_.create() && head_.get_body_count(count) &&
-        manager_.truncate(count);
+        manager_.truncate(count) && (!filter_ || filter_->create());
 }
 
 TEMPLATE
@@ -59,16 +74,19 @@ TEMPLATE
 bool CLASS::restore() NOEXCEPT
 {
     Link count{};
-    return head_.verify() && head_.get_body_count(count) &&
-        manager_.truncate(count);
+    // Filter may not reflect the restored body, so is always rebuilt.
+    return head_.open() && head_.get_body_count(count) &&
+        manager_.truncate(count) && (!filter_ || rebuild());
 }
 
 TEMPLATE
-bool CLASS::verify() const NOEXCEPT
+bool CLASS::verify() NOEXCEPT
 {
     Link count{};
-    return head_.verify() && head_.get_body_count(count) &&
-        (count == manager_.count());
+    // Filter is rebuilt if resized by configuration.
+    return head_.open() && head_.get_body_count(count) &&
+        (count == manager_.count()) &&
+        (!filter_ || filter_->verify() || rebuild());
 }
 
 // sizing
@@ -104,6 +122,12 @@ Link CLASS::count() const NOEXCEPT
     return manager_.count();
 }
 
+TEMPLATE
+double CLASS::filter_rate() const NOEXCEPT
+{
+    return filter_ ? filter_->rate() : 1.0;
+}
+
 // query interface
 // ----------------------------------------------------------------------------
 
@@ -125,12 +149,191 @@ code CLASS::reload() NOEXCEPT
     return manager_.reload();
 }
 
+// growth
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::is_migrating() const NOEXCEPT
+{
+    return head_.is_migrating();
+}
+
+TEMPLATE
+bool CLASS::grow() NOEXCEPT
+{
+    std::unique_lock lock{ scan_mutex_ };
+    return grow_();
+}
+
+TEMPLATE
+bool CLASS::rehash(size_t count) NOEXCEPT
+{
+    std::unique_lock lock{ scan_mutex_ };
+    return rehash_(count);
+}
+
+TEMPLATE
+bool CLASS::maintain() NOEXCEPT
+{
+    // Bucket ranges of a scan are fixed, so maintenance awaits its completion.
+    std::unique_lock lock{ scan_mutex_, std::try_to_lock };
+    if (!lock.owns_lock())
+        return true;
+
+    if (head_.is_migrating())
+        return rehash_(rehash_buckets);
+
+    if (is_nonzero(load_) && (count() / load_) > buckets())
+        return grow_();
+
+    return true;
+}
+
+// private
+TEMPLATE
+bool CLASS::grow_() NOEXCEPT
+{
+    // Exclusive access to body precludes all head and list access.
+    const auto ptr = manager_.get_exclusive();
+    return ptr && head_.grow();
+}
+
+// private
+TEMPLATE
+bool CLASS::rehash_(size_t count) NOEXCEPT
+{
+    using namespace system;
+
+    // Exclusive access to body precludes all head and list access.
+    const auto ptr = manager_.get_exclusive();
+    if (!ptr)
+        return false;
+
+    std::vector<Link> links{};
+    for (; is_nonzero(count) && head_.is_migrating(); --count)
+    {
+        // Each prior bucket maps only to current buckets of its own keys, and
+        // these are empty until migrated, so list order is retained by pushing
+        // from oldest to newest element.
+        links.clear();
+        for (auto link = head_.top(head_.cursor()); !link.is_terminal();)
+        {
+            const auto offset = ptr->offset(manager::link_to_position(link));
+            if (is_null(offset))
+                return false;
+
+            links.push_back(link);
+            link = unsafe_array_cast<uint8_t, Link::size>(offset);
+        }
+
+        for (auto it = links.rbegin(); it != links.rend(); ++it)
+        {
+            const auto offset = ptr->offset(manager::link_to_position(*it));
+            const auto& key = unsafe_array_cast<uint8_t, array_count<Key>>(
+                std::next(offset, Link::size));
+
+            auto& next = unsafe_array_cast<uint8_t, Link::size>(offset);
+            if (!head_.push(*it, next, key, head_.rehash(key)))
+                return false;
+        }
+
+        if (!head_.advance())
+            return false;
+    }
+
+    return true;
+}
+
+// scan
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+code CLASS::scan(const visitor<Element>& visit,
+    size_t threads) const NOEXCEPT
+{
+    using namespace system;
+
+    // Precludes growth and migration, which would move elements across ranges.
+    std::shared_lock lock{ scan_mutex_ };
+    const auto buckets = head_.buckets();
+    const auto ranges = ceilinged_divide(buckets, scan_buckets);
+    std::atomic<size_t> next{};
+    std::atomic<error::error_t> result{ error::success };
+
+    // The first stop (or failure) of any worker is the result.
+    const auto stop = [&](error::error_t ec) NOEXCEPT
+    {
+        auto expected = error::success;
+        result.compare_exchange_strong(expected, ec);
+    };
+
+    const auto work = [&]() NOEXCEPT
+    {
+        Element element{};
+        for (auto range = next++; (result == error::success) &&
+            range < ranges; range = next++)
+        {
+            // Memory is obtained per range, so that writers may remap.
+            const auto ptr = get_memory();
+            if (!ptr)
+            {
+                stop(error::scan_table);
+                return;
+            }
+
+            const auto end = std::min(buckets, (range + one) * scan_buckets);
+
+            for (auto index = range * scan_buckets; index < end; ++index)
+            {
+                const Link bucket{ possible_narrow_cast<typename Link::integer>(
+                    index) };
+
+                for (auto link = head_.top(bucket); !link.is_terminal();)
+                {
+                    const auto offset = ptr->offset(
+                        manager::link_to_position(link));
+
+                    if (is_null(offset) || !read(ptr, link, element))
+                    {
+                        stop(error::scan_table);
+                        return;
+                    }
+
+                    if (!visit(link, unsafe_array_cast<uint8_t,
+                        array_count<Key>>(std::next(offset, Link::size)),
+                        element))
+                    {
+                        stop(error::scan_stopped);
+                        return;
+                    }
+
+                    link = unsafe_array_cast<uint8_t, Link::size>(offset);
+                }
+            }
+        }
+    };
+
+    // The calling thread is the first worker.
+    std_vector<std::thread> workers{};
+    for (size_t count = one; count < std::min(threads, ranges); ++count)
+        workers.emplace_back(work);
+
+    work();
+    for (auto& worker: workers)
+        worker.join();
+
+    return result.load();
+}
+
 // query interface
 // ----------------------------------------------------------------------------
 
 TEMPLATE
 Link CLASS::top(const Link& link) const NOEXCEPT
 {
+    // Shared access to body precludes concurrent growth of head.
+    const auto ptr = get_memory();
     if (link >= head_.buckets())
         return {};
 
@@ -147,14 +350,37 @@ TEMPLATE
 Link CLASS::first(const Key& key) const NOEXCEPT
 {
     ////return it(key).self();
-    return first(get_memory(), head_.top(key), key);
+    if (filter_ && !filter_->contains(key))
+        return {};
+
+    // Memory is obtained first, precluding concurrent growth of head.
+    const auto ptr = get_memory();
+    return first(ptr, head_.top(key), key);
 }
 
 TEMPLATE
 typename CLASS::iterator CLASS::it(const Key& key) const NOEXCEPT
 {
-    return { get_memory(), head_.top(key), key };
+    // Braced initialization is evaluated in order (memory precedes top).
+    return { get_memory(), filtered_top(key), key };
 }
+
+TEMPLATE
+typename CLASS::borrowed_iterator CLASS::it(const guard& memory,
+    const Key& key) const NOEXCEPT
+{
+    // Guard memory precedes top, precluding concurrent growth of head.
+    return { memory, filtered_top(key), key };
+}
+
+TEMPLATE
+std_vector<Link> CLASS::first_many(
+    const std::span<const Key>& keys) const NOEXCEPT
+{
+    // Memory is obtained first, precluding concurrent growth of head.
+    return first_many(get_memory(), keys);
+}
+
 TEMPLATE
 Link CLASS::allocate(const Link& size) NOEXCEPT
 {
@@ -167,6 +393,12 @@ memory_ptr CLASS::get_memory() const NOEXCEPT
     return manager_.get();
 }
 
+TEMPLATE
+guard CLASS::get_guard() const NOEXCEPT
+{
+    return guard{ get_memory() };
+}
+
 TEMPLATE
 Key CLASS::get_key(const Link& link) NOEXCEPT
 {
@@ -184,7 +416,24 @@ bool CLASS::find(const Key& key, Element& element) const NOEXCEPT
 {
     // This override avoids duplicated memory_ptr construct in get(first()).
     const auto ptr = get_memory();
-    return read(ptr, first(ptr, head_.top(key), key), element);
+    return read(ptr, first(ptr, filtered_top(key), key), element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::find_many(const std::span<const Key>& keys,
+    std_vector<Element>& elements) const NOEXCEPT
+{
+    // Elements are read from memory of the keys search (one memory_ptr).
+    const auto ptr = get_memory();
+    const auto links = first_many(ptr, keys);
+    elements.resize(links.size());
+
+    auto result = true;
+    for (size_t index = 0; index < links.size(); ++index)
+        result &= read(ptr, links.at(index), elements.at(index));
+
+    return result;
 }
 
 TEMPLATE
@@ -224,12 +473,41 @@ bool CLASS::get(const memory_ptr& ptr, const Link& link,
     return read(ptr, link, element);
 }
 
+// static
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const borrowed_iterator& it, Element& element) NOEXCEPT
+{
+    // This override avoids deadlock when holding guard of the same table.
+    return read(it.get(), it.self(), element);
+}
+
+// static
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const borrowed_iterator& it, const Link& link,
+    Element& element) NOEXCEPT
+{
+    // This override avoids deadlock when holding guard of the same table.
+    return read(it.get(), link, element);
+}
+
+// static
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const guard& memory, const Link& link,
+    Element& element) NOEXCEPT
+{
+    // This override avoids deadlock when holding guard of the same table.
+    return read(memory.get(), link, element);
+}
+
 TEMPLATE
 template <typename Element, if_equal<Element::size, Size>>
 bool CLASS::set(const Link& link, const Element& element) NOEXCEPT
 {
     using namespace system;
-    const auto ptr = manager_.get(link);
+    const auto ptr = manager_.get_write(link);
     if (!ptr)
         return false;
 
@@ -279,7 +557,8 @@ bool CLASS::put_link(Link& link, const Key& key,
     using namespace system;
     const auto count = element.count();
     link = allocate(count);
-    const auto ptr = manager_.get(link);
+
+    const auto ptr = manager_.get_write(link);
     if (!ptr)
         return false;
 
@@ -289,9 +568,17 @@ bool CLASS::put_link(Link& link, const Key& key,
     sink.skip_bytes(Link::size);
     sink.write_bytes(key);
 
-    if constexpr (!is_slab) { BC_DEBUG_ONLY(sink.set_limit(Size * count);) }
+    if constexpr (!is_slab)
+    {
+        BC_DEBUG_ONLY(sink.set_limit(Size * count);)
+    }
     auto& next = unsafe_array_cast<uint8_t, Link::size>(ptr->begin());
-    return element.to_data(sink) && head_.push(link, next, head_.index(key));
+    if (!element.to_data(sink))
+        return false;
+
+    // Filter precedes publication of the element.
+    if (filter_) filter_->add(key);
+    return head_.push(link, next, key);
 }
 
 TEMPLATE
@@ -308,7 +595,8 @@ bool CLASS::put(const Link& link, const Key& key,
 {
     using namespace system;
     const auto count = element.count();
-    const auto ptr = manager_.get(link);
+
+    const auto ptr = manager_.get_write(link);
     if (!ptr)
         return false;
 
@@ -318,15 +606,99 @@ bool CLASS::put(const Link& link, const Key& key,
     sink.skip_bytes(Link::size);
     sink.write_bytes(key);
 
-    if constexpr (!is_slab) { BC_DEBUG_ONLY(sink.set_limit(Size * count);) }
+    if constexpr (!is_slab)
+    {
+        BC_DEBUG_ONLY(sink.set_limit(Size * count);)
+    }
     auto& next = unsafe_array_cast<uint8_t, Link::size>(ptr->begin());
-    return element.to_data(sink) && head_.push(link, next, head_.index(key));
+    if (!element.to_data(sink))
+        return false;
+
+    // Filter precedes publication of the element.
+    if (filter_) filter_->add(key);
+    return head_.push(link, next, key);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put_many(const std::span<const Key>& keys,
+    const std::span<const Element>& elements) NOEXCEPT
+{
+    std_vector<Link> links{};
+    return put_many(keys, elements, links);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put_many(const std::span<const Key>& keys,
+    const std::span<const Element>& elements,
+    std_vector<Link>& links) NOEXCEPT
+{
+    using namespace system;
+    static_assert(!is_slab, "bulk put requires fixed record size");
+    using integer = typename Link::integer;
+
+    const auto count = keys.size();
+    if (count != elements.size() || count >= Link::terminal)
+        return false;
+
+    links.resize(count);
+    if (is_zero(count))
+        return true;
+
+    // Allocation (which may remap) precedes memory, in one allocation.
+    auto link = allocate(Link{ possible_narrow_cast<integer>(count) });
+    if (link.is_terminal())
+        return false;
+
+    {
+        // Memory is obtained first, precluding concurrent growth of head.
+        const auto ptr = manager_.get_write();
+        if (!ptr)
+            return false;
+
+        // Stable order by bucket (input order retained within bucket).
+        std_vector<std::pair<integer, size_t>> order(count);
+        for (size_t index = 0; index < count; ++index)
+            order.at(index) = { head_.index(keys[index]).value, index };
+
+        std::sort(order.begin(), order.end());
+
+        for (const auto& [bucket, index]: order)
+        {
+            const auto offset = ptr->offset(manager::link_to_position(link));
+            if (is_null(offset))
+                return false;
+
+            // iostream.flush is a nop (direct copy).
+            const auto& key = keys[index];
+            iostream stream{ offset, index_size + Size };
+            finalizer sink{ stream };
+            sink.skip_bytes(Link::size);
+            sink.write_bytes(key);
+
+            BC_DEBUG_ONLY(sink.set_limit(Size);)
+            auto& next = unsafe_array_cast<uint8_t, Link::size>(offset);
+            if (!elements[index].to_data(sink))
+                return false;
+
+            // Filter precedes publication of the element.
+            if (filter_) filter_->add(key);
+            if (!head_.push(link, next, key, Link{ bucket }))
+                return false;
+
+            links.at(index) = link;
+            ++link.value;
+        }
+    }
+
+    return true;
 }
 
 TEMPLATE
 bool CLASS::commit(const Link& link, const Key& key) NOEXCEPT
 {
-    const auto ptr = manager_.get(link);
+    const auto ptr = manager_.get_write(link);
     if (!ptr)
         return false;
 
@@ -334,9 +706,11 @@ bool CLASS::commit(const Link& link, const Key& key) NOEXCEPT
     system::unsafe_array_cast<uint8_t, array_count<Key>>(
         std::next(ptr->begin(), Link::size)) = key;
 
-    // Commit element to search index.
-    auto& next = system::unsafe_array_cast<uint8_t, Link::size>(ptr->begin());
-    return head_.push(link, next, head_.index(key));
+    // Commit element to search index (filter precedes publication).
+    if (filter_) filter_->add(key);
+    auto& next = system::unsafe_array_cast<uint8_t, Link::size>(
+        ptr->begin());
+    return head_.push(link, next, key);
 }
 
 TEMPLATE
@@ -348,6 +722,105 @@ Link CLASS::commit_link(const Link& link, const Key& key) NOEXCEPT
     return link;
 }
 
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+Link CLASS::filtered_top(const Key& key) const NOEXCEPT
+{
+    // Key excluded by filter is absent, without reading head or body.
+    if (filter_ && !filter_->contains(key))
+        return {};
+
+    return head_.top(key);
+}
+
+TEMPLATE
+std_vector<Link> CLASS::first_many(const memory_ptr& ptr,
+    const std::span<const Key>& keys) const NOEXCEPT
+{
+    std_vector<Link> links(keys.size());
+    if (!ptr)
+        return links;
+
+    for (size_t start = 0; start < keys.size(); start += group)
+    {
+        const auto end = std::min(keys.size(), start + group);
+        std_array<bool, group> excluded{};
+
+        // Prefetch filter blocks.
+        if (filter_)
+            for (auto index = start; index < end; ++index)
+                filter_->prefetch(keys[index]);
+
+        // Read filter blocks, prefetch buckets of keys not excluded.
+        for (auto index = start; index < end; ++index)
+        {
+            const auto& key = keys[index];
+            auto& exclude = excluded.at(index - start);
+            exclude = filter_ && !filter_->contains(key);
+            if (!exclude)
+                head_.prefetch(key);
+        }
+
+        // Read buckets, prefetch first elements.
+        for (auto index = start; index < end; ++index)
+        {
+            if (excluded.at(index - start))
+                continue;
+
+            auto& link = links.at(index);
+            link = head_.top(keys[index]);
+            if (link.is_terminal())
+                continue;
+
+            const auto offset = ptr->offset(manager::link_to_position(link));
+            if (!is_null(offset))
+                prefetch(offset);
+        }
+
+        // Read elements, conflicts (if any) are not prefetched.
+        for (auto index = start; index < end; ++index)
+            links.at(index) = first(ptr, links.at(index), keys[index]);
+    }
+
+    return links;
+}
+
+TEMPLATE
+bool CLASS::rebuild() NOEXCEPT
+{
+    using namespace system;
+    if (!filter_->reset())
+        return false;
+
+    if (!filter_->enabled() || is_zero(body_size()))
+        return true;
+
+    const auto ptr = get_memory();
+    if (!ptr)
+        return false;
+
+    // All elements are reachable from head (including unmigrated buckets).
+    for (size_t index = 0; index < head_.buckets(); ++index)
+    {
+        const auto bucket = possible_narrow_cast<typename Link::integer>(index);
+        for (auto link = head_.top(Link{ bucket }); !link.is_terminal();)
+        {
+            const auto offset = ptr->offset(manager::link_to_position(link));
+            if (is_null(offset))
+                return false;
+
+            filter_->add(unsafe_array_cast<uint8_t, array_count<Key>>(
+                std::next(offset, Link::size)));
+
+            link = unsafe_array_cast<uint8_t, Link::size>(offset);
+        }
+    }
+
+    return true;
+}
+
 // protected/static
 // ----------------------------------------------------------------------------
 
@@ -373,38 +846,58 @@ bool CLASS::read(const memory_ptr& ptr, const Link& link,
     if (is_null(offset))
         return false;
 
-    // Stream starts at record and the index is skipped for reader convenience.
-    iostream stream{ offset, size - position };
-    reader source{ stream };
-    source.skip_bytes(index_size);
+    if constexpr (is_view<Element>)
+    {
+        // View reads fields from key at static offsets (no stream).
+        static_assert(!is_slab, "view requires fixed record size");
+        if (is_lesser(size - position, index_size + Size))
+            return false;
+
+        return element.from_memory(std::next(offset, Link::size));
+    }
+    else
+    {
+        // Stream starts at record, index is skipped for reader convenience.
+        iostream stream{ offset, size - position };
+        reader source{ stream };
+        source.skip_bytes(index_size);
 
-    if constexpr (!is_slab) { BC_DEBUG_ONLY(source.set_limit(Size);) }
-    return element.from_data(source);
+        if constexpr (!is_slab) { BC_DEBUG_ONLY(source.set_limit(Size);) }
+        return element.from_data(source);
+    }
 }
 
 TEMPLATE
 Link CLASS::first(const memory_ptr& ptr, Link link, const Key& key) NOEXCEPT
 {
-    if (!ptr)
+    if (!ptr || link.is_terminal())
         return {};
 
-    while (!link.is_terminal())
+    // get element offset (fault)
+    auto offset = ptr->offset(manager::link_to_position(link));
+    while (!is_null(offset))
     {
-        // get element offset (fault)
-        const auto offset = ptr->offset(manager::link_to_position(link));
-        if (is_null(offset))
-            return {};
+        // get next element offset (fault), prefetch before key comparison
+        const auto next = match::next(offset);
+        const auto next_offset = next.is_terminal() ? nullptr :
+            ptr->offset(manager::link_to_position(next));
+        if (!is_null(next_offset))
+            prefetch(next_offset);
 
         // element key matches (found)
-        if (is_zero(std::memcmp(key.data(), std::next(offset, Link::size),
-            array_count<Key>)))
+        if (match::is_match(key, offset))
             return link;
 
-        // set next element link (loop)
-        link = system::unsafe_array_cast<uint8_t, Link::size>(offset);
+        // next element is terminal (not found)
+        if (next.is_terminal())
+            return next;
+
+        // set next element (loop)
+        link = next;
+        offset = next_offset;
     }
 
-    return link;
+    return {};
 }
 
 } // namespace database
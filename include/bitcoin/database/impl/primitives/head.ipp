@@ -20,6 +20,8 @@
 #define LIBBITCOIN_DATABASE_PRIMITIVES_HEAD_IPP
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 
@@ -30,39 +32,54 @@ namespace libbitcoin {
 namespace database {
 
 TEMPLATE
-CLASS::head(storage& head, const Link& buckets) NOEXCEPT
-  : file_(head), buckets_(buckets)
+CLASS::head(storage& head, const Link& buckets, bool aligned) NOEXCEPT
+  : file_(head),
+    initial_(buckets),
+    aligned_(aligned),
+    slot_(aligned ? sizeof(slot) : Link::size),
+    offset_(slot_),
+    buckets_(buckets),
+    mask_(to_mask(buckets))
 {
 }
 
 TEMPLATE
 size_t CLASS::size() const NOEXCEPT
 {
-    return offset(buckets_);
+    // End of current region, followed by trailer if grown.
+    const auto end = offset_.load(std::memory_order_relaxed) +
+        buckets_.load(std::memory_order_relaxed) * slot_;
+
+    return is_grown() ? end + trailer : end;
 }
 
 TEMPLATE
 size_t CLASS::buckets() const NOEXCEPT
 {
-    return buckets_;
+    return buckets_.load(std::memory_order_relaxed) +
+        prior_buckets_.load(std::memory_order_relaxed);
 }
 
 TEMPLATE
 Link CLASS::index(const Key& key) const NOEXCEPT
 {
-    BC_ASSERT_MSG(is_nonzero(buckets_), "hash table requires buckets");
+    BC_ASSERT_MSG(is_nonzero(buckets_.load()), "hash table requires buckets");
 
-    // TODO: for greater flexibility, inject hash function through template.
-    if constexpr (Hash)
-    {
-        // djb2_hash exhibits very poor uniqueness result for sequential keys.
-        return system::djb2_hash(key) % buckets_;
-    }
-    else
+    const auto value = Hash::hash(key);
+    const auto buckets = buckets_.load(std::memory_order_relaxed);
+    const auto prior = prior_buckets_.load(std::memory_order_relaxed);
+
+    if (is_nonzero(prior))
     {
-        // unique_hash assumes sufficient uniqueness in low order key bytes.
-        return system::unique_hash(key) % buckets_;
+        // Prior buckets at or above cursor have not been migrated.
+        const auto bucket = reduce(value, prior,
+            prior_mask_.load(std::memory_order_relaxed));
+
+        if (bucket >= cursor_.load(std::memory_order_relaxed))
+            return buckets + bucket;
     }
+
+    return reduce(value, buckets, mask_.load(std::memory_order_relaxed));
 }
 
 TEMPLATE
@@ -90,10 +107,59 @@ bool CLASS::create() NOEXCEPT
     return set_body_count(zero);
 }
 
+TEMPLATE
+bool CLASS::open() NOEXCEPT
+{
+    const auto size = file_.size();
+
+    // Ungrown head file has no trailer (initial layout).
+    if (size == (add1<size_t>(initial_) * slot_))
+    {
+        offset_.store(slot_);
+        buckets_.store(initial_);
+        mask_.store(to_mask(initial_));
+        prior_offset_.store(zero);
+        prior_buckets_.store(zero);
+        prior_mask_.store(zero);
+        cursor_.store(zero);
+        return true;
+    }
+
+    if (size < trailer)
+        return false;
+
+    const auto ptr = file_.get(size - trailer);
+    if (!ptr || system::is_lesser(ptr->size(), trailer))
+        return false;
+
+    std_array<uint64_t, trailer_fields> fields{};
+    for (size_t field = 0; field < trailer_fields; ++field)
+        fields.at(field) = system::unsafe_from_little_endian<uint64_t>(
+            std::next(ptr->begin(), field * sizeof(uint64_t)));
+
+    using namespace system;
+    const auto buckets = possible_narrow_cast<size_t>(fields.at(3));
+    const auto prior = possible_narrow_cast<size_t>(fields.at(1));
+    prior_offset_.store(possible_narrow_cast<size_t>(fields.at(0)));
+    prior_buckets_.store(prior);
+    prior_mask_.store(to_mask(prior));
+    offset_.store(possible_narrow_cast<size_t>(fields.at(2)));
+    buckets_.store(buckets);
+    mask_.store(to_mask(buckets));
+    cursor_.store(possible_narrow_cast<size_t>(fields.at(4)));
+    return is_grown() && verify();
+}
+
 TEMPLATE
 bool CLASS::verify() const NOEXCEPT
 {
-    return file_.size() == size();
+    if (!is_grown())
+        return file_.size() == size();
+
+    // Prior region (if any) precedes current, cursor is within prior.
+    const auto prior = prior_buckets_.load();
+    return file_.size() == size() && cursor_.load() <= prior &&
+        (prior_offset_.load() + prior * slot_) <= offset_.load();
 }
 
 TEMPLATE
@@ -121,16 +187,29 @@ bool CLASS::set_body_count(const Link& count) NOEXCEPT
 TEMPLATE
 Link CLASS::top(const Key& key) const NOEXCEPT
 {
+    if constexpr (filtered)
+    {
+        if (aligned_)
+            return top(index(key), to_filter(key));
+    }
+
     return top(index(key));
 }
 
 TEMPLATE
 Link CLASS::top(const Link& index) const NOEXCEPT
 {
-    const auto raw = file_.get_raw(offset(index));
+    const auto raw = file_.get_raw(position(index));
     if (is_null(raw))
         return {};
 
+    if (aligned_)
+    {
+        const std::atomic_ref<slot> head{ *system::pointer_cast<slot>(raw) };
+
+        return to_link(head.load(std::memory_order_acquire));
+    }
+
     const auto& head = array_cast<Link::size>(raw);
 
     mutex_.lock_shared();
@@ -142,16 +221,195 @@ Link CLASS::top(const Link& index) const NOEXCEPT
 TEMPLATE
 bool CLASS::push(const bytes& current, bytes& next, const Key& key) NOEXCEPT
 {
-    return push(current, next, index(key));
+    return push(current, next, key, index(key));
+}
+
+TEMPLATE
+bool CLASS::push(const bytes& current, bytes& next, const Key& key,
+    const Link& index) NOEXCEPT
+{
+    if constexpr (filtered)
+    {
+        return push(current, next, index, to_filter(key));
+    }
+    else
+    {
+        return push(current, next, index, slot{});
+    }
 }
 
 TEMPLATE
 bool CLASS::push(const bytes& current, bytes& next, const Link& index) NOEXCEPT
 {
-    const auto raw = file_.get_raw(offset(index));
+    // Without key the filter must admit any key (saturated).
+    if constexpr (filtered)
+    {
+        return push(current, next, index, filter_mask());
+    }
+    else
+    {
+        return push(current, next, index, slot{});
+    }
+}
+
+TEMPLATE
+void CLASS::prefetch(const Key& key) const NOEXCEPT
+{
+    const auto raw = file_.get_raw(position(index(key)));
+    if (!is_null(raw))
+        database::prefetch(raw);
+}
+
+// growth
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::is_migrating() const NOEXCEPT
+{
+    return is_nonzero(prior_buckets_.load(std::memory_order_relaxed));
+}
+
+TEMPLATE
+bool CLASS::grow() NOEXCEPT
+{
+    using namespace system;
+    const auto prior = buckets_.load();
+    if (is_migrating() || is_zero(prior) || is_multiply_overflow(prior, two))
+        return false;
+
+    // All bucket indexes (current and prior) must be valid links.
+    const auto buckets = prior * two;
+    if (is_add_overflow(buckets, prior) || (buckets + prior) >= Link::terminal)
+        return false;
+
+    if constexpr (Hash::fastrange)
+    {
+        if (buckets > add1<uint64_t>(max_uint32))
+            return false;
+    }
+
+    // New region replaces trailer if grown, and is followed by trailer.
+    const auto grown = is_grown();
+    const auto start = grown ? size() - trailer : size();
+    const auto bytes = buckets * slot_;
+    const auto allocation = grown ? bytes : bytes + trailer;
+    if (file_.allocate(allocation) == storage::eof)
+        return false;
+
+    const auto raw = file_.get_raw(start);
+    if (is_null(raw))
+        return false;
+
+    std::fill_n(raw, bytes + trailer, bit_all<uint8_t>);
+    prior_offset_.store(offset_.load());
+    prior_mask_.store(mask_.load());
+    prior_buckets_.store(prior);
+    cursor_.store(zero);
+    offset_.store(start);
+    mask_.store(to_mask(buckets));
+    buckets_.store(buckets);
+    return set_trailer();
+}
+
+TEMPLATE
+Link CLASS::cursor() const NOEXCEPT
+{
+    if (!is_migrating())
+        return {};
+
+    return buckets_.load() + cursor_.load();
+}
+
+TEMPLATE
+Link CLASS::rehash(const Key& key) const NOEXCEPT
+{
+    return reduce(Hash::hash(key), buckets_.load(), mask_.load());
+}
+
+TEMPLATE
+bool CLASS::advance() NOEXCEPT
+{
+    const auto prior = prior_buckets_.load();
+    const auto cursor = cursor_.load();
+    if (cursor >= prior)
+        return false;
+
+    // Migrated bucket is terminal, so that list scans do not repeat it.
+    const auto raw = file_.get_raw(prior_offset_.load() + cursor * slot_);
     if (is_null(raw))
         return false;
 
+    std::fill_n(raw, slot_, system::bit_all<uint8_t>);
+
+    if (add1(cursor) == prior)
+    {
+        // Migration complete, prior region is abandoned.
+        prior_offset_.store(zero);
+        prior_mask_.store(zero);
+        prior_buckets_.store(zero);
+        cursor_.store(zero);
+    }
+    else
+    {
+        cursor_.store(add1(cursor));
+    }
+
+    return set_trailer();
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+Link CLASS::top(const Link& index, slot filter) const NOEXCEPT
+{
+    const auto raw = file_.get_raw(position(index));
+    if (is_null(raw))
+        return {};
+
+    const std::atomic_ref<slot> head{ *system::pointer_cast<slot>(raw) };
+    const auto value = head.load(std::memory_order_acquire);
+
+    // Key is not in the list if any of its filter bits is unset.
+    return ((value & filter) == filter) ? to_link(value) : Link{};
+}
+
+TEMPLATE
+bool CLASS::push(const bytes& current, bytes& next, const Link& index,
+    slot filter) NOEXCEPT
+{
+    const auto raw = file_.get_raw(position(index));
+    if (is_null(raw))
+        return false;
+
+    if (aligned_)
+    {
+        std::atomic_ref<slot> head{ *system::pointer_cast<slot>(raw) };
+
+        // Element (with next) is published to readers by the release.
+        const auto link = to_slot(current);
+        auto top = head.load(std::memory_order_relaxed);
+        auto value = link;
+        do
+        {
+            const auto prior = to_link(top);
+            next = prior;
+
+            if constexpr (filtered)
+            {
+                // Filter accumulates list keys, empty list has no filter.
+                const auto accumulated = prior.is_terminal() ? slot{} :
+                    (top & filter_mask());
+
+                value = (link & ~filter_mask()) | accumulated | filter;
+            }
+        }
+        while (!head.compare_exchange_weak(top, value,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        return true;
+    }
+
     auto& head = array_cast<Link::size>(raw);
 
     mutex_.lock();
@@ -161,6 +419,103 @@ bool CLASS::push(const bytes& current, bytes& next, const Link& index) NOEXCEPT
     return true;
 }
 
+TEMPLATE
+constexpr typename CLASS::slot CLASS::filter_mask() NOEXCEPT
+{
+    slot_bytes buffer{};
+    std::fill(std::next(buffer.begin(), Link::size), buffer.end(),
+        system::bit_all<uint8_t>);
+    return std::bit_cast<slot>(buffer);
+}
+
+TEMPLATE
+constexpr typename CLASS::slot CLASS::to_filter(const Key& key) NOEXCEPT
+{
+    using namespace system;
+    constexpr auto width = to_bits(sizeof(uint32_t));
+
+    // Fingerprint is independent of bucket index (and of rehash), and each
+    // half selects one filter bit (multiply-shift) within the slot padding.
+    const auto value = mix_hasher::mix(Hash::hash(key));
+    const auto high = possible_narrow_cast<uint32_t>(value >> width);
+    const auto low = possible_narrow_cast<uint32_t>(value);
+
+    slot_bytes buffer{};
+    for (const uint64_t half: { high, low })
+    {
+        const auto bit = possible_narrow_cast<size_t>((half * filter_bits) >>
+            width);
+
+        buffer.at(Link::size + bit / byte_bits) |=
+            narrow_cast<uint8_t>(1u << (bit % byte_bits));
+    }
+
+    return std::bit_cast<slot>(buffer);
+}
+
+TEMPLATE
+inline Link CLASS::to_link(slot value) NOEXCEPT
+{
+    const auto buffer = std::bit_cast<slot_bytes>(value);
+    bytes link{};
+    std::copy_n(buffer.begin(), Link::size, link.begin());
+    return link;
+}
+
+TEMPLATE
+inline typename CLASS::slot CLASS::to_slot(const bytes& link) NOEXCEPT
+{
+    slot_bytes buffer{};
+    buffer.fill(system::bit_all<uint8_t>);
+    std::copy(link.begin(), link.end(), buffer.begin());
+    return std::bit_cast<slot>(buffer);
+}
+
+TEMPLATE
+inline size_t CLASS::position(const Link& index) const NOEXCEPT
+{
+    using namespace system;
+    const auto buckets = buckets_.load(std::memory_order_relaxed);
+
+    // [body_size][[bucket[0]...bucket[buckets-1]]] (for each region)
+    if (index < buckets)
+        return offset_.load(std::memory_order_relaxed) +
+            possible_narrow_cast<size_t>(index) * slot_;
+
+    // Unmigrated prior bucket indexes follow current bucket indexes.
+    return prior_offset_.load(std::memory_order_relaxed) +
+        (possible_narrow_cast<size_t>(index) - buckets) * slot_;
+}
+
+TEMPLATE
+inline bool CLASS::is_grown() const NOEXCEPT
+{
+    return offset_.load(std::memory_order_relaxed) != slot_;
+}
+
+TEMPLATE
+bool CLASS::set_trailer() NOEXCEPT
+{
+    const auto raw = file_.get_raw(size() - trailer);
+    if (is_null(raw))
+        return false;
+
+    const std_array<uint64_t, trailer_fields> fields
+    {
+        prior_offset_.load(),
+        prior_buckets_.load(),
+        offset_.load(),
+        buckets_.load(),
+        cursor_.load()
+    };
+
+    for (size_t field = 0; field < trailer_fields; ++field)
+        system::unsafe_to_little_endian<uint64_t>(
+            std::next(raw, field * sizeof(uint64_t)), fields.at(field));
+
+    return true;
+}
+
 } // namespace database
 } // namespace libbitcoin
 
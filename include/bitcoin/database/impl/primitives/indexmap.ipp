@@ -0,0 +1,580 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_INDEXMAP_IPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_INDEXMAP_IPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+// Slots are read and pushed through get_raw(), with body memory held by the
+// caller (shared remap lock), as growth of the head requires exclusive body.
+
+namespace libbitcoin {
+namespace database {
+
+TEMPLATE
+CLASS::indexmap(storage& header, storage& body, const Link& slots,
+    bool aligned) NOEXCEPT
+  : head_(header),
+    manager_(body),
+    initial_(system::possible_narrow_cast<size_t>(slots.value)),
+    aligned_(aligned),
+    slot_(aligned ? sizeof(slot) : Link::size),
+    slots_(initial_)
+{
+}
+
+// not thread safe
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::create() NOEXCEPT
+{
+    if (is_nonzero(head_.size()))
+        return false;
+
+    const auto allocation = position(initial_);
+    if (head_.allocate(allocation) == storage::eof)
+        return false;
+
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    std::fill_n(raw, allocation, system::bit_all<uint8_t>);
+    slots_.store(initial_);
+    return set_marker() && set_body_count(zero) && manager_.truncate(zero);
+}
+
+TEMPLATE
+bool CLASS::close() NOEXCEPT
+{
+    return set_body_count(manager_.count());
+}
+
+TEMPLATE
+bool CLASS::backup() NOEXCEPT
+{
+    return set_body_count(manager_.count());
+}
+
+TEMPLATE
+bool CLASS::restore() NOEXCEPT
+{
+    Link count{};
+    return open() && get_body_count(count) && manager_.truncate(count);
+}
+
+TEMPLATE
+bool CLASS::verify() NOEXCEPT
+{
+    Link count{};
+    return open() && get_body_count(count) && (count == manager_.count());
+}
+
+// sizing
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::enabled() const NOEXCEPT
+{
+    return initial_ > one;
+}
+
+TEMPLATE
+size_t CLASS::buckets() const NOEXCEPT
+{
+    return slots_.load(std::memory_order_relaxed);
+}
+
+TEMPLATE
+size_t CLASS::head_size() const NOEXCEPT
+{
+    return head_.size();
+}
+
+TEMPLATE
+size_t CLASS::body_size() const NOEXCEPT
+{
+    return manager_.size();
+}
+
+TEMPLATE
+Link CLASS::count() const NOEXCEPT
+{
+    return manager_.count();
+}
+
+// growth
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::reserve(size_t count) NOEXCEPT
+{
+    using namespace system;
+    if (count <= buckets())
+        return true;
+
+    // Exclusive access to body precludes all head access.
+    const auto ptr = manager_.get_exclusive();
+    if (!ptr)
+        return false;
+
+    // Another caller may have grown the head to include count.
+    const auto prior = slots_.load();
+    if (count <= prior)
+        return true;
+
+    // Doubling amortizes growth where keys are reserved in order.
+    if (is_multiply_overflow(prior, two))
+        return false;
+
+    const auto slots = std::max(count, prior * two);
+    if (is_multiply_overflow(slots + two, slot_))
+        return false;
+
+    const auto allocation = (slots - prior) * slot_;
+    if (head_.allocate(allocation) == storage::eof)
+        return false;
+
+    const auto raw = head_.get_raw(position(prior));
+    if (is_null(raw))
+        return false;
+
+    std::fill_n(raw, allocation, bit_all<uint8_t>);
+    slots_.store(slots);
+    return true;
+}
+
+// errors
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+code CLASS::get_fault() const NOEXCEPT
+{
+    return manager_.get_fault();
+}
+
+TEMPLATE
+size_t CLASS::get_space() const NOEXCEPT
+{
+    return manager_.get_space();
+}
+
+TEMPLATE
+code CLASS::reload() NOEXCEPT
+{
+    return manager_.reload();
+}
+
+// query interface
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+Link CLASS::top(const Link& index) const NOEXCEPT
+{
+    // Shared access to body precludes concurrent growth of head.
+    const auto ptr = get_memory();
+    if (!ptr || index >= buckets())
+        return {};
+
+    return slot_link(system::possible_narrow_cast<size_t>(index.value));
+}
+
+TEMPLATE
+bool CLASS::exists(const Key& key) const NOEXCEPT
+{
+    return !first(key).is_terminal();
+}
+
+TEMPLATE
+Link CLASS::first(const Key& key) const NOEXCEPT
+{
+    // Memory is obtained first, precluding concurrent growth of head.
+    return first(get_memory(), key);
+}
+
+TEMPLATE
+Link CLASS::allocate(const Link& size) NOEXCEPT
+{
+    return manager_.allocate(size);
+}
+
+TEMPLATE
+memory_ptr CLASS::get_memory() const NOEXCEPT
+{
+    return manager_.get();
+}
+
+TEMPLATE
+Key CLASS::get_key(const Link& link) NOEXCEPT
+{
+    const auto ptr = manager_.get(link);
+    if (!ptr || system::is_lesser(ptr->size(), index_size))
+        return {};
+
+    return array_cast<array_count<Key>>(std::next(ptr->begin(), Link::size));
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::find(const Key& key, Element& element) const NOEXCEPT
+{
+    // This override avoids duplicated memory_ptr construct in get(first()).
+    const auto ptr = get_memory();
+    return read(ptr, first(ptr, key), element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const Link& link, Element& element) const NOEXCEPT
+{
+    // This override is the normal form.
+    return read(get_memory(), link, element);
+}
+
+// static
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const memory_ptr& ptr, const Link& link,
+    Element& element) NOEXCEPT
+{
+    return read(ptr, link, element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::set(const Link& link, const Element& element) NOEXCEPT
+{
+    const auto ptr = manager_.get_write(link);
+    if (!ptr)
+        return false;
+
+    iostream stream{ *ptr };
+    finalizer sink{ stream };
+    sink.skip_bytes(index_size);
+
+    if constexpr (!is_slab) { BC_DEBUG_ONLY(sink.set_limit(Size);) }
+    return element.to_data(sink);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+Link CLASS::set_link(const Element& element) NOEXCEPT
+{
+    const auto link = allocate(element.count());
+    if (!set(link, element))
+        return {};
+
+    return link;
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+Link CLASS::put_link(const Key& key, const Element& element) NOEXCEPT
+{
+    Link link{};
+    if (!put_link(link, key, element))
+        return {};
+
+    return link;
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put_link(Link& link, const Key& key,
+    const Element& element) NOEXCEPT
+{
+    link = allocate(element.count());
+    return put(link, key, element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put(const Key& key, const Element& element) NOEXCEPT
+{
+    return !put_link(key, element).is_terminal();
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put(const Link& link, const Key& key,
+    const Element& element) NOEXCEPT
+{
+    // Body memory is held, precluding concurrent growth of head.
+    const auto ptr = manager_.get_write(link);
+    const auto index = to_index(key);
+    if (!ptr || index >= buckets())
+        return false;
+
+    // iostream.flush is a nop (direct copy).
+    iostream stream{ *ptr };
+    finalizer sink{ stream };
+    sink.skip_bytes(Link::size);
+    sink.write_bytes(key);
+
+    if constexpr (!is_slab)
+    {
+        BC_DEBUG_ONLY(sink.set_limit(Size * element.count());)
+    }
+
+    auto& next = array_cast<Link::size>(ptr->begin());
+    if (!element.to_data(sink))
+        return false;
+
+    // Element (with next) is published to readers by the push.
+    return push(link, next, index);
+}
+
+TEMPLATE
+bool CLASS::commit(const Link& link, const Key& key) NOEXCEPT
+{
+    // Body memory is held, precluding concurrent growth of head.
+    const auto ptr = manager_.get_write(link);
+    const auto index = to_index(key);
+    if (!ptr || index >= buckets())
+        return false;
+
+    // Set element search key and publish to readers.
+    array_cast<array_count<Key>>(std::next(ptr->begin(), Link::size)) = key;
+    auto& next = array_cast<Link::size>(ptr->begin());
+    return push(link, next, index);
+}
+
+TEMPLATE
+Link CLASS::commit_link(const Link& link, const Key& key) NOEXCEPT
+{
+    if (!commit(link, key))
+        return {};
+
+    return link;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+Link CLASS::slot_link(size_t index) const NOEXCEPT
+{
+    const auto raw = head_.get_raw(position(index));
+    if (is_null(raw))
+        return {};
+
+    if (aligned_)
+    {
+        const std::atomic_ref<slot> head{ *system::pointer_cast<slot>(raw) };
+        return to_link(head.load(std::memory_order_acquire));
+    }
+
+    const auto& head = array_cast<Link::size>(raw);
+
+    mutex_.lock_shared();
+    const auto top = head;
+    mutex_.unlock_shared();
+    return top;
+}
+
+TEMPLATE
+bool CLASS::push(const bytes& current, bytes& next, size_t index) NOEXCEPT
+{
+    const auto raw = head_.get_raw(position(index));
+    if (is_null(raw))
+        return false;
+
+    if (aligned_)
+    {
+        std::atomic_ref<slot> head{ *system::pointer_cast<slot>(raw) };
+
+        // Element (with next) is published to readers by the release.
+        const auto value = to_slot(current);
+        auto top = head.load(std::memory_order_relaxed);
+        do
+        {
+            next = to_link(top);
+        }
+        while (!head.compare_exchange_weak(top, value,
+            std::memory_order_release, std::memory_order_relaxed));
+
+        return true;
+    }
+
+    auto& head = array_cast<Link::size>(raw);
+
+    mutex_.lock();
+    next = head;
+    head = current;
+    mutex_.unlock();
+    return true;
+}
+
+TEMPLATE
+Link CLASS::first(const memory_ptr& ptr, const Key& key) const NOEXCEPT
+{
+    if (!ptr)
+        return {};
+
+    // The slot of a key references only elements of the key (no compare).
+    const auto index = to_index(key);
+    if (index >= buckets())
+        return {};
+
+    return slot_link(index);
+}
+
+TEMPLATE
+bool CLASS::open() NOEXCEPT
+{
+    const auto size = head_.size();
+    if (!is_zero(size % slot_) || size < position(zero))
+        return false;
+
+    slots_.store((size - position(zero)) / slot_);
+    return is_marked();
+}
+
+TEMPLATE
+bool CLASS::is_marked() const NOEXCEPT
+{
+    const auto raw = head_.get_raw(slot_);
+    if (is_null(raw))
+        return false;
+
+    const Link value{ array_cast<Link::size>(raw) };
+    return value.value == marker;
+}
+
+TEMPLATE
+bool CLASS::set_marker() NOEXCEPT
+{
+    const auto raw = head_.get_raw(slot_);
+    if (is_null(raw))
+        return false;
+
+    array_cast<Link::size>(raw) = Link{ marker };
+    return true;
+}
+
+TEMPLATE
+bool CLASS::get_body_count(Link& count) const NOEXCEPT
+{
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    count = array_cast<Link::size>(raw);
+    return true;
+}
+
+TEMPLATE
+bool CLASS::set_body_count(const Link& count) NOEXCEPT
+{
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    array_cast<Link::size>(raw) = count;
+    return true;
+}
+
+TEMPLATE
+inline Link CLASS::to_link(slot value) NOEXCEPT
+{
+    const auto buffer = std::bit_cast<slot_bytes>(value);
+    bytes link{};
+    std::copy_n(buffer.begin(), Link::size, link.begin());
+    return link;
+}
+
+TEMPLATE
+inline typename CLASS::slot CLASS::to_slot(const bytes& link) NOEXCEPT
+{
+    slot_bytes buffer{};
+    buffer.fill(system::bit_all<uint8_t>);
+    std::copy(link.begin(), link.end(), buffer.begin());
+    return std::bit_cast<slot>(buffer);
+}
+
+TEMPLATE
+inline size_t CLASS::to_index(const Key& key) NOEXCEPT
+{
+    const key_link index{ key };
+    return index.is_terminal() ? max_size_t :
+        system::possible_narrow_cast<size_t>(index.value);
+}
+
+TEMPLATE
+inline size_t CLASS::position(size_t index) const NOEXCEPT
+{
+    // [body_count][marker][slot[0]...slot[slots-1]]
+    return (index + two) * slot_;
+}
+
+// protected/static
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::read(const memory_ptr& ptr, const Link& link,
+    Element& element) NOEXCEPT
+{
+    if (!ptr || link.is_terminal())
+        return false;
+
+    using namespace system;
+    const auto start = manager::link_to_position(link);
+    if (is_limited<ptrdiff_t>(start))
+        return false;
+
+    const auto size = ptr->size();
+    const auto position = possible_narrow_and_sign_cast<ptrdiff_t>(start);
+    if (position > size)
+        return false;
+
+    const auto offset = ptr->offset(position);
+    if (is_null(offset))
+        return false;
+
+    if constexpr (is_view<Element>)
+    {
+        // View reads fields from key at static offsets (no stream).
+        static_assert(!is_slab, "view requires fixed record size");
+        if (is_lesser(size - position, index_size + Size))
+            return false;
+
+        return element.from_memory(std::next(offset, Link::size));
+    }
+    else
+    {
+        // Stream starts at record, index is skipped for reader convenience.
+        iostream stream{ offset, size - position };
+        reader source{ stream };
+        source.skip_bytes(index_size);
+
+        if constexpr (!is_slab) { BC_DEBUG_ONLY(source.set_limit(Size);) }
+        return element.from_data(source);
+    }
+}
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
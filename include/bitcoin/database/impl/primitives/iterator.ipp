@@ -29,11 +29,18 @@ namespace database {
 
 TEMPLATE
 CLASS::iterator(const memory_ptr& data, const Link& start,
-    const Key& key) NOEXCEPT
+    const Key& key) NOEXCEPT requires (!Borrowed)
   : memory_(data), key_(key), link_(to_match(start))
 {
 }
 
+TEMPLATE
+CLASS::iterator(const guard& memory, const Link& start,
+    const Key& key) NOEXCEPT requires (Borrowed)
+  : memory_(memory), key_(key), link_(to_match(start))
+{
+}
+
 TEMPLATE
 bool CLASS::advance() NOEXCEPT
 {
@@ -49,7 +56,10 @@ const Link& CLASS::self() const NOEXCEPT
 TEMPLATE
 const memory_ptr& CLASS::get() const NOEXCEPT
 {
-    return memory_;
+    if constexpr (Borrowed)
+        return memory_.get();
+    else
+        return memory_;
 }
 
 TEMPLATE
@@ -65,55 +75,50 @@ TEMPLATE
 Link CLASS::to_match(Link link) const NOEXCEPT
 {
     // Because of this !link_.is_terminal() subsequently guards both.
-    if (!memory_)
+    const auto& memory = get();
+    if (!memory || link.is_terminal())
         return {};
 
-    while (!link.is_terminal())
+    // get element offset (fault)
+    auto offset = memory->offset(manager::link_to_position(link));
+    while (!is_null(offset))
     {
-        // get element offset (fault)
-        const auto offset = memory_->offset(manager::link_to_position(link));
-        if (is_null(offset))
-            return {};
+        // get next element offset (fault), prefetch before key comparison
+        const auto next = match::next(offset);
+        const auto next_offset = next.is_terminal() ? nullptr :
+            memory->offset(manager::link_to_position(next));
+        if (!is_null(next_offset))
+            prefetch(next_offset);
 
         // element key matches (found)
-        const auto key_ptr = std::next(offset, Link::size);
-        if (is_zero(std::memcmp(key_.data(), key_ptr, array_count<Key>)))
+        if (match::is_match(key_, offset))
             return std::move(link);
 
-        // set next element link (loop)
-        link = system::unsafe_array_cast<uint8_t, Link::size>(offset);
+        // next element is terminal (not found)
+        if (next.is_terminal())
+            return next;
+
+        // set next element (loop)
+        link = next;
+        offset = next_offset;
     }
 
-    return std::move(link);
+    return {};
 }
 
 TEMPLATE
 Link CLASS::to_next(Link link) const NOEXCEPT
 {
-    while (!link.is_terminal())
-    {
-        // get element offset (fault)
-        auto offset = memory_->offset(manager::link_to_position(link));
-        if (is_null(offset))
-            return {};
-
-        // set next element link (loop)
-        link = { system::unsafe_array_cast<uint8_t, Link::size>(offset) };
-        if (link.is_terminal())
-            return std::move(link);
-
-        // get next element offset (fault)
-        offset = memory_->offset(manager::link_to_position(link));
-        if (is_null(offset))
-            return {};
+    if (link.is_terminal())
+        return std::move(link);
 
-        // next element key matches (found)
-        const auto key_ptr = std::next(offset, Link::size);
-        if (is_zero(std::memcmp(key_.data(), key_ptr, array_count<Key>)))
-            return std::move(link);
-    }
+    // get element offset (fault)
+    const auto offset = get()->offset(manager::link_to_position(link));
+    if (is_null(offset))
+        return {};
 
-    return std::move(link);
+    // next element key matches (found)
+    return to_match(match::next(offset));
 }
 
 } // namespace database
@@ -74,6 +74,28 @@ memory_ptr CLASS::get() const NOEXCEPT
     return file_.get();
 }
 
+TEMPLATE
+memory_ptr CLASS::get_write() const NOEXCEPT
+{
+    return file_.get_write();
+}
+
+TEMPLATE
+memory_ptr CLASS::get_write(const Link& value) const NOEXCEPT
+{
+    if (value.is_terminal())
+        return nullptr;
+
+    // memory.size() may be negative (stream treats as exhausted).
+    return file_.get_write(link_to_position(value));
+}
+
+TEMPLATE
+memory_ptr CLASS::get_exclusive() const NOEXCEPT
+{
+    return file_.get_exclusive();
+}
+
 TEMPLATE
 memory_ptr CLASS::get(const Link& value) const NOEXCEPT
 {
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_MATCHER_IPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_MATCHER_IPP
+
+#include <cstring>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+#endif
+
+namespace libbitcoin {
+namespace database {
+
+TEMPLATE
+inline Link CLASS::next(const uint8_t* element) NOEXCEPT
+{
+    using namespace system;
+    using integer = typename Link::integer;
+
+    if constexpr (wide && Link::size < sizeof(uint64_t))
+    {
+        // One unaligned load, key bytes following the link are masked off.
+        uint64_t word{};
+        std::memcpy(&word, element, sizeof(word));
+        return Link{ possible_narrow_cast<integer>(
+            native_from_little_end(word) & Link::terminal) };
+    }
+    else
+    {
+        return unsafe_array_cast<uint8_t, Link::size>(element);
+    }
+}
+
+TEMPLATE
+inline bool CLASS::is_match(const Key& key, const uint8_t* element) NOEXCEPT
+{
+    return is_equal(key.data(), std::next(element, Link::size));
+}
+
+TEMPLATE
+inline bool CLASS::is_equal(const uint8_t* left,
+    const uint8_t* right) NOEXCEPT
+{
+    using namespace system;
+    if constexpr (key_size == 32u)
+    {
+        // Hash keys that differ are rejected by their leading word, which
+        // avoids reading a following cache line of the element on a miss.
+        uint64_t lead_left{};
+        uint64_t lead_right{};
+        std::memcpy(&lead_left, left, sizeof(uint64_t));
+        std::memcpy(&lead_right, right, sizeof(uint64_t));
+        if (lead_left != lead_right)
+            return false;
+
+#if defined(__AVX2__)
+        const auto lhs = _mm256_loadu_si256(pointer_cast<const __m256i>(left));
+        const auto rhs = _mm256_loadu_si256(pointer_cast<const __m256i>(right));
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs)) == -1;
+#elif defined(__SSE2__) || defined(_M_X64)
+        constexpr auto half = key_size / two;
+        const auto high_left = std::next(left, half);
+        const auto high_right = std::next(right, half);
+        const auto low = _mm_cmpeq_epi8(
+            _mm_loadu_si128(pointer_cast<const __m128i>(left)),
+            _mm_loadu_si128(pointer_cast<const __m128i>(right)));
+        const auto high = _mm_cmpeq_epi8(
+            _mm_loadu_si128(pointer_cast<const __m128i>(high_left)),
+            _mm_loadu_si128(pointer_cast<const __m128i>(high_right)));
+        return _mm_movemask_epi8(_mm_and_si128(low, high)) == 0xffff;
+#else
+        std_array<uint64_t, 4> lhs{};
+        std_array<uint64_t, 4> rhs{};
+        std::memcpy(lhs.data(), left, key_size);
+        std::memcpy(rhs.data(), right, key_size);
+        return is_zero((lhs[0] ^ rhs[0]) | (lhs[1] ^ rhs[1]) |
+            (lhs[2] ^ rhs[2]) | (lhs[3] ^ rhs[3]));
+#endif
+    }
+    else if constexpr (key_size <= sizeof(uint64_t))
+    {
+        // Surrogate keys (e.g. 3, 4 and 7 bytes) compare as one integer.
+        uint64_t lhs{};
+        uint64_t rhs{};
+        std::memcpy(&lhs, left, key_size);
+        std::memcpy(&rhs, right, key_size);
+        return lhs == rhs;
+    }
+    else
+    {
+        return is_zero(std::memcmp(left, right, key_size));
+    }
+}
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -0,0 +1,613 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_PROBEMAP_IPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_PROBEMAP_IPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+// Slots are read and claimed through get_raw(), with body memory held by the
+// caller (shared remap lock), as growth of the head requires exclusive body.
+
+namespace libbitcoin {
+namespace database {
+
+TEMPLATE
+CLASS::probemap(storage& header, storage& body, const Link& slots) NOEXCEPT
+  : head_(header),
+    manager_(body),
+    initial_(std::max(two, std::bit_ceil(
+        system::possible_narrow_cast<size_t>(slots.value)))),
+    slots_(initial_)
+{
+}
+
+// not thread safe
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::create() NOEXCEPT
+{
+    if (is_nonzero(head_.size()))
+        return false;
+
+    const auto allocation = position(initial_);
+    if (head_.allocate(allocation) == storage::eof)
+        return false;
+
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    std::fill_n(raw, allocation, system::bit_all<uint8_t>);
+    slots_.store(initial_);
+    return set_body_count(zero) && manager_.truncate(zero);
+}
+
+TEMPLATE
+bool CLASS::close() NOEXCEPT
+{
+    return set_body_count(manager_.count());
+}
+
+TEMPLATE
+bool CLASS::backup() NOEXCEPT
+{
+    return set_body_count(manager_.count());
+}
+
+TEMPLATE
+bool CLASS::restore() NOEXCEPT
+{
+    Link count{};
+    return open() && get_body_count(count) && manager_.truncate(count);
+}
+
+TEMPLATE
+bool CLASS::verify() NOEXCEPT
+{
+    Link count{};
+    return open() && get_body_count(count) && (count == manager_.count());
+}
+
+// sizing
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+size_t CLASS::slots() const NOEXCEPT
+{
+    return slots_.load(std::memory_order_relaxed);
+}
+
+TEMPLATE
+size_t CLASS::head_size() const NOEXCEPT
+{
+    return head_.size();
+}
+
+TEMPLATE
+size_t CLASS::body_size() const NOEXCEPT
+{
+    return manager_.size();
+}
+
+TEMPLATE
+Link CLASS::count() const NOEXCEPT
+{
+    return manager_.count();
+}
+
+// errors
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+code CLASS::get_fault() const NOEXCEPT
+{
+    return manager_.get_fault();
+}
+
+TEMPLATE
+size_t CLASS::get_space() const NOEXCEPT
+{
+    return manager_.get_space();
+}
+
+TEMPLATE
+code CLASS::reload() NOEXCEPT
+{
+    return manager_.reload();
+}
+
+// growth
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::grow() NOEXCEPT
+{
+    using namespace system;
+
+    // Exclusive access to body precludes all head access.
+    const auto ptr = manager_.get_exclusive();
+    if (!ptr)
+        return false;
+
+    const auto prior = slots_.load();
+    if (is_multiply_overflow(prior, two) ||
+        is_multiply_overflow(add1(prior * two), sizeof(slot)))
+        return false;
+
+    const auto slots = prior * two;
+    if constexpr (Hash::fastrange)
+    {
+        if (slots > add1<uint64_t>(max_uint32))
+            return false;
+    }
+
+    // Collect occupied links before head allocation (which may remap).
+    std::vector<Link> links{};
+    auto raw = head_.get_raw(position(zero));
+    if (is_null(raw))
+        return false;
+
+    for (size_t index = 0; index < prior; ++index)
+    {
+        const auto link = to_link(*pointer_cast<slot>(std::next(raw,
+            index * sizeof(slot))));
+
+        if (!link.is_terminal())
+            links.push_back(link);
+    }
+
+    // Rehash into new slots, so that failure leaves the head unchanged.
+    // Element order approximates commit order, so that among duplicate keys
+    // the most recent remains last in probe order.
+    std::vector<slot> rehashed(slots, empty);
+    std::sort(links.begin(), links.end());
+    for (const auto& link: links)
+    {
+        const auto offset = ptr->offset(manager::link_to_position(link));
+        if (is_null(offset))
+            return false;
+
+        // Elements do not exceed prior slots, so an empty slot always exists.
+        const auto& key = array_cast<key_size>(offset);
+        auto index = reduce(Hash::hash(key), slots);
+        while (rehashed.at(index) != empty)
+            index = add1(index) & sub1(slots);
+
+        rehashed.at(index) = to_slot(link, to_tag(key));
+    }
+
+    const auto size = head_.size();
+    if (head_.allocate(prior * sizeof(slot)) == storage::eof)
+        return false;
+
+    raw = head_.get_raw(position(zero));
+    if (is_null(raw))
+    {
+        head_.truncate(size);
+        return false;
+    }
+
+    std::copy_n(pointer_cast<uint8_t>(rehashed.data()), slots * sizeof(slot),
+        raw);
+    slots_.store(slots);
+    return true;
+}
+
+TEMPLATE
+bool CLASS::maintain() NOEXCEPT
+{
+    // Load is restored in one maintenance, regardless of writes since prior.
+    while ((count() * two) > slots())
+        if (!grow())
+            return false;
+
+    return true;
+}
+
+// query interface
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::exists(const Key& key) const NOEXCEPT
+{
+    return !first(key).is_terminal();
+}
+
+TEMPLATE
+Link CLASS::first(const Key& key) const NOEXCEPT
+{
+    // Memory is obtained first, precluding concurrent growth of head.
+    return first(get_memory(), key);
+}
+
+TEMPLATE
+Link CLASS::allocate(const Link& size) NOEXCEPT
+{
+    return manager_.allocate(size);
+}
+
+TEMPLATE
+memory_ptr CLASS::get_memory() const NOEXCEPT
+{
+    return manager_.get();
+}
+
+TEMPLATE
+Key CLASS::get_key(const Link& link) NOEXCEPT
+{
+    const auto ptr = manager_.get(link);
+    if (!ptr || system::is_lesser(ptr->size(), key_size))
+        return {};
+
+    return array_cast<key_size>(ptr->begin());
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::find(const Key& key, Element& element) const NOEXCEPT
+{
+    // This override avoids duplicated memory_ptr construct in get(first()).
+    const auto ptr = get_memory();
+    return read(ptr, first(ptr, key), element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const Link& link, Element& element) const NOEXCEPT
+{
+    // This override is the normal form.
+    return read(get_memory(), link, element);
+}
+
+// static
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::get(const memory_ptr& ptr, const Link& link,
+    Element& element) NOEXCEPT
+{
+    return read(ptr, link, element);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::set(const Link& link, const Element& element) NOEXCEPT
+{
+    const auto ptr = manager_.get_write(link);
+    if (!ptr)
+        return false;
+
+    iostream stream{ *ptr };
+    finalizer sink{ stream };
+    sink.skip_bytes(key_size);
+
+    BC_DEBUG_ONLY(sink.set_limit(Size);)
+    return element.to_data(sink);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+Link CLASS::set_link(const Element& element) NOEXCEPT
+{
+    const auto link = allocate(element.count());
+    if (!set(link, element))
+        return {};
+
+    return link;
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+Link CLASS::put_link(const Key& key, const Element& element) NOEXCEPT
+{
+    const auto link = allocate(element.count());
+    if (!put(link, key, element))
+        return {};
+
+    return link;
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put(const Key& key, const Element& element) NOEXCEPT
+{
+    return !put_link(key, element).is_terminal();
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::put(const Link& link, const Key& key,
+    const Element& element) NOEXCEPT
+{
+    const auto ptr = manager_.get_write(link);
+    if (!ptr)
+        return false;
+
+    // iostream.flush is a nop (direct copy).
+    iostream stream{ *ptr };
+    finalizer sink{ stream };
+    sink.write_bytes(key);
+
+    BC_DEBUG_ONLY(sink.set_limit(Size * element.count());)
+    if (!element.to_data(sink))
+        return false;
+
+    // Element is published to readers by the slot claim.
+    return push(link, key);
+}
+
+TEMPLATE
+bool CLASS::commit(const Link& link, const Key& key) NOEXCEPT
+{
+    const auto ptr = manager_.get_write(link);
+    if (!ptr)
+        return false;
+
+    // Set element search key and publish to readers.
+    array_cast<key_size>(ptr->begin()) = key;
+    return push(link, key);
+}
+
+TEMPLATE
+Link CLASS::commit_link(const Link& link, const Key& key) NOEXCEPT
+{
+    if (!commit(link, key))
+        return {};
+
+    return link;
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::is_match(const memory_ptr& ptr, const Link& link,
+    const Key& key) NOEXCEPT
+{
+    const auto offset = ptr->offset(manager::link_to_position(link));
+    return !is_null(offset) &&
+        is_zero(std::memcmp(key.data(), offset, key_size));
+}
+
+TEMPLATE
+Link CLASS::first(const memory_ptr& ptr, const Key& key) const NOEXCEPT
+{
+    using namespace system;
+    if (!ptr)
+        return {};
+
+    const auto raw = head_.get_raw(position(zero));
+    if (is_null(raw))
+        return {};
+
+    const auto slots = slots_.load(std::memory_order_relaxed);
+    const auto tag = to_tag(key);
+    auto index = reduce(Hash::hash(key), slots);
+
+    // The cluster of the key ends at the first empty slot. The most recent
+    // duplicate is last in probe order, so the cluster is always exhausted.
+    Link found{};
+    for (size_t probe = 0; probe < slots; ++probe)
+    {
+        const std::atomic_ref<slot> head{ *pointer_cast<slot>(
+            std::next(raw, index * sizeof(slot))) };
+
+        const auto value = head.load(std::memory_order_acquire);
+        const auto link = to_link(value);
+        if (link.is_terminal())
+            break;
+
+        // Body is read only for slots of matching tag.
+        if (((value & tag_mask()) == tag) && is_match(ptr, link, key))
+            found = link;
+
+        index = add1(index) & sub1(slots);
+    }
+
+    return found;
+}
+
+TEMPLATE
+bool CLASS::push(const Link& link, const Key& key) NOEXCEPT
+{
+    using namespace system;
+    const auto raw = head_.get_raw(position(zero));
+    if (is_null(raw))
+        return false;
+
+    const auto slots = slots_.load(std::memory_order_relaxed);
+    const auto value = to_slot(link, to_tag(key));
+    auto index = reduce(Hash::hash(key), slots);
+
+    for (size_t probe = 0; probe < slots; ++probe)
+    {
+        std::atomic_ref<slot> head{ *pointer_cast<slot>(
+            std::next(raw, index * sizeof(slot))) };
+
+        // Element is published to readers by the release.
+        auto expected = empty;
+        if (head.load(std::memory_order_relaxed) == empty &&
+            head.compare_exchange_strong(expected, value,
+                std::memory_order_release, std::memory_order_relaxed))
+            return true;
+
+        index = add1(index) & sub1(slots);
+    }
+
+    // Full, maintenance precludes this unless writers outpace it.
+    return false;
+}
+
+TEMPLATE
+bool CLASS::open() NOEXCEPT
+{
+    const auto size = head_.size();
+    if (!is_zero(size % sizeof(slot)) || size < position(two))
+        return false;
+
+    const auto slots = sub1(size / sizeof(slot));
+    if (!std::has_single_bit(slots))
+        return false;
+
+    slots_.store(slots);
+    return true;
+}
+
+TEMPLATE
+bool CLASS::get_body_count(Link& count) const NOEXCEPT
+{
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    count = array_cast<Link::size>(raw);
+    return true;
+}
+
+TEMPLATE
+bool CLASS::set_body_count(const Link& count) NOEXCEPT
+{
+    const auto raw = head_.get_raw();
+    if (is_null(raw))
+        return false;
+
+    array_cast<Link::size>(raw) = count;
+    return true;
+}
+
+// static
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+constexpr size_t CLASS::reduce(size_t value, size_t slots) NOEXCEPT
+{
+    using namespace system;
+    if constexpr (Hash::fastrange)
+    {
+        constexpr auto width = to_bits(sizeof(uint32_t));
+        constexpr auto shift = to_bits(sizeof(size_t)) - width;
+        BC_ASSERT(slots <= add1<uint64_t>(max_uint32));
+
+        // Multiply-shift of the high order 32 hash bits into [0, slots).
+        const auto high = possible_narrow_cast<uint32_t>(value >> shift);
+        return possible_narrow_cast<size_t>((uint64_t{ high } * slots) >>
+            width);
+    }
+    else
+    {
+        // Slots is a power of two.
+        return value & sub1(slots);
+    }
+}
+
+TEMPLATE
+constexpr typename CLASS::slot CLASS::tag_mask() NOEXCEPT
+{
+    slot_bytes buffer{};
+    std::fill(std::next(buffer.begin(), Link::size), buffer.end(),
+        system::bit_all<uint8_t>);
+    return std::bit_cast<slot>(buffer);
+}
+
+TEMPLATE
+constexpr typename CLASS::slot CLASS::to_tag(const Key& key) NOEXCEPT
+{
+    // Tag is independent of slot index (and of growth).
+    return mix_hasher::mix(Hash::hash(key)) & tag_mask();
+}
+
+TEMPLATE
+inline Link CLASS::to_link(slot value) NOEXCEPT
+{
+    const auto buffer = std::bit_cast<slot_bytes>(value);
+    typename Link::bytes link{};
+    std::copy_n(buffer.begin(), Link::size, link.begin());
+    return link;
+}
+
+TEMPLATE
+inline typename CLASS::slot CLASS::to_slot(const typename Link::bytes& link,
+    slot tag) NOEXCEPT
+{
+    slot_bytes buffer{};
+    std::copy(link.begin(), link.end(), buffer.begin());
+    return std::bit_cast<slot>(buffer) | tag;
+}
+
+TEMPLATE
+inline size_t CLASS::position(size_t index) NOEXCEPT
+{
+    // [body_count][slot[0]...slot[slots-1]]
+    return add1(index) * sizeof(slot);
+}
+
+// protected/static
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::read(const memory_ptr& ptr, const Link& link,
+    Element& element) NOEXCEPT
+{
+    if (!ptr || link.is_terminal())
+        return false;
+
+    using namespace system;
+    const auto start = manager::link_to_position(link);
+    if (is_limited<ptrdiff_t>(start))
+        return false;
+
+    const auto size = ptr->size();
+    const auto position = possible_narrow_and_sign_cast<ptrdiff_t>(start);
+    if (position > size)
+        return false;
+
+    const auto offset = ptr->offset(position);
+    if (is_null(offset))
+        return false;
+
+    if constexpr (is_view<Element>)
+    {
+        // View reads fields from key at static offsets (no stream).
+        if (is_lesser(size - position, key_size + Size))
+            return false;
+
+        return element.from_memory(offset);
+    }
+    else
+    {
+        // Stream starts at element, key is skipped for reader convenience.
+        iostream stream{ offset, size - position };
+        reader source{ stream };
+        source.skip_bytes(key_size);
+
+        BC_DEBUG_ONLY(source.set_limit(Size);)
+        return element.from_data(source);
+    }
+}
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -170,17 +170,35 @@ bool CLASS::populate(const block& block) const NOEXCEPT
     if (txs.empty())
         return false;
 
-    auto result = true;
+    // Unpopulated inputs and the keys of their prevout txs.
+    std_vector<const input*> ins{};
+    hashes keys{};
     std::for_each(std::next(txs.begin()), txs.end(),
         [&](const auto& tx) NOEXCEPT
         {
-            const auto& ins = *tx->inputs_ptr();
-            std::for_each(ins.begin(), ins.end(), [&](const auto& in) NOEXCEPT
+            for (const auto& in: *tx->inputs_ptr())
             {
-                result &= populate(*in);
-            });
+                BC_ASSERT(!in->point().is_null());
+                if (in->prevout)
+                    continue;
+
+                ins.push_back(in.get());
+                keys.push_back(in->point().hash());
+            }
         });
 
+    // Prevout txs are searched together, overlapping their memory latency.
+    const auto links = store_.tx.first_many(keys);
+
+    auto result = true;
+    for (size_t index = 0; index < ins.size(); ++index)
+    {
+        // input.metadata is not populated.
+        const auto& in = *ins.at(index);
+        in.prevout = get_output(links.at(index), in.point().index());
+        result &= !is_null(in.prevout);
+    }
+
     return result;
 }
 
@@ -864,22 +882,28 @@ code CLASS::set_code(tx_link& out_fk, const transaction& tx) NOEXCEPT
     // Commit addresses to search if address index is enabled.
     if (address_enabled())
     {
+        std_vector<hash_digest> keys{};
+        std_vector<table::address::record> records{};
+        keys.reserve(outs.size());
+        records.reserve(outs.size());
+
         auto output_fk = puts.out_fks.begin();
         for (const auto& out: outs)
         {
-            // Safe allocation failure, unindexed tx outputs linked by address,
-            // others unlinked. A replay of committed addresses without indexed
-            // tx will appear as double spends, but the spend cannot be
-            // confirmed without the indexed tx. Addresses without indexed txs
-            // should be suppressed by c/s interface query.
-            if (!store_.address.put(out->script().hash(), table::address::record
-            {
-                {},
-                *output_fk++
-            }))
-            {
-                return error::tx_address_put;
-            }
+            keys.push_back(out->script().hash());
+            records.push_back({ {}, *output_fk++ });
+        }
+
+        // Safe allocation failure, unindexed tx outputs linked by address,
+        // others unlinked. A replay of committed addresses without indexed
+        // tx will appear as double spends, but the spend cannot be
+        // confirmed without the indexed tx. Addresses without indexed txs
+        // should be suppressed by c/s interface query. Addresses of the tx
+        // are allocated together and written in bucket order.
+        if (!store_.address.template put_many<table::address::record>(
+            keys, records))
+        {
+            return error::tx_address_put;
         }
     }
 
@@ -954,16 +978,49 @@ code CLASS::set_code(header_link& out_fk, const header& header,
     const auto scope = store_.get_transactor();
 
     // Clean single allocation failure (e.g. disk full).
-    out_fk = store_.header.put_link(key, table::header::record_put_ref
+    out_fk = store_.header.allocate(1);
+    if (out_fk.is_terminal())
+        return error::header_put;
+
+    // Header keyed tables are presized to include the header, so that their
+    // writes do not grow heads. Heads double, so this rarely grows (see also
+    // store::maintain, which presizes ahead of the header count).
+    const auto headers = add1<size_t>(out_fk.value);
+    if (!store_.txs.reserve(headers) ||
+        !store_.validated_bk.reserve(headers) ||
+        (neutrino_enabled() && !store_.neutrino.reserve(headers)))
+        return error::header_reserve;
+
+    // Chain state walk fields are copied to lineage, indexed by header link.
+    // Lineage is set before the header is committed, so that it is set for
+    // any header found by a reader (the commit publishes both).
+    if (lineage_ && !store_.lineage.set(out_fk, table::lineage::record
+    {
+        {},
+        parent_fk,
+        header.version(),
+        header.timestamp(),
+        header.bits(),
+        ctx.height,
+        true
+    }))
+    {
+        return error::header_lineage_set;
+    }
+
+    if (!store_.header.put(out_fk, key, table::header::record_put_ref
     {
         {},
         ctx,
         milestone,
         parent_fk,
         header
-    });
+    }))
+    {
+        return error::header_put;
+    }
 
-    return out_fk.is_terminal() ? error::header_put : error::success;
+    return error::success;
     // ========================================================================
 }
 
@@ -45,6 +45,10 @@ height_link CLASS::get_height(const hash_digest& key) const NOEXCEPT
 TEMPLATE
 height_link CLASS::get_height(const header_link& link) const NOEXCEPT
 {
+    table::lineage::record lineage{};
+    if (get_lineage(lineage, link))
+        return lineage.height;
+
     table::header::get_height header{};
     if (!store_.header.get(link, header))
         return {};
@@ -253,7 +257,16 @@ TEMPLATE
 error::error_t CLASS::spent_prevout(const foreign_point& point,
     const tx_link& self) const NOEXCEPT
 {
-    auto it = store_.spend.it(point);
+    return spent_prevout(store_.spend.get_guard(), point, self);
+}
+
+// protected
+// The guard must be of the spend table (borrowed by the iterator).
+TEMPLATE
+error::error_t CLASS::spent_prevout(const guard& spends,
+    const foreign_point& point, const tx_link& self) const NOEXCEPT
+{
+    auto it = store_.spend.it(spends, point);
     if (!it)
         return error::success;
 
@@ -317,11 +330,15 @@ code CLASS::unspent_duplicates(const tx_link& coinbase,
     if (is_one(coinbases.size()))
         return error::success;
 
+    // One spend guard is shared by the iteration of each output.
+    const auto spends = store_.spend.get_guard();
+
     // bip30: all (but self) must be confirmed spent or dup invalid (cb only).
     size_t unspent{};
     for (const auto& tx: coinbases)
         for (index out{}; out < output_count(tx); ++out)
-            if (!is_spent_prevout(tx, out) && is_one(unspent++))
+            if ((spent_prevout(spends, table::spend::compose(tx, out),
+                tx_link::terminal) == error::success) && is_one(unspent++))
                 return error::unspent_coinbase_collision;
 
     return is_zero(unspent) ? error::integrity : error::success;
@@ -366,6 +383,10 @@ code CLASS::tx_confirmable(const tx_link& link,
     // which requires point and tx table traversal just as before. :<
     const auto set = to_spend_set(link);
 
+    // One spend guard is shared by the iteration of each spend. Reads of the
+    // spend table within this loop must use the guard (see iterator).
+    const auto spends = store_.spend.get_guard();
+
     code ec{};
     for (const auto& spend: set.spends)
     {
@@ -376,7 +397,7 @@ code CLASS::tx_confirmable(const tx_link& link,
 
         // This query goes away.
         // If utxo exists then it is not spent (push own block first).
-        if (is_spent_prevout(spend.prevout(), link))
+        if (spent_prevout(spends, spend.prevout(), link) != error::success)
             return error::confirmed_double_spend;
     }
 
@@ -557,8 +578,14 @@ code CLASS::block_confirmable(const header_link& link) const NOEXCEPT
 TEMPLATE
 bool CLASS::is_strong_tx(const tx_link& link) const NOEXCEPT
 {
-    table::strong_tx::record strong{};
-    return store_.strong_tx.find(link, strong) && strong.positive;
+    // Current state is indexed by tx link (no search).
+    table::strong::record strong{};
+    if (store_.strong.get(link, strong) && strong.is_set())
+        return strong.is_strong();
+
+    // Unset implies unindexed, so fall back to the strong_tx top (search).
+    table::strong_tx::record top{};
+    return store_.strong_tx.find(link, top) && top.positive;
 }
 
 TEMPLATE
@@ -583,7 +610,16 @@ bool CLASS::set_strong(const header_link& link, const tx_links& txs,
         });
     };
 
-    return std::all_of(txs.begin(), txs.end(), set);
+    // The strong_tx multimap retains all block associations (bip30), and its
+    // top for each tx is also set to the strong array under one memory guard.
+    return std::all_of(txs.begin(), txs.end(), set) &&
+        store_.strong.set_many(txs, table::strong::record
+        {
+            {},
+            link,
+            positive,
+            true
+        });
 }
 
 TEMPLATE
@@ -78,6 +78,8 @@ size_t CLASS::store_body_size() const NOEXCEPT
         + candidate_body_size()
         + confirmed_body_size()
         + strong_tx_body_size()
+        + strong_body_size()
+        + lineage_body_size()
         + validated_tx_body_size()
         + validated_bk_body_size()
         + address_body_size()
@@ -104,6 +106,8 @@ size_t CLASS::store_head_size() const NOEXCEPT
         + candidate_head_size()
         + confirmed_head_size()
         + strong_tx_head_size()
+        + strong_head_size()
+        + lineage_head_size()
         + validated_tx_head_size()
         + validated_bk_head_size()
         + address_head_size()
@@ -138,6 +142,8 @@ DEFINE_SIZES(tx)
 DEFINE_SIZES(candidate)
 DEFINE_SIZES(confirmed)
 DEFINE_SIZES(strong_tx)
+DEFINE_SIZES(strong)
+DEFINE_SIZES(lineage)
 DEFINE_SIZES(validated_tx)
 DEFINE_SIZES(validated_bk)
 DEFINE_SIZES(address)
@@ -169,6 +175,8 @@ DEFINE_RECORDS(tx)
 DEFINE_RECORDS(candidate)
 DEFINE_RECORDS(confirmed)
 DEFINE_RECORDS(strong_tx)
+DEFINE_RECORDS(strong)
+DEFINE_RECORDS(lineage)
 DEFINE_RECORDS(address)
 
 // Counters (archive slabs).
@@ -70,7 +70,8 @@ namespace database {
 
 TEMPLATE
 CLASS::query(Store& store) NOEXCEPT
-  : store_(store), minimize_(store.minimize())
+  : store_(store), minimize_(store.minimize()),
+    lineage_(store.header_lineage())
 {
 }
 
@@ -151,8 +151,8 @@ spend_link CLASS::to_spend(const tx_link& link,
     if (!store_.tx.get(link, tx))
         return {};
 
-    table::puts::get_spend_at put{};
-    if (!store_.puts.get(tx.spend_fk, put))
+    table::puts::get_spend_at put{ {}, spend_index };
+    if (!store_.puts.get(tx.puts_fk, put))
         return {};
 
     return put.spend_fk;
@@ -190,6 +190,10 @@ output_link CLASS::to_prevout(const spend_link& link) const NOEXCEPT
 TEMPLATE
 header_link CLASS::to_parent(const header_link& link) const NOEXCEPT
 {
+    table::lineage::record lineage{};
+    if (get_lineage(lineage, link))
+        return lineage.parent_fk;
+
     table::header::get_parent_fk header{};
     if (!store_.header.get(link, header))
         return {};
@@ -201,12 +205,23 @@ header_link CLASS::to_parent(const header_link& link) const NOEXCEPT
 TEMPLATE
 header_link CLASS::to_block(const tx_link& key) const NOEXCEPT
 {
-    table::strong_tx::record strong{};
-    if (!store_.strong_tx.find(key, strong) || !strong.positive)
+    // Current state is indexed by tx link (no search).
+    table::strong::record strong{};
+    if (store_.strong.get(key, strong) && strong.is_set())
+    {
+        if (!strong.is_strong())
+            return {};
+
+        return strong.header_fk;
+    }
+
+    // Unset implies unindexed, so fall back to the strong_tx top (search).
+    table::strong_tx::record top{};
+    if (!store_.strong_tx.find(key, top) || !top.positive)
         return {};
 
     // Terminal implies not strong (not in block).
-    return strong.header_fk;
+    return top.header_fk;
 }
 
 // protected
@@ -248,10 +263,13 @@ inline tx_links CLASS::to_strong_txs(const hash_digest& tx_hash) const NOEXCEPT
     if (!it)
         return {};
 
+    // One strong_tx guard is shared by the iteration of each tx instance.
+    const auto strongs = store_.strong_tx.get_guard();
+
     tx_links links{};
     do
     {
-        for (const auto& tx: to_strong_txs(it.self()))
+        for (const auto& tx: to_strong_txs(strongs, it.self()))
             links.push_back(tx);
     }
     while (it.advance());
@@ -268,7 +286,16 @@ inline tx_links CLASS::to_strong_txs(const hash_digest& tx_hash) const NOEXCEPT
 TEMPLATE
 inline tx_links CLASS::to_strong_txs(const tx_link& link) const NOEXCEPT
 {
-    auto it = store_.strong_tx.it(link);
+    return to_strong_txs(store_.strong_tx.get_guard(), link);
+}
+
+// protected
+// The guard must be of the strong_tx table (borrowed by the iterator).
+TEMPLATE
+inline tx_links CLASS::to_strong_txs(const guard& strongs,
+    const tx_link& link) const NOEXCEPT
+{
+    auto it = store_.strong_tx.it(strongs, link);
     if (!it)
         return {};
 
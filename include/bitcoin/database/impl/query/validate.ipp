@@ -87,10 +87,27 @@ inline bool CLASS::is_sufficient(const context& current,
         && evaluated.mtp <= current.mtp;
 }
 
+// protected
+TEMPLATE
+inline bool CLASS::get_lineage(table::lineage::record& out,
+    const header_link& link) const NOEXCEPT
+{
+    // Records are not set when lineage is disabled or for headers stored
+    // while it was disabled, in which case header records are read.
+    return lineage_ && store_.lineage.get(link, out) && out.is_set();
+}
+
 TEMPLATE
 bool CLASS::get_timestamp(uint32_t& timestamp,
     const header_link& link) const NOEXCEPT
 {
+    table::lineage::record lineage{};
+    if (get_lineage(lineage, link))
+    {
+        timestamp = lineage.timestamp;
+        return true;
+    }
+
     table::header::get_timestamp header{};
     if (!store_.header.get(link, header))
         return false;
@@ -103,6 +120,13 @@ TEMPLATE
 bool CLASS::get_version(uint32_t& version,
     const header_link& link) const NOEXCEPT
 {
+    table::lineage::record lineage{};
+    if (get_lineage(lineage, link))
+    {
+        version = lineage.version;
+        return true;
+    }
+
     table::header::get_version header{};
     if (!store_.header.get(link, header))
         return false;
@@ -114,6 +138,13 @@ bool CLASS::get_version(uint32_t& version,
 TEMPLATE
 bool CLASS::get_bits(uint32_t& bits, const header_link& link) const NOEXCEPT
 {
+    table::lineage::record lineage{};
+    if (get_lineage(lineage, link))
+    {
+        bits = lineage.bits;
+        return true;
+    }
+
     table::header::get_bits header{};
     if (!store_.header.get(link, header))
         return false;
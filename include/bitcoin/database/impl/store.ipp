@@ -59,7 +59,9 @@ const std::unordered_map<event_t, std::string> CLASS::events
     { event_t::archive_snapshot, "archive_snapshot" },
 
     { event_t::restore_table, "restore_table" },
-    { event_t::recover_snapshot, "recover_snapshot" }
+    { event_t::recover_snapshot, "recover_snapshot" },
+
+    { event_t::maintain_table, "maintain_table" }
 };
 
 TEMPLATE
@@ -73,6 +75,7 @@ const std::unordered_map<table_t, std::string> CLASS::tables
     { table_t::point_table, "point_table" },
     { table_t::point_head, "point_head" },
     { table_t::point_body, "point_body" },
+    { table_t::point_filter, "point_filter" },
     { table_t::input_table, "input_table" },
     { table_t::input_head, "input_head" },
     { table_t::input_body, "input_body" },
@@ -86,6 +89,7 @@ const std::unordered_map<table_t, std::string> CLASS::tables
     { table_t::tx_head, "tx_head" },
     { table_t::txs_table, "txs_table" },
     { table_t::tx_body, "tx_body" },
+    { table_t::tx_filter, "tx_filter" },
     { table_t::txs_head, "txs_head" },
     { table_t::txs_body, "txs_body" },
 
@@ -102,8 +106,14 @@ const std::unordered_map<table_t, std::string> CLASS::tables
     { table_t::spend_head, "spend_head" },
     { table_t::spend_body, "spend_body" },
     { table_t::strong_tx_table, "strong_tx_table" },
+    { table_t::strong_table, "strong_table" },
+    { table_t::lineage_table, "lineage_table" },
     { table_t::strong_tx_head, "strong_tx_head" },
+    { table_t::strong_head, "strong_head" },
+    { table_t::lineage_head, "lineage_head" },
     { table_t::strong_tx_body, "strong_tx_body" },
+    { table_t::strong_body, "strong_body" },
+    { table_t::lineage_body, "lineage_body" },
 
     { table_t::validated_bk_table, "validated_bk_table" },
     { table_t::validated_bk_head, "validated_bk_head" },
@@ -129,70 +139,79 @@ CLASS::store(const settings& config) NOEXCEPT
     // Archive.
 
     header_head_(head(config.path / schema::dir::heads, schema::archive::header)),
-    header_body_(body(config.path, schema::archive::header), config.header_size, config.header_rate),
-    header(header_head_, header_body_, std::max(config.header_buckets, nonzero)),
+    header_body_(body(config.path, schema::archive::header), config.header_size, config.header_rate, config.header_reserve, config.header_advice, config.preallocate),
+    header(header_head_, header_body_, std::max(config.header_buckets, nonzero), config.aligned_heads, config.bucket_load),
 
     input_head_(head(config.path / schema::dir::heads, schema::archive::input)),
-    input_body_(body(config.path, schema::archive::input), config.input_size, config.input_rate),
+    input_body_(body(config.path, schema::archive::input), config.input_size, config.input_rate, config.input_reserve, config.input_advice, config.preallocate),
     input(input_head_, input_body_),
 
     output_head_(head(config.path / schema::dir::heads, schema::archive::output)),
-    output_body_(body(config.path, schema::archive::output), config.output_size, config.output_rate),
+    output_body_(body(config.path, schema::archive::output), config.output_size, config.output_rate, config.output_reserve, config.output_advice, config.preallocate),
     output(output_head_, output_body_),
 
     point_head_(head(config.path / schema::dir::heads, schema::archive::point)),
-    point_body_(body(config.path, schema::archive::point), config.point_size, config.point_rate),
-    point(point_head_, point_body_, std::max(config.point_buckets, nonzero)),
+    point_body_(body(config.path, schema::archive::point), config.point_size, config.point_rate, config.point_reserve, config.point_advice, config.preallocate),
+    point_filter_(filter(config.path / schema::dir::heads, schema::archive::point)),
+    point(point_head_, point_body_, point_filter_, config.point_filter, std::max(config.point_buckets, nonzero), config.aligned_heads, config.bucket_load),
 
     puts_head_(head(config.path / schema::dir::heads, schema::archive::puts)),
-    puts_body_(body(config.path, schema::archive::puts), config.puts_size, config.puts_rate),
+    puts_body_(body(config.path, schema::archive::puts), config.puts_size, config.puts_rate, config.puts_reserve, config.puts_advice, config.preallocate),
     puts(puts_head_, puts_body_),
 
     spend_head_(head(config.path / schema::dir::heads, schema::archive::spend)),
-    spend_body_(body(config.path, schema::archive::spend), config.spend_size, config.spend_rate),
-    spend(spend_head_, spend_body_, std::max(config.spend_buckets, nonzero)),
+    spend_body_(body(config.path, schema::archive::spend), config.spend_size, config.spend_rate, config.spend_reserve, config.spend_advice, config.preallocate),
+    spend(spend_head_, spend_body_, std::max(config.spend_buckets, nonzero), config.aligned_heads, config.bucket_load),
 
     tx_head_(head(config.path / schema::dir::heads, schema::archive::tx)),
-    tx_body_(body(config.path, schema::archive::tx), config.tx_size, config.tx_rate),
-    tx(tx_head_, tx_body_, std::max(config.tx_buckets, nonzero)),
+    tx_body_(body(config.path, schema::archive::tx), config.tx_size, config.tx_rate, config.tx_reserve, config.tx_advice, config.preallocate),
+    tx_filter_(filter(config.path / schema::dir::heads, schema::archive::tx)),
+    tx(tx_head_, tx_body_, tx_filter_, config.tx_filter, std::max(config.tx_buckets, nonzero), config.aligned_heads, config.bucket_load),
 
     txs_head_(head(config.path / schema::dir::heads, schema::archive::txs)),
-    txs_body_(body(config.path, schema::archive::txs), config.txs_size, config.txs_rate),
-    txs(txs_head_, txs_body_, std::max(config.txs_buckets, nonzero)),
+    txs_body_(body(config.path, schema::archive::txs), config.txs_size, config.txs_rate, config.txs_reserve, config.txs_advice, config.preallocate),
+    txs(txs_head_, txs_body_, std::max(config.txs_buckets, nonzero), config.aligned_heads),
 
     // Indexes.
 
     candidate_head_(head(config.path / schema::dir::heads, schema::indexes::candidate)),
-    candidate_body_(body(config.path, schema::indexes::candidate), config.candidate_size, config.candidate_rate),
+    candidate_body_(body(config.path, schema::indexes::candidate), config.candidate_size, config.candidate_rate, config.candidate_reserve, config.candidate_advice, config.preallocate),
     candidate(candidate_head_, candidate_body_),
 
     confirmed_head_(head(config.path / schema::dir::heads, schema::indexes::confirmed)),
-    confirmed_body_(body(config.path, schema::indexes::confirmed), config.confirmed_size, config.confirmed_rate),
+    confirmed_body_(body(config.path, schema::indexes::confirmed), config.confirmed_size, config.confirmed_rate, config.confirmed_reserve, config.confirmed_advice, config.preallocate),
     confirmed(confirmed_head_, confirmed_body_),
 
     strong_tx_head_(head(config.path / schema::dir::heads, schema::indexes::strong_tx)),
-    strong_tx_body_(body(config.path, schema::indexes::strong_tx), config.strong_tx_size, config.strong_tx_rate),
-    strong_tx(strong_tx_head_, strong_tx_body_, std::max(config.strong_tx_buckets, nonzero)),
+    strong_head_(head(config.path / schema::dir::heads, schema::indexes::strong)),
+    lineage_head_(head(config.path / schema::dir::heads, schema::indexes::lineage)),
+    strong_tx_body_(body(config.path, schema::indexes::strong_tx), config.strong_tx_size, config.strong_tx_rate, config.strong_tx_reserve, config.strong_tx_advice, config.preallocate),
+    strong_body_(body(config.path, schema::indexes::strong), config.strong_size, config.strong_rate, config.strong_reserve, config.strong_advice, config.preallocate),
+    lineage_body_(body(config.path, schema::indexes::lineage), config.lineage_size, config.lineage_rate, config.lineage_reserve, config.lineage_advice, config.preallocate),
+    strong_tx(strong_tx_head_, strong_tx_body_, std::max(config.strong_tx_buckets, nonzero), config.aligned_heads, config.bucket_load),
+    strong(strong_head_, strong_body_),
+    lineage(lineage_head_, lineage_body_),
 
     // Caches.
 
     validated_bk_head_(head(config.path / schema::dir::heads, schema::caches::validated_bk)),
-    validated_bk_body_(body(config.path, schema::caches::validated_bk), config.validated_bk_size, config.validated_bk_rate),
-    validated_bk(validated_bk_head_, validated_bk_body_, std::max(config.validated_bk_buckets, nonzero)),
+    validated_bk_body_(body(config.path, schema::caches::validated_bk), config.validated_bk_size, config.validated_bk_rate, config.validated_bk_reserve, config.validated_bk_advice, config.preallocate),
+    validated_bk(validated_bk_head_, validated_bk_body_, std::max(config.validated_bk_buckets, nonzero), config.aligned_heads),
 
+    // Slab table count is bytes, so slab bucket load is scaled by minimum row.
     validated_tx_head_(head(config.path / schema::dir::heads, schema::caches::validated_tx)),
-    validated_tx_body_(body(config.path, schema::caches::validated_tx), config.validated_tx_size, config.validated_tx_rate),
-    validated_tx(validated_tx_head_, validated_tx_body_, std::max(config.validated_tx_buckets, nonzero)),
+    validated_tx_body_(body(config.path, schema::caches::validated_tx), config.validated_tx_size, config.validated_tx_rate, config.validated_tx_reserve, config.validated_tx_advice, config.preallocate),
+    validated_tx(validated_tx_head_, validated_tx_body_, std::max(config.validated_tx_buckets, nonzero), config.aligned_heads, config.bucket_load * schema::validated_tx::minrow),
 
     // Optionals.
 
     address_head_(head(config.path / schema::dir::heads, schema::optionals::address)),
-    address_body_(body(config.path, schema::optionals::address), config.address_size, config.address_rate),
-    address(address_head_, address_body_, std::max(config.address_buckets, nonzero)),
+    address_body_(body(config.path, schema::optionals::address), config.address_size, config.address_rate, config.address_reserve, config.address_advice, config.preallocate),
+    address(address_head_, address_body_, std::max(config.address_buckets, nonzero), config.aligned_heads, config.bucket_load),
 
     neutrino_head_(head(config.path / schema::dir::heads, schema::optionals::neutrino)),
-    neutrino_body_(body(config.path, schema::optionals::neutrino), config.neutrino_size, config.neutrino_rate),
-    neutrino(neutrino_head_, neutrino_body_, std::max(config.neutrino_buckets, nonzero)),
+    neutrino_body_(body(config.path, schema::optionals::neutrino), config.neutrino_size, config.neutrino_rate, config.neutrino_reserve, config.neutrino_advice, config.preallocate),
+    neutrino(neutrino_head_, neutrino_body_, std::max(config.neutrino_buckets, nonzero), config.aligned_heads),
 
     ////bootstrap_head_(head(config.path / schema::dir::heads, schema::optionals::bootstrap)),
     ////bootstrap_body_(body(config.path, schema::optionals::bootstrap), config.bootstrap_size, config.bootstrap_rate),
@@ -206,6 +225,44 @@ CLASS::store(const settings& config) NOEXCEPT
     flush_lock_(lock(config.path, schema::locks::flush)),
     process_lock_(lock(config.path, schema::locks::process))
 {
+    // Pool bodies are bounded by their own budget, heads remain unbounded.
+    if constexpr (system::is_same_type<Storage, pool>)
+    {
+        header_body_.set_budget(config.pool_budget);
+        input_body_.set_budget(config.pool_budget);
+        output_body_.set_budget(config.pool_budget);
+        point_body_.set_budget(config.pool_budget);
+        puts_body_.set_budget(config.pool_budget);
+        spend_body_.set_budget(config.pool_budget);
+        tx_body_.set_budget(config.pool_budget);
+        txs_body_.set_budget(config.pool_budget);
+        candidate_body_.set_budget(config.pool_budget);
+        confirmed_body_.set_budget(config.pool_budget);
+        strong_tx_body_.set_budget(config.pool_budget);
+        strong_body_.set_budget(config.pool_budget);
+        lineage_body_.set_budget(config.pool_budget);
+        validated_bk_body_.set_budget(config.pool_budget);
+        validated_tx_body_.set_budget(config.pool_budget);
+        address_body_.set_budget(config.pool_budget);
+        neutrino_body_.set_budget(config.pool_budget);
+
+        // A slab element is bounded by a block (4,000,000 bytes), records
+        // are bounded by the default extent (one frame).
+        constexpr auto slab = pool::minimum_frames * pool::frame;
+        input_body_.set_extent(slab);
+        output_body_.set_extent(slab);
+        puts_body_.set_extent(slab);
+        txs_body_.set_extent(slab);
+        validated_bk_body_.set_extent(slab);
+        validated_tx_body_.set_extent(slab);
+        neutrino_body_.set_extent(slab);
+    }
+}
+
+TEMPLATE
+CLASS::~store() NOEXCEPT
+{
+    stop_flusher();
 }
 
 TEMPLATE
@@ -239,6 +296,7 @@ code CLASS::create(const event_handler& handler) NOEXCEPT
 
     static const auto heads = configuration_.path / schema::dir::heads;
     auto ec = file::clear_directory_ex(heads);
+    if (!ec) ec = create_format();
 
     create(ec, header_head_, table_t::header_head);
     create(ec, header_body_, table_t::header_body);
@@ -248,12 +306,14 @@ code CLASS::create(const event_handler& handler) NOEXCEPT
     create(ec, output_body_, table_t::output_body);
     create(ec, point_head_, table_t::point_head);
     create(ec, point_body_, table_t::point_body);
+    create(ec, point_filter_, table_t::point_filter);
     create(ec, puts_head_, table_t::puts_head);
     create(ec, puts_body_, table_t::puts_body);
     create(ec, spend_head_, table_t::spend_head);
     create(ec, spend_body_, table_t::spend_body);
     create(ec, tx_head_, table_t::tx_head);
     create(ec, tx_body_, table_t::tx_body);
+    create(ec, tx_filter_, table_t::tx_filter);
     create(ec, txs_head_, table_t::txs_head);
     create(ec, txs_body_, table_t::txs_body);
 
@@ -262,7 +322,11 @@ code CLASS::create(const event_handler& handler) NOEXCEPT
     create(ec, confirmed_head_, table_t::confirmed_head);
     create(ec, confirmed_body_, table_t::confirmed_body);
     create(ec, strong_tx_head_, table_t::strong_tx_head);
+    create(ec, strong_head_, table_t::strong_head);
+    create(ec, lineage_head_, table_t::lineage_head);
     create(ec, strong_tx_body_, table_t::strong_tx_body);
+    create(ec, strong_body_, table_t::strong_body);
+    create(ec, lineage_body_, table_t::lineage_body);
 
     create(ec, validated_bk_head_, table_t::validated_bk_head);
     create(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -304,6 +368,8 @@ code CLASS::create(const event_handler& handler) NOEXCEPT
     populate(ec, candidate, table_t::candidate_table);
     populate(ec, confirmed, table_t::confirmed_table);
     populate(ec, strong_tx, table_t::strong_tx_table);
+    populate(ec, strong, table_t::strong_table);
+    populate(ec, lineage, table_t::lineage_table);
 
     populate(ec, validated_bk, table_t::validated_bk_table);
     populate(ec, validated_tx, table_t::validated_tx_table);
@@ -313,6 +379,10 @@ code CLASS::create(const event_handler& handler) NOEXCEPT
     ////populate(ec, bootstrap, table_t::bootstrap_table);
     ////populate(ec, buffer, table_t::buffer_table);
 
+    // Flusher starts only once the store is fully created.
+    if (!ec)
+        start_flusher();
+
     if (ec)
     {
         /* code */ unload_close(handler);
@@ -362,7 +432,9 @@ code CLASS::open(const event_handler& handler) NOEXCEPT
         }
     };
 
-    auto ec = open_load(handler);
+    // A store of another format version is not opened.
+    auto ec = verify_format();
+    if (!ec) ec = open_load(handler);
 
     verify(ec, header, table_t::header_table);
     verify(ec, input, table_t::input_table);
@@ -376,6 +448,8 @@ code CLASS::open(const event_handler& handler) NOEXCEPT
     verify(ec, candidate, table_t::candidate_table);
     verify(ec, confirmed, table_t::confirmed_table);
     verify(ec, strong_tx, table_t::strong_tx_table);
+    verify(ec, strong, table_t::strong_table);
+    verify(ec, lineage, table_t::lineage_table);
 
     verify(ec, validated_bk, table_t::validated_bk_table);
     verify(ec, validated_tx, table_t::validated_tx_table);
@@ -385,6 +459,13 @@ code CLASS::open(const event_handler& handler) NOEXCEPT
     ////verify(ec, bootstrap, table_t::bootstrap_table);
     ////verify(ec, buffer, table_t::buffer_table);
 
+    // Headers stored without lineage (e.g. while disabled) are copied.
+    if (!ec) ec = backfill_lineage();
+
+    // Flusher starts only once the store is fully opened.
+    if (!ec)
+        start_flusher();
+
     if (ec)
     {
         /* code */ unload_close(handler);
@@ -402,6 +483,10 @@ code CLASS::open(const event_handler& handler) NOEXCEPT
 TEMPLATE
 code CLASS::snapshot(const event_handler& handler) NOEXCEPT
 {
+    // Writeback before suspending writes, so flush is mostly a barrier.
+    // Failure is not a fault, and is caught by flush.
+    /* code */ sync();
+
     while (!transactor_mutex_.try_lock_for(std::chrono::seconds(1)))
     {
         handler(event_t::wait_lock, table_t::store);
@@ -430,6 +515,8 @@ code CLASS::snapshot(const event_handler& handler) NOEXCEPT
     flush(ec, candidate_body_, table_t::candidate_body);
     flush(ec, confirmed_body_, table_t::confirmed_body);
     flush(ec, strong_tx_body_, table_t::strong_tx_body);
+    flush(ec, strong_body_, table_t::strong_body);
+    flush(ec, lineage_body_, table_t::lineage_body);
 
     flush(ec, validated_bk_body_, table_t::validated_bk_body);
     flush(ec, validated_tx_body_, table_t::validated_tx_body);
@@ -444,6 +531,106 @@ code CLASS::snapshot(const event_handler& handler) NOEXCEPT
     return ec;
 }
 
+TEMPLATE
+code CLASS::sync() NOEXCEPT
+{
+    code ec{ error::success };
+    const auto sync = [](code& ec, auto& storage) NOEXCEPT
+    {
+        if (!ec)
+            ec = storage.sync();
+    };
+
+    // Assumes/requires tables open/loaded, thread safe with writes.
+    sync(ec, header_body_);
+    sync(ec, input_body_);
+    sync(ec, output_body_);
+    sync(ec, point_body_);
+    sync(ec, puts_body_);
+    sync(ec, spend_body_);
+    sync(ec, tx_body_);
+    sync(ec, txs_body_);
+
+    sync(ec, candidate_body_);
+    sync(ec, confirmed_body_);
+    sync(ec, strong_tx_body_);
+    sync(ec, strong_body_);
+    sync(ec, lineage_body_);
+
+    sync(ec, validated_bk_body_);
+    sync(ec, validated_tx_body_);
+
+    sync(ec, address_body_);
+    sync(ec, neutrino_body_);
+    ////sync(ec, bootstrap_body_);
+    ////sync(ec, buffer_body_);
+    return ec;
+}
+
+TEMPLATE
+code CLASS::maintain(const event_handler& handler) NOEXCEPT
+{
+    // Growth relinks lists and moves heads, so all writers are suspended.
+    while (!transactor_mutex_.try_lock_for(std::chrono::seconds(1)))
+    {
+        handler(event_t::wait_lock, table_t::store);
+    }
+
+    const auto ec = maintain_(handler);
+    transactor_mutex_.unlock();
+    return ec;
+}
+
+// protected
+TEMPLATE
+code CLASS::maintain_(const event_handler& handler) NOEXCEPT
+{
+    code ec{ error::success };
+    const auto maintain = [&handler](code& ec, auto& table, table_t id) NOEXCEPT
+    {
+        if (!ec)
+        {
+            handler(event_t::maintain_table, id);
+            if (!table.maintain())
+                ec = error::maintain_table;
+        }
+    };
+
+    // Header keyed tables are presized to twice the header count, so that
+    // heads do not grow while archiving headers (see query::set_code).
+    const auto reserve = [&handler](code& ec, auto& table, size_t count,
+        table_t id) NOEXCEPT
+    {
+        if (!ec)
+        {
+            handler(event_t::maintain_table, id);
+            if (!table.reserve(count))
+                ec = error::maintain_table;
+        }
+    };
+
+    // Assumes/requires tables open/loaded.
+    const auto headers = system::possible_narrow_cast<size_t>(
+        header.count().value) * two;
+
+    maintain(ec, header, table_t::header_table);
+    maintain(ec, point, table_t::point_table);
+    maintain(ec, spend, table_t::spend_table);
+    maintain(ec, tx, table_t::tx_table);
+    reserve(ec, txs, headers, table_t::txs_table);
+
+    maintain(ec, strong_tx, table_t::strong_tx_table);
+
+    reserve(ec, validated_bk, headers, table_t::validated_bk_table);
+    maintain(ec, validated_tx, table_t::validated_tx_table);
+
+    maintain(ec, address, table_t::address_table);
+    if (neutrino.enabled())
+        reserve(ec, neutrino, headers, table_t::neutrino_table);
+
+    return ec;
+}
+
 TEMPLATE
 code CLASS::reload(const event_handler& handler) NOEXCEPT
 {
@@ -452,6 +639,10 @@ code CLASS::reload(const event_handler& handler) NOEXCEPT
         handler(event_t::wait_lock, table_t::store);
     }
 
+    // Flusher sync holds remap shared, which would preclude storage reload.
+    const auto flushing = flusher_.joinable();
+    stop_flusher();
+
     code ec{ error::success };
     const auto reload = [&handler](code& ec, auto& storage,
         table_t table) NOEXCEPT
@@ -475,12 +666,14 @@ code CLASS::reload(const event_handler& handler) NOEXCEPT
     reload(ec, output_body_, table_t::output_body);
     reload(ec, point_head_, table_t::point_head);
     reload(ec, point_body_, table_t::point_body);
+    reload(ec, point_filter_, table_t::point_filter);
     reload(ec, puts_head_, table_t::puts_head);
     reload(ec, puts_body_, table_t::puts_body);
     reload(ec, spend_head_, table_t::spend_head);
     reload(ec, spend_body_, table_t::spend_body);
     reload(ec, tx_head_, table_t::tx_head);
     reload(ec, tx_body_, table_t::tx_body);
+    reload(ec, tx_filter_, table_t::tx_filter);
     reload(ec, txs_head_, table_t::txs_head);
     reload(ec, txs_body_, table_t::txs_body);
 
@@ -489,7 +682,11 @@ code CLASS::reload(const event_handler& handler) NOEXCEPT
     reload(ec, confirmed_head_, table_t::confirmed_head);
     reload(ec, confirmed_body_, table_t::confirmed_body);
     reload(ec, strong_tx_head_, table_t::strong_tx_head);
+    reload(ec, strong_head_, table_t::strong_head);
+    reload(ec, lineage_head_, table_t::lineage_head);
     reload(ec, strong_tx_body_, table_t::strong_tx_body);
+    reload(ec, strong_body_, table_t::strong_body);
+    reload(ec, lineage_body_, table_t::lineage_body);
 
     reload(ec, validated_bk_head_, table_t::validated_bk_head);
     reload(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -505,6 +702,9 @@ code CLASS::reload(const event_handler& handler) NOEXCEPT
     ////reload(ec, buffer_head_, table_t::buffer_head);
     ////reload(ec, buffer_body_, table_t::buffer_body);
 
+    if (flushing)
+        start_flusher();
+
     transactor_mutex_.unlock();
     return ec;
 }
@@ -541,6 +741,8 @@ code CLASS::close(const event_handler& handler) NOEXCEPT
     close(ec, candidate, table_t::candidate_table);
     close(ec, confirmed, table_t::confirmed_table);
     close(ec, strong_tx, table_t::strong_tx_table);
+    close(ec, strong, table_t::strong_table);
+    close(ec, lineage, table_t::lineage_table);
 
     close(ec, validated_bk, table_t::validated_bk_table);
     close(ec, validated_tx, table_t::validated_tx_table);
@@ -590,12 +792,14 @@ code CLASS::open_load(const event_handler& handler) NOEXCEPT
     open(ec, output_body_, table_t::output_body);
     open(ec, point_head_, table_t::point_head);
     open(ec, point_body_, table_t::point_body);
+    open(ec, point_filter_, table_t::point_filter);
     open(ec, puts_head_, table_t::puts_head);
     open(ec, puts_body_, table_t::puts_body);
     open(ec, spend_head_, table_t::spend_head);
     open(ec, spend_body_, table_t::spend_body);
     open(ec, tx_head_, table_t::tx_head);
     open(ec, tx_body_, table_t::tx_body);
+    open(ec, tx_filter_, table_t::tx_filter);
     open(ec, txs_head_, table_t::txs_head);
     open(ec, txs_body_, table_t::txs_body);
 
@@ -604,7 +808,11 @@ code CLASS::open_load(const event_handler& handler) NOEXCEPT
     open(ec, confirmed_head_, table_t::confirmed_head);
     open(ec, confirmed_body_, table_t::confirmed_body);
     open(ec, strong_tx_head_, table_t::strong_tx_head);
+    open(ec, strong_head_, table_t::strong_head);
+    open(ec, lineage_head_, table_t::lineage_head);
     open(ec, strong_tx_body_, table_t::strong_tx_body);
+    open(ec, strong_body_, table_t::strong_body);
+    open(ec, lineage_body_, table_t::lineage_body);
 
     open(ec, validated_bk_head_, table_t::validated_bk_head);
     open(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -637,12 +845,14 @@ code CLASS::open_load(const event_handler& handler) NOEXCEPT
     load(ec, output_body_, table_t::output_body);
     load(ec, point_head_, table_t::point_head);
     load(ec, point_body_, table_t::point_body);
+    load(ec, point_filter_, table_t::point_filter);
     load(ec, puts_head_, table_t::puts_head);
     load(ec, puts_body_, table_t::puts_body);
     load(ec, spend_head_, table_t::spend_head);
     load(ec, spend_body_, table_t::spend_body);
     load(ec, tx_head_, table_t::tx_head);
     load(ec, tx_body_, table_t::tx_body);
+    load(ec, tx_filter_, table_t::tx_filter);
     load(ec, txs_head_, table_t::txs_head);
     load(ec, txs_body_, table_t::txs_body);
 
@@ -651,7 +861,11 @@ code CLASS::open_load(const event_handler& handler) NOEXCEPT
     load(ec, confirmed_head_, table_t::confirmed_head);
     load(ec, confirmed_body_, table_t::confirmed_body);
     load(ec, strong_tx_head_, table_t::strong_tx_head);
+    load(ec, strong_head_, table_t::strong_head);
+    load(ec, lineage_head_, table_t::lineage_head);
     load(ec, strong_tx_body_, table_t::strong_tx_body);
+    load(ec, strong_body_, table_t::strong_body);
+    load(ec, lineage_body_, table_t::lineage_body);
 
     load(ec, validated_bk_head_, table_t::validated_bk_head);
     load(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -666,13 +880,15 @@ code CLASS::open_load(const event_handler& handler) NOEXCEPT
     ////load(ec, bootstrap_body_, table_t::bootstrap_body);
     ////load(ec, buffer_head_, table_t::buffer_head);
     ////load(ec, buffer_body_, table_t::buffer_body);
-
     return ec;
 }
 
 TEMPLATE
 code CLASS::unload_close(const event_handler& handler) NOEXCEPT
 {
+    // Writeback requires loaded bodies.
+    stop_flusher();
+
     code ec{ error::success };
     const auto unload = [&handler](code& ec, auto& storage, table_t table) NOEXCEPT
     {
@@ -691,12 +907,14 @@ code CLASS::unload_close(const event_handler& handler) NOEXCEPT
     unload(ec, output_body_, table_t::output_body);
     unload(ec, point_head_, table_t::point_head);
     unload(ec, point_body_, table_t::point_body);
+    unload(ec, point_filter_, table_t::point_filter);
     unload(ec, puts_head_, table_t::puts_head);
     unload(ec, puts_body_, table_t::puts_body);
     unload(ec, spend_head_, table_t::spend_head);
     unload(ec, spend_body_, table_t::spend_body);
     unload(ec, tx_head_, table_t::tx_head);
     unload(ec, tx_body_, table_t::tx_body);
+    unload(ec, tx_filter_, table_t::tx_filter);
     unload(ec, txs_head_, table_t::txs_head);
     unload(ec, txs_body_, table_t::txs_body);
 
@@ -705,7 +923,11 @@ code CLASS::unload_close(const event_handler& handler) NOEXCEPT
     unload(ec, confirmed_head_, table_t::confirmed_head);
     unload(ec, confirmed_body_, table_t::confirmed_body);
     unload(ec, strong_tx_head_, table_t::strong_tx_head);
+    unload(ec, strong_head_, table_t::strong_head);
+    unload(ec, lineage_head_, table_t::lineage_head);
     unload(ec, strong_tx_body_, table_t::strong_tx_body);
+    unload(ec, strong_body_, table_t::strong_body);
+    unload(ec, lineage_body_, table_t::lineage_body);
 
     unload(ec, validated_bk_head_, table_t::validated_bk_head);
     unload(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -738,12 +960,14 @@ code CLASS::unload_close(const event_handler& handler) NOEXCEPT
     close(ec, output_body_, table_t::output_body);
     close(ec, point_head_, table_t::point_head);
     close(ec, point_body_, table_t::point_body);
+    close(ec, point_filter_, table_t::point_filter);
     close(ec, puts_head_, table_t::puts_head);
     close(ec, puts_body_, table_t::puts_body);
     close(ec, spend_head_, table_t::spend_head);
     close(ec, spend_body_, table_t::spend_body);
     close(ec, tx_head_, table_t::tx_head);
     close(ec, tx_body_, table_t::tx_body);
+    close(ec, tx_filter_, table_t::tx_filter);
     close(ec, txs_head_, table_t::txs_head);
     close(ec, txs_body_, table_t::txs_body);
 
@@ -752,7 +976,11 @@ code CLASS::unload_close(const event_handler& handler) NOEXCEPT
     close(ec, confirmed_head_, table_t::confirmed_head);
     close(ec, confirmed_body_, table_t::confirmed_body);
     close(ec, strong_tx_head_, table_t::strong_tx_head);
+    close(ec, strong_head_, table_t::strong_head);
+    close(ec, lineage_head_, table_t::lineage_head);
     close(ec, strong_tx_body_, table_t::strong_tx_body);
+    close(ec, strong_body_, table_t::strong_body);
+    close(ec, lineage_body_, table_t::lineage_body);
 
     close(ec, validated_bk_head_, table_t::validated_bk_head);
     close(ec, validated_bk_body_, table_t::validated_bk_body);
@@ -798,6 +1026,8 @@ code CLASS::backup(const event_handler& handler) NOEXCEPT
     backup(ec, candidate, table_t::candidate_table);
     backup(ec, confirmed, table_t::confirmed_table);
     backup(ec, strong_tx, table_t::strong_tx_table);
+    backup(ec, strong, table_t::strong_table);
+    backup(ec, lineage, table_t::lineage_table);
 
     backup(ec, validated_bk, table_t::validated_bk_table);
     backup(ec, validated_tx, table_t::validated_tx_table);
@@ -851,6 +1081,8 @@ code CLASS::dump(const path& folder,
     auto candidate_buffer = candidate_head_.get();
     auto confirmed_buffer = confirmed_head_.get();
     auto strong_tx_buffer = strong_tx_head_.get();
+    auto strong_buffer = strong_head_.get();
+    auto lineage_buffer = lineage_head_.get();
 
     auto validated_bk_buffer = validated_bk_head_.get();
     auto validated_tx_buffer = validated_tx_head_.get();
@@ -872,6 +1104,8 @@ code CLASS::dump(const path& folder,
     if (!candidate_buffer) return error::unloaded_file;
     if (!confirmed_buffer) return error::unloaded_file;
     if (!strong_tx_buffer) return error::unloaded_file;
+    if (!strong_buffer) return error::unloaded_file;
+    if (!lineage_buffer) return error::unloaded_file;
 
     if (!validated_bk_buffer) return error::unloaded_file;
     if (!validated_tx_buffer) return error::unloaded_file;
@@ -905,6 +1139,8 @@ code CLASS::dump(const path& folder,
     dump(ec, candidate_buffer, schema::indexes::candidate, table_t::candidate_head);
     dump(ec, confirmed_buffer, schema::indexes::confirmed, table_t::confirmed_head);
     dump(ec, strong_tx_buffer, schema::indexes::strong_tx, table_t::strong_tx_head);
+    dump(ec, strong_buffer, schema::indexes::strong, table_t::strong_head);
+    dump(ec, lineage_buffer, schema::indexes::lineage, table_t::lineage_head);
 
     dump(ec, validated_bk_buffer, schema::caches::validated_bk, table_t::validated_bk_head);
     dump(ec, validated_tx_buffer, schema::caches::validated_tx, table_t::validated_tx_head);
@@ -967,6 +1203,13 @@ code CLASS::restore(const event_handler& handler) NOEXCEPT
         ec = error::missing_snapshot;
     }
 
+    // A store of another format version is not restored.
+    if (!ec) ec = verify_format();
+
+    // Filters are not archived, so are recreated here and rebuilt by restore.
+    if (!ec) ec = file::create_file_ex(point_filter_.file());
+    if (!ec) ec = file::create_file_ex(tx_filter_.file());
+
     const auto restore = [&handler](code& ec, auto& storage, table_t table) NOEXCEPT
     {
         if (!ec)
@@ -994,6 +1237,8 @@ code CLASS::restore(const event_handler& handler) NOEXCEPT
         restore(ec, candidate, table_t::candidate_table);
         restore(ec, confirmed, table_t::confirmed_table);
         restore(ec, strong_tx, table_t::strong_tx_table);
+        restore(ec, strong, table_t::strong_table);
+        restore(ec, lineage, table_t::lineage_table);
 
         restore(ec, validated_bk, table_t::validated_bk_table);
         restore(ec, validated_tx, table_t::validated_tx_table);
@@ -1003,8 +1248,13 @@ code CLASS::restore(const event_handler& handler) NOEXCEPT
         ////restore(ec, bootstrap, table_t::bootstrap_table);
         ////restore(ec, buffer, table_t::buffer_table);
 
+        // Headers stored without lineage (e.g. while disabled) are copied.
+        if (!ec) ec = backfill_lineage();
+
         if (ec)
             /* code */ unload_close(handler);
+        else
+            start_flusher();
     }
 
     if (ec)
@@ -1021,6 +1271,108 @@ code CLASS::restore(const event_handler& handler) NOEXCEPT
     return ec;
 }
 
+TEMPLATE
+void CLASS::start_flusher() NOEXCEPT
+{
+    if (is_zero(configuration_.flush_interval) || flusher_.joinable())
+        return;
+
+    const auto interval = std::chrono::milliseconds(
+        configuration_.flush_interval);
+
+    stopping_ = false;
+    flusher_ = std::thread([this, interval]() NOEXCEPT
+    {
+        std::unique_lock lock(flusher_mutex_);
+        while (!flusher_condition_.wait_for(lock, interval,
+            [this]() NOEXCEPT { return stopping_; }))
+        {
+            // Failure is not a fault, and is caught by the next flush.
+            lock.unlock();
+            /* code */ sync();
+
+            // Heads are stepped only while writers are idle (not awaited).
+            if (is_nonzero(configuration_.bucket_load) &&
+                transactor_mutex_.try_lock())
+            {
+                /* code */ maintain_([](auto, auto) NOEXCEPT {});
+                transactor_mutex_.unlock();
+            }
+
+            lock.lock();
+        }
+    });
+}
+
+TEMPLATE
+void CLASS::stop_flusher() NOEXCEPT
+{
+    if (!flusher_.joinable())
+        return;
+
+    {
+        std::unique_lock lock(flusher_mutex_);
+        stopping_ = true;
+    }
+
+    flusher_condition_.notify_one();
+    flusher_.join();
+}
+
+TEMPLATE
+code CLASS::create_format() const NOEXCEPT
+{
+    const auto version = system::to_little_endian(schema::format::version);
+    return file::create_file_ex(configuration_.path / schema::format::name,
+        version.data(), version.size());
+}
+
+TEMPLATE
+code CLASS::verify_format() const NOEXCEPT
+{
+    // A missing format file implies a store that predates versioning.
+    system::data_array<sizeof(uint32_t)> version{};
+    if (!file::read_file(configuration_.path / schema::format::name,
+        version.data(), version.size()))
+        return error::store_format;
+
+    return system::from_little_endian<uint32_t>(version) ==
+        schema::format::version ? error::success : error::store_format;
+}
+
+TEMPLATE
+code CLASS::backfill_lineage() NOEXCEPT
+{
+    if (!configuration_.header_lineage)
+        return error::success;
+
+    // Lineage is set before its header is committed, so only headers stored
+    // while it was disabled (or before it existed) extend beyond its count.
+    // Unset records within the count remain, and are read from the header.
+    const auto headers = header.count().value;
+    for (auto index = lineage.count().value; index < headers; ++index)
+    {
+        const table::header::link link{ index };
+        table::header::get_lineage fields{};
+        if (!header.get(link, fields) ||
+            !lineage.set(link, table::lineage::record
+            {
+                {},
+                fields.parent_fk,
+                fields.version,
+                fields.timestamp,
+                fields.bits,
+                fields.height,
+                true
+            }))
+        {
+            return error::header_lineage_set;
+        }
+    }
+
+    return error::success;
+}
+
 // context
 // ----------------------------------------------------------------------------
 
@@ -1045,6 +1397,8 @@ code CLASS::get_fault() const NOEXCEPT
     if ((ec = candidate_body_.get_fault())) return ec;
     if ((ec = confirmed_body_.get_fault())) return ec;
     if ((ec = strong_tx_body_.get_fault())) return ec;
+    if ((ec = strong_body_.get_fault())) return ec;
+    if ((ec = lineage_body_.get_fault())) return ec;
     if ((ec = validated_bk_body_.get_fault())) return ec;
     if ((ec = validated_tx_body_.get_fault())) return ec;
     if ((ec = address_body_.get_fault())) return ec;
@@ -1074,6 +1428,8 @@ size_t CLASS::get_space() const NOEXCEPT
     space(candidate_body_);
     space(confirmed_body_);
     space(strong_tx_body_);
+    space(strong_body_);
+    space(lineage_body_);
     space(validated_bk_body_);
     space(validated_tx_body_);
     space(address_body_);
@@ -1107,6 +1463,8 @@ void CLASS::report(const error_handler& handler) const NOEXCEPT
     report(candidate_body_, table_t::candidate_body);
     report(confirmed_body_, table_t::confirmed_body);
     report(strong_tx_body_, table_t::strong_tx_body);
+    report(strong_body_, table_t::strong_body);
+    report(lineage_body_, table_t::lineage_body);
     report(validated_bk_body_, table_t::validated_bk_body);
     report(validated_tx_body_, table_t::validated_tx_body);
     report(address_body_, table_t::address_body);
@@ -1115,12 +1473,47 @@ void CLASS::report(const error_handler& handler) const NOEXCEPT
     ////report(buffer_body_, table_t::buffer_body);
 }
 
+TEMPLATE
+void CLASS::pending(const pending_handler& handler) const NOEXCEPT
+{
+    const auto pending = [&handler](const auto& storage, table_t table) NOEXCEPT
+    {
+        handler(storage.pending(), storage.lag(), table);
+    };
+
+    pending(header_body_, table_t::header_body);
+    pending(input_body_, table_t::input_body);
+    pending(output_body_, table_t::output_body);
+    pending(point_body_, table_t::point_body);
+    pending(puts_body_, table_t::puts_body);
+    pending(spend_body_, table_t::spend_body);
+    pending(tx_body_, table_t::tx_body);
+    pending(txs_body_, table_t::txs_body);
+    pending(candidate_body_, table_t::candidate_body);
+    pending(confirmed_body_, table_t::confirmed_body);
+    pending(strong_tx_body_, table_t::strong_tx_body);
+    pending(strong_body_, table_t::strong_body);
+    pending(lineage_body_, table_t::lineage_body);
+    pending(validated_bk_body_, table_t::validated_bk_body);
+    pending(validated_tx_body_, table_t::validated_tx_body);
+    pending(address_body_, table_t::address_body);
+    pending(neutrino_body_, table_t::neutrino_body);
+    ////pending(bootstrap_body_, table_t::bootstrap_body);
+    ////pending(buffer_body_, table_t::buffer_body);
+}
+
 TEMPLATE
 bool CLASS::minimize() const NOEXCEPT
 {
     return configuration_.minimize;
 }
 
+TEMPLATE
+bool CLASS::header_lineage() const NOEXCEPT
+{
+    return configuration_.header_lineage;
+}
+
 BC_POP_WARNING()
 
 } // namespace database
@@ -22,5 +22,6 @@
 #include <bitcoin/database/locks/file_lock.hpp>
 #include <bitcoin/database/locks/flush_lock.hpp>
 #include <bitcoin/database/locks/interprocess_lock.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
 
 #endif
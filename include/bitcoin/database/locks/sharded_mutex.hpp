@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_LOCKS_SHARDED_MUTEX_HPP
+#define LIBBITCOIN_DATABASE_LOCKS_SHARDED_MUTEX_HPP
+
+#include <atomic>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Reader-preferring shared mutex with per-thread reader slots.
+/// Shared lock/unlock touch only the caller's slot (its own cache line) and
+/// read the writer flag, so concurrent readers do not contend. Exclusive lock
+/// is expensive (scans all slots) and is intended for rare operations such as
+/// remap. Satisfies the SharedMutex requirements (std::shared_lock and
+/// std::unique_lock). As with std::shared_mutex on posix, shared locks may be
+/// taken recursively on one thread, and writers may starve under constant
+/// read load.
+class BCD_API sharded_mutex
+{
+public:
+    DELETE_COPY_MOVE_DESTRUCT(sharded_mutex);
+
+    /// Number of reader slots (threads beyond this share slots).
+    static constexpr size_t slots = 64;
+
+    sharded_mutex() NOEXCEPT;
+
+    /// Exclusive (writer) access.
+    void lock() NOEXCEPT;
+    bool try_lock() NOEXCEPT;
+    void unlock() NOEXCEPT;
+
+    /// Shared (reader) access.
+    void lock_shared() NOEXCEPT;
+    bool try_lock_shared() NOEXCEPT;
+    void unlock_shared() NOEXCEPT;
+
+private:
+    static constexpr size_t line = 64;
+
+    struct alignas(line) slot
+    {
+        std::atomic<size_t> readers{};
+    };
+
+    static size_t index() NOEXCEPT;
+    bool is_free() const NOEXCEPT;
+
+    // These are thread safe.
+    std::atomic_bool writer_{};
+    std_array<slot, slots> slots_{};
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -19,6 +19,7 @@
 #ifndef LIBBITCOIN_DATABASE_MEMORY_ACCESSOR_HPP
 #define LIBBITCOIN_DATABASE_MEMORY_ACCESSOR_HPP
 
+#include <mutex>
 #include <shared_mutex>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
@@ -28,7 +29,8 @@ namespace libbitcoin {
 namespace database {
 
 /// Shared r/w access to a memory buffer, mutex blocks memory remap.
-template <typename Mutex>
+/// An exclusive lock (std::unique_lock) also blocks all other accessors.
+template <typename Mutex, typename Lock = std::shared_lock<Mutex>>
 class accessor
   : public memory
 {
@@ -60,14 +62,14 @@ public:
 private:
     uint8_t* begin_{};
     uint8_t* end_{};
-    std::shared_lock<Mutex> shared_lock_;
+    Lock lock_;
 };
 
 } // namespace database
 } // namespace libbitcoin
 
-#define TEMPLATE template <typename Mutex>
-#define CLASS accessor<Mutex>
+#define TEMPLATE template <typename Mutex, typename Lock>
+#define CLASS accessor<Mutex, Lock>
 
 #include <bitcoin/database/impl/memory/accessor.ipp>
 
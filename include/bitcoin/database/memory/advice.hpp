@@ -0,0 +1,39 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_ADVICE_HPP
+#define LIBBITCOIN_DATABASE_MEMORY_ADVICE_HPP
+
+namespace libbitcoin {
+namespace database {
+
+/// Memory map access pattern hint, applied over the full map (madvise).
+/// hugepage is best effort, it is ignored where not supported by the platform.
+enum class advice
+{
+    normal,
+    random,
+    sequential,
+    willneed,
+    hugepage
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
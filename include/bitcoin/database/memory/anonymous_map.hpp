@@ -0,0 +1,199 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_ANONYMOUS_MAP_HPP
+#define LIBBITCOIN_DATABASE_MEMORY_ANONYMOUS_MAP_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+#include <bitcoin/database/memory/accessor.hpp>
+#include <bitcoin/database/memory/advice.hpp>
+#include <bitcoin/database/memory/interfaces/memory.hpp>
+#include <bitcoin/database/memory/interfaces/storage.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Thread safe access to an in-memory (anonymous) image of a file.
+/// The file is read into memory upon load and is written only upon flush and
+/// unload, so the file retains the on-disk layout of the last flush (or of
+/// its original state) until unload. As heads and bodies are both written
+/// upon unload, a closed store may be reopened with map.
+class BCD_API anonymous_map
+  : public storage
+{
+public:
+    DELETE_COPY_MOVE(anonymous_map);
+
+    /// Parameters are positional with map, so that anonymous_map may be
+    /// substituted for map in store. A nonzero reserve (bytes) reserves
+    /// address space so that growth within it does not move the memory. The
+    /// hugepage hint enables transparent hugepages for the memory. Preallocate
+    /// commits memory upon growth, so that memory exhaustion is detected upon
+    /// allocation (Linux only, else ignored).
+    anonymous_map(const std::filesystem::path& filename, size_t minimum=1,
+        size_t expansion=0, size_t reserve=0, advice hint=advice::random,
+        bool preallocate=false) NOEXCEPT;
+
+    /// Destruct for debug assertion only.
+    virtual ~anonymous_map() NOEXCEPT;
+
+    /// True if the file is open.
+    bool is_open() const NOEXCEPT;
+
+    /// True if the memory is loaded.
+    bool is_loaded() const NOEXCEPT;
+
+    /// storage interface
+    /// -----------------------------------------------------------------------
+
+    /// Open file, must be closed.
+    code open() NOEXCEPT override;
+
+    /// Close file, must be unloaded, idempotent.
+    code close() NOEXCEPT override;
+
+    /// Allocate memory and read file into it, must be open and unloaded.
+    code load() NOEXCEPT override;
+
+    /// Clear disk full condition, fails if fault, must be loaded, idempotent.
+    code reload() NOEXCEPT override;
+
+    /// Write memory to file, truncate to logical and fsync, suspend writes for
+    /// call, must be loaded.
+    code flush() NOEXCEPT override;
+
+    /// No writeback occurs between flushes, must be loaded.
+    code sync() NOEXCEPT override;
+
+    /// Write memory to file, truncate to logical, fsync and release memory,
+    /// restartable (memory retained upon failure), idempotent.
+    code unload() NOEXCEPT override;
+
+    /// The filesystem path of the file.
+    const std::filesystem::path& file() const NOEXCEPT override;
+
+    /// The current logical size of the memory (zero if closed).
+    size_t size() const NOEXCEPT override;
+
+    /// The current capacity of the memory (zero if unloaded).
+    size_t capacity() const NOEXCEPT override;
+
+    /// Always zero, as there is no writeback between flushes.
+    size_t pending() const NOEXCEPT override;
+
+    /// Bytes of logical size not yet flushed to file.
+    size_t lag() const NOEXCEPT override;
+
+    /// The reserved address space of the memory (zero if unreserved).
+    size_t reserved() const NOEXCEPT;
+
+    /// Reduce logical size to specified (false if size exceeds logical).
+    bool truncate(size_t size) NOEXCEPT override;
+
+    /// Allocate bytes and return offset to first allocated (or eof).
+    size_t allocate(size_t chunk) NOEXCEPT override;
+
+    /// Get remap-protected r/w access to start/offset of memory (or null).
+    memory_ptr get(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get remap-protected r/w access to start/offset for write (or null).
+    memory_ptr get_write(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get exclusive r/w access to start/offset of memory (or null).
+    memory_ptr get_exclusive(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get unprotected r/w access to start/offset of memory (or null).
+    memory::iterator get_raw(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get the fault condition.
+    code get_fault() const NOEXCEPT override;
+
+    /// Get the space required to clear the disk full condition.
+    size_t get_space() const NOEXCEPT override;
+
+protected:
+    size_t to_capacity(size_t required) const NOEXCEPT;
+    void set_first_code(const error::error_t& ec) NOEXCEPT;
+    void set_disk_space(size_t required) NOEXCEPT;
+
+private:
+    using path = std::filesystem::path;
+    using access = accessor<sharded_mutex>;
+    using exclusive = accessor<sharded_mutex, std::unique_lock<sharded_mutex>>;
+    using allocator = recycler<access>;
+
+    // Memory utilities, not thread safe.
+    bool read_(size_t size) NOEXCEPT;
+    bool write_(size_t size) NOEXCEPT;
+    bool release_() NOEXCEPT;
+    bool map_(size_t size) NOEXCEPT;
+    bool remap_(size_t size) NOEXCEPT;
+    bool extend_(size_t size) NOEXCEPT;
+    bool populate_(size_t start, size_t size) NOEXCEPT;
+    bool advise_(size_t start, size_t size) NOEXCEPT;
+
+    // Constants.
+    const std::filesystem::path filename_;
+    const size_t minimum_;
+    const size_t expansion_;
+    const size_t reserve_;
+    const advice advice_;
+    const bool preallocate_;
+
+    // Protected by remap_mutex.
+    // requires remap_mutex_ exclusive lock for write.
+    // requires remap_mutex_ minimum shared lock for flush/read.
+    uint8_t* memory_{};
+    mutable sharded_mutex remap_mutex_{};
+
+    // Protected by field_mutex.
+    // fields require field_mutex_ exclusive lock for write.
+    // fields require minimum field_mutex_ shared lock for flush/read.
+    int opened_{ file::invalid };
+    bool fault_{};
+    bool loaded_{};
+    size_t reserved_{};
+    mutable std::shared_mutex field_mutex_{};
+
+    // Requires field_mutex_ exclusive lock for write, atomic for lock-free read.
+    std::atomic<size_t> capacity_{};
+
+    // Requires field_mutex_ exclusive lock or capacity_ bound for write (cas).
+    std::atomic<size_t> logical_{};
+
+    // Logical watermark of last flush (conservative).
+    std::atomic<size_t> flushed_{};
+
+    // These are thread safe.
+    std::atomic<size_t> space_{ zero };
+    std::atomic<error::error_t> error_{ error::success };
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -49,6 +49,10 @@ public:
     /// Flush memory map to disk, suspend writes for call, must be loaded.
     virtual code flush() NOEXCEPT = 0;
 
+    /// Begin writeback of logical range not yet written back, must be loaded.
+    /// Does not wait on writeback or suspend writes (flush is the barrier).
+    virtual code sync() NOEXCEPT = 0;
+
     /// Flush, unmap and truncate to logical, restartable, idempotent.
     virtual code unload() NOEXCEPT = 0;
 
@@ -61,6 +65,12 @@ public:
     /// The current capacity of the memory map (zero if unmapped).
     virtual size_t capacity() const NOEXCEPT = 0;
 
+    /// Bytes of logical size not yet submitted for writeback.
+    virtual size_t pending() const NOEXCEPT = 0;
+
+    /// Bytes of logical size not yet flushed to disk.
+    virtual size_t lag() const NOEXCEPT = 0;
+
     /// Reduce logical size to specified (false if size exceeds logical).
     virtual bool truncate(size_t size) NOEXCEPT = 0;
 
@@ -70,6 +80,15 @@ public:
     /// Get remap-protected r/w access to start/offset of memory map (or null).
     virtual memory_ptr get(size_t offset=zero) const NOEXCEPT = 0;
 
+    /// Get remap-protected r/w access to start/offset for write (or null).
+    /// As get(), but identifies the memory as written (for write back).
+    virtual memory_ptr get_write(size_t offset=zero) const NOEXCEPT = 0;
+
+    /// Get exclusive r/w access to start/offset of memory map (or null).
+    /// Blocks until all remap-protected access is released, and precludes it
+    /// (and remap) until released. Must not be held with get() on one thread.
+    virtual memory_ptr get_exclusive(size_t offset=zero) const NOEXCEPT = 0;
+
     /// Get unprotected r/w access to start/offset of memory map (or null).
     virtual memory::iterator get_raw(size_t offset=zero) const NOEXCEPT = 0;
 
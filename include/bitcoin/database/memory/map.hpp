@@ -28,9 +28,12 @@
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/error.hpp>
 #include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
 #include <bitcoin/database/memory/accessor.hpp>
+#include <bitcoin/database/memory/advice.hpp>
 #include <bitcoin/database/memory/interfaces/memory.hpp>
 #include <bitcoin/database/memory/interfaces/storage.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -42,8 +45,15 @@ class BCD_API map
 public:
     DELETE_COPY_MOVE(map);
 
+    /// A nonzero reserve (bytes) maps the file into a reserved range of address
+    /// space, so growth within the reservation does not move the map or wait
+    /// on readers. Not supported on Windows (reserve is ignored).
+    /// The access hint is applied to the full map upon each map/remap.
+    /// Preallocation allocates disk space upon growth (vs. sparse growth), so
+    /// that disk full is detected upon allocation (Linux only, else ignored).
     map(const std::filesystem::path& filename, size_t minimum=1,
-        size_t expansion=0) NOEXCEPT;
+        size_t expansion=0, size_t reserve=0, advice hint=advice::random,
+        bool preallocate=false) NOEXCEPT;
 
     /// Destruct for debug assertion only.
     virtual ~map() NOEXCEPT;
@@ -72,6 +82,10 @@ public:
     /// Flush memory map to disk, suspend writes for call, must be loaded.
     code flush() NOEXCEPT override;
 
+    /// Begin writeback of range appended since last sync, does not wait on
+    /// writeback or suspend writes, must be loaded.
+    code sync() NOEXCEPT override;
+
     /// Flush, unmap and truncate to logical, restartable, idempotent.
     code unload() NOEXCEPT override;
 
@@ -84,6 +98,15 @@ public:
     /// The current capacity of the memory map (zero if unloaded).
     size_t capacity() const NOEXCEPT override;
 
+    /// Bytes of logical size not yet submitted for writeback.
+    size_t pending() const NOEXCEPT override;
+
+    /// Bytes of logical size not yet flushed to disk.
+    size_t lag() const NOEXCEPT override;
+
+    /// The reserved address space of the memory map (zero if unreserved).
+    size_t reserved() const NOEXCEPT;
+
     /// Reduce logical size to specified (false if size exceeds logical).
     bool truncate(size_t size) NOEXCEPT override;
 
@@ -93,6 +116,12 @@ public:
     /// Get remap-protected r/w access to start/offset of memory map (or null).
     memory_ptr get(size_t offset=zero) const NOEXCEPT override;
 
+    /// Get remap-protected r/w access to start/offset for write (or null).
+    memory_ptr get_write(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get exclusive r/w access to start/offset of memory map (or null).
+    memory_ptr get_exclusive(size_t offset=zero) const NOEXCEPT override;
+
     /// Get unprotected r/w access to start/offset of memory map (or null).
     memory::iterator get_raw(size_t offset=zero) const NOEXCEPT override;
 
@@ -110,26 +139,36 @@ protected:
 
 private:
     using path = std::filesystem::path;
-    using access = accessor<std::shared_mutex>;
+    using access = accessor<sharded_mutex>;
+    using exclusive = accessor<sharded_mutex, std::unique_lock<sharded_mutex>>;
+    using allocator = recycler<access>;
 
     // Mapping utilities.
     bool flush_() NOEXCEPT;
+    bool sync_(size_t start, size_t end) NOEXCEPT;
     bool unmap_() NOEXCEPT;
     bool map_() NOEXCEPT;
     bool remap_(size_t size) NOEXCEPT;
+    bool extend_(size_t size) NOEXCEPT;
     bool resize_(size_t size) NOEXCEPT;
-    bool finalize_(size_t size) NOEXCEPT;
+    bool fallocate_(size_t size) NOEXCEPT;
+    bool finalize_(size_t size, size_t start) NOEXCEPT;
+    bool advise_(size_t start, size_t size) NOEXCEPT;
 
     // Constants.
     const std::filesystem::path filename_;
     const size_t minimum_;
     const size_t expansion_;
+    const size_t reserve_;
+    const advice advice_;
+    const bool preallocate_;
 
     // Protected by remap_mutex.
     // requires remap_mutex_ exclusive lock for write.
     // requires remap_mutex_ minimum shared lock for flush/read.
+    // Shared locks do not contend across threads (see sharded_mutex).
     uint8_t* memory_map_{};
-    mutable std::shared_mutex remap_mutex_{};
+    mutable sharded_mutex remap_mutex_{};
 
     // Protected by field_mutex.
     // fields require field_mutex_ exclusive lock for write.
@@ -137,10 +176,19 @@ private:
     int opened_{ file::invalid };
     bool fault_{};
     bool loaded_{};
-    size_t capacity_{};
-    size_t logical_{};
+    size_t reserved_{};
     mutable std::shared_mutex field_mutex_{};
 
+    // Requires field_mutex_ exclusive lock for write, atomic for lock-free read.
+    std::atomic<size_t> capacity_{};
+
+    // Requires field_mutex_ exclusive lock or capacity_ bound for write (cas).
+    std::atomic<size_t> logical_{};
+
+    // Logical watermarks of last writeback and last flush (conservative).
+    std::atomic<size_t> synced_{};
+    std::atomic<size_t> flushed_{};
+
     // These are thread safe.
     std::atomic<size_t> space_{ zero };
     std::atomic<error::error_t> error_{ error::success };
@@ -0,0 +1,260 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_POOL_HPP
+#define LIBBITCOIN_DATABASE_MEMORY_POOL_HPP
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+#include <bitcoin/database/memory/accessor.hpp>
+#include <bitcoin/database/memory/advice.hpp>
+#include <bitcoin/database/memory/interfaces/memory.hpp>
+#include <bitcoin/database/memory/interfaces/storage.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Thread safe access to a file through a bounded user-space buffer pool.
+/// The file is presented as contiguous memory (as with map), but is neither
+/// file-mapped nor page cache resident. Frames are read (pread) as they are
+/// resolved through a memory_ptr, which pins them until it is destructed.
+/// Unpinned frames are evicted (CLOCK) and written back (pwrite) so that
+/// resident frames do not exceed the budget. The memory of get() spans the
+/// logical size, and get() and each offset() of the returned memory pin a
+/// window of the extent from the resolved position, so a single element read
+/// or written from a resolved position may not exceed the extent (see
+/// set_extent). A stream over the memory is bounded (by end) to the window
+/// pinned at begin. An accessor retains its two most recently resolved
+/// windows, invalidating pointers obtained from earlier offsets (so two
+/// elements may be accessed together). There is no write detection, so a frame
+/// pinned by get_write() or get_exclusive() is presumed written. With an
+/// unbounded budget all frames are resident and fixed (as with anonymous_map,
+/// but written back), so that unguarded access (get_raw) and whole-file access
+/// (dump) are supported, as required for table heads. Not on Windows.
+class BCD_API pool
+  : public storage
+{
+public:
+    DELETE_COPY_MOVE(pool);
+
+    /// The unit of residency, read and write back (multiple of page size).
+    static constexpr size_t frame = 64u * 1024u;
+
+    /// The minimum budget in frames. Pinned frames are not evicted, so the
+    /// budget is exceeded while all resident frames are pinned.
+    static constexpr size_t minimum_frames = 64;
+
+    /// Parameters are positional with map. Reserve is the minimum address
+    /// space reservation (bytes), advice applies to file reads (fadvise) and
+    /// preallocate allocates disk space upon growth (fallocate). Budget is
+    /// the limit of resident frames (bytes), zero is unbounded (see above).
+    pool(const std::filesystem::path& filename, size_t minimum=1,
+        size_t expansion=0, size_t reserve=0, advice hint=advice::random,
+        bool preallocate=false, size_t budget=0) NOEXCEPT;
+
+    /// Destruct for debug assertion only.
+    virtual ~pool() NOEXCEPT;
+
+    /// True if the file is open.
+    bool is_open() const NOEXCEPT;
+
+    /// True if the pool is loaded.
+    bool is_loaded() const NOEXCEPT;
+
+    /// storage interface
+    /// -----------------------------------------------------------------------
+
+    /// Open file, must be closed.
+    code open() NOEXCEPT override;
+
+    /// Close file, must be unloaded, idempotent.
+    code close() NOEXCEPT override;
+
+    /// Reserve address space for the file, must be open and unloaded.
+    code load() NOEXCEPT override;
+
+    /// Clear disk full condition, fails if fault, must be loaded, idempotent.
+    code reload() NOEXCEPT override;
+
+    /// Write back dirty frames and fsync, suspend writes for call.
+    code flush() NOEXCEPT override;
+
+    /// Write back dirty frames, does not fsync or suspend writes.
+    code sync() NOEXCEPT override;
+
+    /// Flush, release and truncate to logical, restartable, idempotent.
+    code unload() NOEXCEPT override;
+
+    /// The filesystem path of the file.
+    const std::filesystem::path& file() const NOEXCEPT override;
+
+    /// The current logical size of the file (zero if closed).
+    size_t size() const NOEXCEPT override;
+
+    /// The current capacity of the file (zero if unloaded).
+    size_t capacity() const NOEXCEPT override;
+
+    /// Bytes of dirty frames (not yet written back).
+    size_t pending() const NOEXCEPT override;
+
+    /// Bytes of logical size not yet flushed to disk.
+    size_t lag() const NOEXCEPT override;
+
+    /// Bytes of resident frames (exceeds budget only while pinned).
+    size_t resident() const NOEXCEPT;
+
+    /// Set the budget (bytes) of resident frames, zero is unbounded.
+    /// Takes effect upon load, must be unloaded (false if loaded).
+    bool set_budget(size_t budget) NOEXCEPT;
+
+    /// Set the extent (bytes) pinned at each accessed position, which must
+    /// not be exceeded by an element (minimum and default is one frame).
+    /// Must be unloaded (false if loaded).
+    bool set_extent(size_t extent) NOEXCEPT;
+
+    /// Reduce logical size to specified (false if size exceeds logical).
+    bool truncate(size_t size) NOEXCEPT override;
+
+    /// Allocate bytes and return offset to first allocated (or eof).
+    size_t allocate(size_t chunk) NOEXCEPT override;
+
+    /// Get pinned r/w access to start/offset of memory (or null).
+    memory_ptr get(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get pinned r/w access to start/offset of memory for write (or null).
+    memory_ptr get_write(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get pinned exclusive r/w access to start/offset of memory (or null).
+    memory_ptr get_exclusive(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get unprotected r/w access to start/offset of memory (or null).
+    /// Unprotected access cannot be pinned, null unless budget is unbounded.
+    memory::iterator get_raw(size_t offset=zero) const NOEXCEPT override;
+
+    /// Get the fault condition.
+    code get_fault() const NOEXCEPT override;
+
+    /// Get the space required to clear the disk full condition.
+    size_t get_space() const NOEXCEPT override;
+
+protected:
+    size_t to_capacity(size_t required) const NOEXCEPT;
+    void set_first_code(const error::error_t& ec) const NOEXCEPT;
+    void set_disk_space(size_t required) NOEXCEPT;
+
+private:
+    using path = std::filesystem::path;
+
+    // Accessor that pins the frames of its resolved windows until destruct.
+    template <typename Lock>
+    class pinned;
+
+    using access = pinned<std::shared_lock<sharded_mutex>>;
+    using exclusive = pinned<std::unique_lock<sharded_mutex>>;
+    using allocator = recycler<access>;
+
+    struct slot
+    {
+        size_t pins;
+        size_t writers;
+        bool resident;
+        bool dirty;
+        bool referenced;
+    };
+
+    // Access, thread safe.
+    memory_ptr get_(size_t offset, bool write) const NOEXCEPT;
+
+    // Pinning, thread safe, requires remap_mutex_ (shared) for duration.
+    bool pin_(size_t first, size_t& last, bool write) const NOEXCEPT;
+    void unpin_(size_t first, size_t last, bool write) const NOEXCEPT;
+    bool unbounded_() const NOEXCEPT;
+
+    // Frame utilities, require frame_mutex_.
+    bool evict_() const NOEXCEPT;
+    bool commit_(size_t first) NOEXCEPT;
+    bool read_frame_(size_t index) const NOEXCEPT;
+    bool write_frame_(size_t index) const NOEXCEPT;
+    bool drop_frame_(size_t index) const NOEXCEPT;
+    bool write_back_() const NOEXCEPT;
+
+    // Reservation utilities, not thread safe.
+    bool reserve_(size_t size) NOEXCEPT;
+    bool release_() NOEXCEPT;
+    bool resize_(size_t size) NOEXCEPT;
+    bool remap_(size_t size) NOEXCEPT;
+    bool grow_(size_t size) NOEXCEPT;
+    bool fallocate_(size_t size) NOEXCEPT;
+    bool advise_() NOEXCEPT;
+
+    // Constants.
+    const std::filesystem::path filename_;
+    const size_t minimum_;
+    const size_t expansion_;
+    const size_t reserve_size_;
+    const advice advice_;
+    const bool preallocate_;
+
+    // Protected by remap_mutex.
+    // requires remap_mutex_ exclusive lock for write.
+    // requires remap_mutex_ minimum shared lock for read.
+    std::atomic<uint8_t*> memory_{};
+    std::atomic<size_t> reserved_{};
+    mutable sharded_mutex remap_mutex_{};
+
+    // Protected by field_mutex.
+    // fields require field_mutex_ exclusive lock for write.
+    // fields require minimum field_mutex_ shared lock for read.
+    // capacity_ also requires frame_mutex_ for write (readable under either).
+    int opened_{ file::invalid };
+    bool loaded_{};
+    size_t limit_;
+    size_t extent_{ frame };
+    size_t capacity_{};
+    mutable std::shared_mutex field_mutex_{};
+
+    // Protected by frame_mutex.
+    mutable std::vector<slot> frames_{};
+    mutable size_t hand_{};
+    mutable size_t resident_{};
+    mutable size_t dirty_{};
+    mutable std::mutex frame_mutex_{};
+
+    // Requires field_mutex_ exclusive lock for write, atomic for lock-free read.
+    std::atomic<size_t> logical_{};
+    std::atomic<size_t> flushed_{};
+
+    // These are thread safe (fault may be set while pinning).
+    std::atomic<size_t> space_{ zero };
+    mutable std::atomic_bool fault_{};
+    mutable std::atomic<error::error_t> error_{ error::success };
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
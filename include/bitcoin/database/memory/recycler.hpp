@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_RECYCLER_HPP
+#define LIBBITCOIN_DATABASE_MEMORY_RECYCLER_HPP
+
+#include <algorithm>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Allocator that recycles single-object blocks through a thread-local free
+/// list, for use with std::allocate_shared on hot paths (e.g. memory_ptr).
+/// Once warm, allocation and deallocation do not reach the heap. A block freed
+/// on another thread joins that thread's list. Each list is bounded by Limit
+/// blocks, beyond which blocks are returned to the heap. All instances are
+/// interchangeable (stateless).
+template <typename Type, size_t Limit = 1024>
+class recycler
+{
+public:
+    using value_type = Type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = recycler<Other, Limit>;
+    };
+
+    constexpr recycler() NOEXCEPT = default;
+
+    template <typename Other>
+    constexpr recycler(const recycler<Other, Limit>&) NOEXCEPT
+    {
+    }
+
+    /// Allocate storage for count objects (throws std::bad_alloc).
+    inline Type* allocate(size_t count) THROWS;
+
+    /// Deallocate storage obtained from allocate(count).
+    inline void deallocate(Type* ptr, size_t count) NOEXCEPT;
+
+    /// The number of blocks cached by the calling thread.
+    static inline size_t cached() NOEXCEPT;
+
+    template <typename Other>
+    constexpr bool operator==(const recycler<Other, Limit>&) const NOEXCEPT
+    {
+        return true;
+    }
+
+private:
+    struct node
+    {
+        node* next;
+    };
+
+    struct pool
+    {
+        DELETE_COPY_MOVE(pool);
+        pool() NOEXCEPT = default;
+        inline ~pool() NOEXCEPT;
+
+        node* top{};
+        size_t count{};
+    };
+
+    static constexpr auto align = std::max(alignof(Type), alignof(node));
+    static constexpr auto block = std::max(sizeof(Type), sizeof(node));
+
+    static inline pool& local() NOEXCEPT;
+    static inline void* allocate_block() THROWS;
+    static inline void deallocate_block(void* ptr) NOEXCEPT;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <typename Type, size_t Limit>
+#define CLASS recycler<Type, Limit>
+
+#include <bitcoin/database/impl/memory/recycler.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
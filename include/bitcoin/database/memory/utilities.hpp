@@ -19,6 +19,9 @@
 #ifndef LIBBITCOIN_DATABASE_MEMORY_UTILITIES_HPP
 #define LIBBITCOIN_DATABASE_MEMORY_UTILITIES_HPP
 
+#if defined(HAVE_MSC)
+    #include <intrin.h>
+#endif
 #include <bitcoin/database/define.hpp>
 
 namespace libbitcoin {
@@ -30,6 +33,16 @@ BCD_API size_t page_size() NOEXCEPT;
 /// The bytes of physical memory, zero if failed.
 BCD_API uint64_t system_memory() NOEXCEPT;
 
+/// Hint that memory at address will soon be read (does not fault).
+inline void prefetch(const void* address) NOEXCEPT
+{
+#if defined(HAVE_MSC) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif !defined(HAVE_MSC)
+    __builtin_prefetch(address);
+#endif
+}
+
 } // namespace database
 } // namespace libbitcoin
 
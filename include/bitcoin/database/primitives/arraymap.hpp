@@ -19,12 +19,16 @@
 #ifndef LIBBITCOIN_DATABASE_PRIMITIVES_ARRAY_HPP
 #define LIBBITCOIN_DATABASE_PRIMITIVES_ARRAY_HPP
 
+#include <functional>
+#include <span>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
 #include <bitcoin/database/primitives/head.hpp>
 #include <bitcoin/database/primitives/linkage.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/view.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -39,6 +43,11 @@ public:
 
     using link = Link;
 
+    /// Scan visitor of each element, return false to stop the scan.
+    template <typename Element>
+    using visitor = std::function<bool(const Link& link,
+        const Element& element)>;
+
     arraymap(storage& header, storage& body) NOEXCEPT;
 
     /// Setup, not thread safe.
@@ -80,6 +89,20 @@ public:
     /// Resume from disk full condition.
     code reload() NOEXCEPT;
 
+    /// Scan, visitor must be thread safe if threads exceeds one.
+    /// -----------------------------------------------------------------------
+
+    /// Visit each element in body order, error::scan_stopped if stopped by
+    /// the visitor, error::scan_table if an element (or memory) could not be
+    /// read, otherwise success. Ranges of records are visited concurrently on threads, each holding shared remap
+    /// lock for one range, so that writers may remap between ranges. Slabs
+    /// are visited on the calling thread, as each slab is located by the size
+    /// of its predecessor, so Element must read the whole slab. The visitor
+    /// must not read this table (see iterator). Elements are visited up to
+    /// the count at start, which may include elements not yet fully written.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    code scan(const visitor<Element>& visit, size_t threads=one) const NOEXCEPT;
+
     /// Query interface.
     /// -----------------------------------------------------------------------
 
@@ -87,6 +110,13 @@ public:
     template <typename Element, if_equal<Element::size, Size> = true>
     bool get(const Link& link, Element& element) const NOEXCEPT;
 
+    /// Get elements at links, false if any deserialize error. Elements are
+    /// read in groups under one memory guard, prefetching each element of a
+    /// group before reading any.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool get_many(const std::span<const Link>& links,
+        std_vector<Element>& elements) const NOEXCEPT;
+
     /// Put element.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool put(const Element& element) NOEXCEPT;
@@ -97,11 +127,38 @@ public:
     template <typename Element, if_equal<Element::size, Size> = true>
     Link put_link(const Element& element) NOEXCEPT;
 
+    /// Set element at link, expanding the body to include link (records
+    /// only). Records added by expansion are zero filled, so an element must
+    /// read a zeroed record as not set.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool set(const Link& link, const Element& element) NOEXCEPT;
+
+    /// Set element at each link, expanding the body once to include all
+    /// links, and writing under one memory guard (records only).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool set_many(const std::span<const Link>& links,
+        const Element& element) NOEXCEPT;
+
 private:
     static constexpr auto is_slab = (Size == max_size_t);
-    using head = database::head<Link, system::data_array<zero>, false>;
+    using head = database::head<Link, system::data_array<zero>, unique_hasher>;
     using manager = database::manager<Link, system::data_array<zero>, Size>;
 
+    // Elements prefetched together by get_many.
+    static constexpr size_t group = 16;
+
+    // Records (or slab bytes) visited by scan under one memory guard.
+    static constexpr size_t scan_records = 4096;
+    static constexpr size_t scan_bytes = 1024u * 1024u;
+
+    // Expand body to at least count records (zero filled).
+    bool expand(const Link& count) NOEXCEPT;
+
+    // Get element at link using memory object, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool read(const memory_ptr& ptr, const Link& link,
+        Element& element) NOEXCEPT;
+
     // Unsafe with zero buckets (index/top/push).
     // Not thread safe (create/open/close/backup/restore).
     head head_;
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_FILTER_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_FILTER_HPP
+
+#include <bit>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Persistent blocked bloom filter of keys (approximate membership).
+/// Each key selects one cache line block of the filter file and sets (or
+/// tests) bits only within it, so an add or test touches one block. There
+/// are no false negatives. Adds and tests are lock-free (thread safe), other
+/// methods are not thread safe. The filter is derived from table keys, so it
+/// is not archived and is rebuilt by the table when restored.
+template <typename Key, typename Hash>
+class filter
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(filter);
+
+    /// Filter bytes are rounded down to blocks, zero disables the filter.
+    filter(storage& file, size_t bytes) NOEXCEPT;
+
+    /// The filter has at least one block.
+    bool enabled() const NOEXCEPT;
+
+    /// Create from empty filter file (all keys absent).
+    bool create() NOEXCEPT;
+
+    /// Clear existing filter file to configured size (all keys absent).
+    bool reset() NOEXCEPT;
+
+    /// False if filter file size does not match configured size.
+    bool verify() const NOEXCEPT;
+
+    /// Add key to the filter (nop if disabled).
+    void add(const Key& key) NOEXCEPT;
+
+    /// False if key has not been added (true if disabled).
+    bool contains(const Key& key) const NOEXCEPT;
+
+    /// Hint that the block of key will soon be read (see contains).
+    void prefetch(const Key& key) const NOEXCEPT;
+
+    /// Probability that an absent key is contained, by current block fill
+    /// (one if disabled). Reads the entire filter.
+    double rate() const NOEXCEPT;
+
+private:
+    using word = uint64_t;
+    static constexpr size_t block = 64;
+    static constexpr size_t block_bits = system::to_bits(block);
+    static constexpr size_t word_bits = system::to_bits(sizeof(word));
+    static constexpr size_t words = block / sizeof(word);
+
+    // Bits set per key, each selected by 9 bits of the fingerprint.
+    static constexpr size_t selectors = 6;
+    static constexpr size_t selector_bits = std::bit_width(sub1(block_bits));
+    static_assert(selectors * selector_bits <= system::to_bits(sizeof(word)));
+
+    // Block of the key, and the bits of the key within its block.
+    struct position
+    {
+        size_t block;
+        std_array<word, words> mask;
+    };
+
+    inline position to_position(const Key& key) const NOEXCEPT;
+
+    storage& file_;
+    const size_t blocks_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <typename Key, typename Hash>
+#define CLASS filter<Key, Hash>
+
+#include <bitcoin/database/impl/primitives/filter.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
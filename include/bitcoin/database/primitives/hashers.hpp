@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_HASHERS_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_HASHERS_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Head bucket hash policies, injected through the head template (and table
+/// schema). Each provides hash(key), the reduction of the hash to bucket
+/// index, and whether keys are fingerprinted (see fingerprinted). The
+/// reduction is modulo, or mask where buckets is a power of two (identical
+/// result, so file compatible), unless fastrange is set. Fastrange
+/// (multiply-shift) uses only the high order bits of the hash, so requires a
+/// hash that is uniform over all bits. Changing the policy of a table changes
+/// bucket placement and therefore the head file format.
+
+/// Identity of the low order key bytes (the key is its own hash).
+/// Suitable for cryptographic hash keys and sequential surrogate keys, which
+/// modulo (or mask) distributes perfectly across buckets.
+struct unique_hasher
+{
+    static constexpr bool fastrange = false;
+    static constexpr bool fingerprint = false;
+
+    template <typename Key>
+    static constexpr size_t hash(const Key& key) NOEXCEPT
+    {
+        return system::unique_hash(key);
+    }
+};
+
+/// djb2 over all key bytes, for keys without uniqueness in low order bytes.
+/// djb2 exhibits very poor uniqueness result for sequential keys.
+struct djb2_hasher
+{
+    static constexpr bool fastrange = false;
+    static constexpr bool fingerprint = false;
+
+    template <typename Key>
+    static constexpr size_t hash(const Key& key) NOEXCEPT
+    {
+        return system::djb2_hash(key);
+    }
+};
+
+/// Low order key bytes avalanched by the murmur3 64 bit finalizer, reduced by
+/// fastrange (no division). Distributes any key uniformly, including keys that
+/// vary in high order bits only, at the cost of random bucket occupancy for
+/// sequential keys (which modulo would otherwise place perfectly).
+struct mix_hasher
+{
+    static constexpr bool fastrange = true;
+    static constexpr bool fingerprint = false;
+
+    template <typename Key>
+    static constexpr size_t hash(const Key& key) NOEXCEPT
+    {
+        return possible_narrow_cast<size_t>(mix(system::unique_hash(key)));
+    }
+
+    static constexpr uint64_t mix(uint64_t value) NOEXCEPT
+    {
+        value ^= (value >> 33);
+        value *= 0xff51afd7ed558ccdull;
+        value ^= (value >> 33);
+        value *= 0xc4ceb9fe1a85ec53ull;
+        value ^= (value >> 33);
+        return value;
+    }
+};
+
+/// Adapts a policy to fingerprint keys into the otherwise unused (link
+/// padding) bytes of aligned head slots. Each bucket accumulates a small bloom
+/// filter of the keys in its conflict list, so that most lookups of absent
+/// keys resolve from the head without reading the body. No effect on heads
+/// that are not aligned (or where link size leaves no padding). Changes the
+/// aligned head file format.
+template <typename Hash>
+struct fingerprinted
+  : public Hash
+{
+    static constexpr bool fingerprint = true;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -19,13 +19,22 @@
 #ifndef LIBBITCOIN_DATABASE_PRIMITIVES_HASHMAP_HPP
 #define LIBBITCOIN_DATABASE_PRIMITIVES_HASHMAP_HPP
 
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <span>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/filter.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
 #include <bitcoin/database/primitives/head.hpp>
 #include <bitcoin/database/primitives/iterator.hpp>
 #include <bitcoin/database/primitives/linkage.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/matcher.hpp>
+#include <bitcoin/database/primitives/view.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -35,7 +44,7 @@ namespace database {
 /// Readers and writers are always prepositioned at data, and are limited to
 /// the extent the record/slab size is known (limit can always be removed).
 /// Streams are always initialized from first element byte up to file limit.
-template <typename Link, typename Key, size_t Size, bool Hash>
+template <typename Link, typename Key, size_t Size, typename Hash>
 class hashmap
 {
 public:
@@ -44,8 +53,24 @@ public:
     using key = Key;
     using link = Link;
     using iterator = database::iterator<Link, Key, Size>;
+    using borrowed_iterator = database::iterator<Link, Key, Size, true>;
 
-    hashmap(storage& header, storage& body, const Link& buckets) NOEXCEPT;
+    /// Scan visitor of each element, return false to stop the scan.
+    template <typename Element>
+    using visitor = std::function<bool(const Link& link, const Key& key,
+        const Element& element)>;
+
+    /// Aligned heads are lock-free, and must match the head file format.
+    /// Buckets double when count exceeds load per bucket (zero disables), and
+    /// are then migrated incrementally, each by an explicit maintain().
+    hashmap(storage& header, storage& body, const Link& buckets,
+        bool aligned=false, size_t load=zero) NOEXCEPT;
+
+    /// Key filter of filter_bytes (zero disables) precedes head in key search,
+    /// so that most searches for absent keys read neither head nor body.
+    hashmap(storage& header, storage& body, storage& filter,
+        size_t filter_bytes, const Link& buckets, bool aligned=false,
+        size_t load=zero) NOEXCEPT;
 
     /// Setup, not thread safe.
     /// -----------------------------------------------------------------------
@@ -54,7 +79,7 @@ public:
     bool close() NOEXCEPT;
     bool backup() NOEXCEPT;
     bool restore() NOEXCEPT;
-    bool verify() const NOEXCEPT;
+    bool verify() NOEXCEPT;
 
     /// Sizing.
     /// -----------------------------------------------------------------------
@@ -62,7 +87,7 @@ public:
     /// The instance is enabled (more than 1 bucket).
     bool enabled() const NOEXCEPT;
 
-    /// Hash table bucket count.
+    /// Hash table bucket count (includes unmigrated prior buckets).
     size_t buckets() const NOEXCEPT;
 
     /// Head file bytes.
@@ -74,6 +99,10 @@ public:
     /// Count of records (or body file bytes if slab).
     Link count() const NOEXCEPT;
 
+    /// Estimated rate of absent keys not excluded by filter (one if none).
+    /// Reads the entire filter.
+    double filter_rate() const NOEXCEPT;
+
     /// Errors.
     /// -----------------------------------------------------------------------
 
@@ -86,6 +115,39 @@ public:
     /// Resume from disk full condition.
     code reload() NOEXCEPT;
 
+    /// Growth, blocks all access to the table while executing (as remap).
+    /// Must not be called while holding memory or iterator of the table.
+    /// Growth and migration wait for completion of any scan of the table.
+    /// -----------------------------------------------------------------------
+
+    /// True if prior buckets remain to be migrated.
+    bool is_migrating() const NOEXCEPT;
+
+    /// Double buckets and begin migration (false if migrating or failed).
+    bool grow() NOEXCEPT;
+
+    /// Migrate up to count prior buckets into current (false if failed).
+    bool rehash(size_t count) NOEXCEPT;
+
+    /// Migrate a bounded number of prior buckets if migrating, otherwise grow
+    /// if count exceeds load (false if failed). Not invoked by writes, caller
+    /// must preclude concurrent writes to the table (see store::maintain).
+    /// Deferred (true) while the table is being scanned.
+    bool maintain() NOEXCEPT;
+
+    /// Scan, visitor must be thread safe if threads exceeds one.
+    /// -----------------------------------------------------------------------
+
+    /// Visit each element, in order of bucket then list, error::scan_stopped
+    /// if stopped by the visitor, error::scan_table if an element (or memory)
+    /// could not be read, otherwise success. Ranges of buckets are visited concurrently on threads, each
+    /// holding shared remap lock for one range, so that writers may remap
+    /// between ranges. The visitor must not read this table (see iterator).
+    /// Elements committed during the scan may not be visited. Growth and
+    /// migration are precluded for the duration of the scan.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    code scan(const visitor<Element>& visit, size_t threads=one) const NOEXCEPT;
+
     /// Query interface, iterator is not thread safe.
     /// -----------------------------------------------------------------------
 
@@ -101,12 +163,26 @@ public:
     /// Iterator holds shared lock on storage remap.
     iterator it(const Key& key) const NOEXCEPT;
 
+    /// Iterator references a guard of this table (not copyable or movable),
+    /// so any number of iterations under one guard allocate and lock nothing.
+    borrowed_iterator it(const guard& memory, const Key& key) const NOEXCEPT;
+    borrowed_iterator it(const guard&& memory, const Key& key) const = delete;
+
+    /// Return first element link of each key (terminal if not found/error).
+    /// Keys are searched in groups under one memory guard, prefetching the
+    /// filter, bucket and first element of each key in a group before reading
+    /// any, so that the memory latency of the keys in a group is overlapped.
+    std_vector<Link> first_many(const std::span<const Key>& keys) const NOEXCEPT;
+
     /// Allocate element at returned link (follow with set|put).
     Link allocate(const Link& size) NOEXCEPT;
 
     /// Return ptr for batch processing, holds shared lock on storage remap.
     memory_ptr get_memory() const NOEXCEPT;
 
+    /// Return guard for borrowed iteration, holds shared lock on storage remap.
+    guard get_guard() const NOEXCEPT;
+
     /// Return the associated search key (terminal link returns default).
     Key get_key(const Link& link) NOEXCEPT;
 
@@ -114,6 +190,12 @@ public:
     template <typename Element, if_equal<Element::size, Size> = true>
     bool find(const Key& key, Element& element) const NOEXCEPT;
 
+    /// Get first element matching each search key (see first_many), false
+    /// if any is not found/error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool find_many(const std::span<const Key>& keys,
+        std_vector<Element>& elements) const NOEXCEPT;
+
     /// Get element at link, false if deserialize error.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool get(const Link& link, Element& element) const NOEXCEPT;
@@ -133,6 +215,17 @@ public:
     static bool get(const memory_ptr& ptr, const Link& link,
         Element& element) NOEXCEPT;
 
+    /// Get element at link using borrowed iterator or guard memory object,
+    /// false if deserialize error. Borrowed iterator must not be terminal.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool get(const borrowed_iterator& it, Element& element) NOEXCEPT;
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool get(const borrowed_iterator& it, const Link& link,
+        Element& element) NOEXCEPT;
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool get(const guard& memory, const Link& link,
+        Element& element) NOEXCEPT;
+
     /// Set element into previously allocated link (follow with commit).
     template <typename Element, if_equal<Element::size, Size> = true>
     bool set(const Link& link, const Element& element) NOEXCEPT;
@@ -149,6 +242,18 @@ public:
     template <typename Element, if_equal<Element::size, Size> = true>
     bool put_link(Link& link, const Key& key, const Element& element) NOEXCEPT;
 
+    /// Allocate, set, commit each element to its key, and return links in
+    /// key order (records only). Elements are allocated together and placed
+    /// in bucket order, so that elements of a bucket are adjacent and the body
+    /// and head are each written in one ascending pass (for bulk loading).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put_many(const std::span<const Key>& keys,
+        const std::span<const Element>& elements,
+        std_vector<Link>& links) NOEXCEPT;
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put_many(const std::span<const Key>& keys,
+        const std::span<const Element>& elements) NOEXCEPT;
+
     /// Allocate, set, commit element to key.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool put(const Key& key, const Element& element) NOEXCEPT;
@@ -175,8 +280,34 @@ private:
     static constexpr auto is_slab = (Size == max_size_t);
     static constexpr auto index_size = Link::size + array_count<Key>;
 
+    // Each maintenance step migrates a bounded number of prior buckets.
+    static constexpr size_t rehash_buckets = 4096;
+
+    // Buckets visited by scan under one memory guard.
+    static constexpr size_t scan_buckets = 4096;
+
+    // Keys searched together by first_many, each stage prefetching for all
+    // keys in the group what the next stage reads.
+    static constexpr size_t group = 16;
+
+    // Top of key, terminal if excluded by filter.
+    Link filtered_top(const Key& key) const NOEXCEPT;
+
+    // Links of keys, from whole table memory.
+    std_vector<Link> first_many(const memory_ptr& ptr,
+        const std::span<const Key>& keys) const NOEXCEPT;
+
+    // Reset filter and add all keys, not thread safe.
+    bool rebuild() NOEXCEPT;
+
+    // Growth and migration, caller must hold scan_mutex_ exclusive.
+    bool grow_() NOEXCEPT;
+    bool rehash_(size_t count) NOEXCEPT;
+
     using head = database::head<Link, Key, Hash>;
     using manager = database::manager<Link, Key, Size>;
+    using match = matcher<Link, Key>;
+    using key_filter = database::filter<Key, Hash>;
 
     // Thread safe (index/top/push).
     // Not thread safe (create/open/close/backup/restore).
@@ -184,16 +315,23 @@ private:
 
     // Thread safe.
     manager manager_;
+
+    // Thread safe.
+    const size_t load_;
+    std::optional<key_filter> filter_{};
+
+    // Scans hold shared, growth and migration hold exclusive.
+    mutable std::shared_mutex scan_mutex_{};
 };
 
 template <typename Element>
 using hash_map = hashmap<linkage<Element::pk>, system::data_array<Element::sk>,
-    Element::size, Element::hash_function>;
+    Element::size, typename Element::hash_function>;
 
 } // namespace database
 } // namespace libbitcoin
 
-#define TEMPLATE template <typename Link, typename Key, size_t Size, bool Hash>
+#define TEMPLATE template <typename Link, typename Key, size_t Size, typename Hash>
 #define CLASS hashmap<Link, Key, Size, Hash>
 
 #include <bitcoin/database/impl/primitives/hashmap.ipp>
@@ -20,15 +20,24 @@
 #define LIBBITCOIN_DATABASE_PRIMITIVES_HEAD_HPP
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <shared_mutex>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
 
 namespace libbitcoin {
 namespace database {
 
-template <typename Link, typename Key, bool Hash>
+/// Hash is a bucket hash policy (see hashers.hpp).
+/// The head may grow (double its buckets). The new region is appended to the
+/// head file and the prior region is migrated incrementally, with keys of
+/// prior buckets below the migration cursor indexed into the new region. A
+/// grown head file ends with a trailer that records the regions and cursor.
+/// Growth requires exclusive access to head and conflict lists (see hashmap).
+template <typename Link, typename Key, typename Hash>
 class head
 {
 public:
@@ -37,15 +46,23 @@ public:
     using bytes = typename Link::bytes;
 
     /// An array head has zero buckets (and cannot call index()).
-    head(storage& head, const Link& buckets) NOEXCEPT;
+    /// Aligned buckets occupy 8 byte slots and are read and pushed lock-free
+    /// (atomic load and compare-exchange), otherwise buckets occupy link size
+    /// slots and are guarded by one mutex. The head file format differs, so
+    /// this must match the head file (verify fails otherwise).
+    head(storage& head, const Link& buckets, bool aligned=false) NOEXCEPT;
 
     /// Sizing (thread safe).
+    /// Buckets includes prior buckets while migrating (as list indexes).
     size_t size() const NOEXCEPT;
     size_t buckets() const NOEXCEPT;
 
     /// Create from empty head file (not thread safe).
     bool create() NOEXCEPT;
 
+    /// Read layout from head file (as grown) and verify (not thread safe).
+    bool open() NOEXCEPT;
+
     /// False if head file size incorrect (not thread safe).
     bool verify() const NOEXCEPT;
 
@@ -53,35 +70,130 @@ public:
     bool get_body_count(Link& count) const NOEXCEPT;
     bool set_body_count(const Link& count) NOEXCEPT;
 
-    /// Convert natural key to head bucket index.
+    /// Convert natural key to head bucket index (hash reduced by fastrange if
+    /// the policy specifies, otherwise by mask if buckets is a power of two,
+    /// otherwise by modulo). Unmigrated prior buckets follow current buckets.
     Link index(const Key& key) const NOEXCEPT;
 
     /// Unsafe if verify false.
+    /// Top of key is terminal if excluded by bucket fingerprints (if any).
+    /// Push of index (without key) disables the bucket fingerprint filter.
     Link top(const Key& key) const NOEXCEPT;
     Link top(const Link& index) const NOEXCEPT;
     bool push(const bytes& current, bytes& next, const Key& key) NOEXCEPT;
+    bool push(const bytes& current, bytes& next, const Key& key,
+        const Link& index) NOEXCEPT;
     bool push(const bytes& current, bytes& next, const Link& index) NOEXCEPT;
 
+    /// Hint that the bucket of key will soon be read (see top).
+    void prefetch(const Key& key) const NOEXCEPT;
+
+    /// Growth (requires exclusive access to head and lists).
+    /// -----------------------------------------------------------------------
+
+    /// True if prior buckets remain to be migrated (thread safe).
+    bool is_migrating() const NOEXCEPT;
+
+    /// Append region of twice the buckets and begin migration to it.
+    bool grow() NOEXCEPT;
+
+    /// Index of the prior bucket at the migration cursor (or terminal).
+    Link cursor() const NOEXCEPT;
+
+    /// Index of key in the current region (destination of migration).
+    Link rehash(const Key& key) const NOEXCEPT;
+
+    /// Terminate prior bucket at cursor and advance (complete at end).
+    bool advance() NOEXCEPT;
+
 private:
+    using slot = uint64_t;
+    using slot_bytes = std_array<uint8_t, sizeof(slot)>;
+    static_assert(Link::size <= sizeof(slot));
+
+    // Fingerprint filter bits occupy the aligned slot bytes following link.
+    static constexpr size_t filter_bits = system::to_bits(sizeof(slot) -
+        Link::size);
+    static constexpr bool filtered = Hash::fingerprint &&
+        is_nonzero(filter_bits);
+
+    // Trailer of grown head: prior offset/buckets, offset/buckets, cursor.
+    static constexpr size_t trailer_fields = 5;
+    static constexpr size_t trailer = trailer_fields * sizeof(uint64_t);
+
     template <size_t Bytes>
     static auto& array_cast(memory::iterator buffer) NOEXCEPT
     {
         return system::unsafe_array_cast<uint8_t, Bytes>(buffer);
     }
 
-    static constexpr size_t offset(const Link& index) NOEXCEPT
+    static constexpr size_t to_mask(size_t buckets) NOEXCEPT
+    {
+        // Zero (modulo) if not a power of two, or if one bucket (all zero).
+        return std::has_single_bit(buckets) ? sub1(buckets) : zero;
+    }
+
+    static constexpr size_t fastrange(size_t value, size_t buckets) NOEXCEPT
     {
         using namespace system;
-        BC_ASSERT(!is_multiply_overflow<size_t>(index, Link::size));
-        BC_ASSERT(!is_add_overflow(Link::size, index * Link::size));
+        constexpr auto width = to_bits(sizeof(uint32_t));
+        constexpr auto shift = to_bits(sizeof(size_t)) - width;
+        BC_ASSERT(buckets <= add1<uint64_t>(max_uint32));
+
+        // Multiply-shift of the high order 32 hash bits into [0, buckets).
+        const auto high = possible_narrow_cast<uint32_t>(value >> shift);
+        return possible_narrow_cast<size_t>((uint64_t{ high } * buckets) >>
+            width);
+    }
 
-        // Byte offset of bucket index within head file.
-        // [body_size][[bucket[0]...bucket[buckets-1]]]
-        return possible_narrow_cast<size_t>(Link::size + index * Link::size);
+    static constexpr size_t reduce(size_t value, size_t buckets,
+        size_t mask) NOEXCEPT
+    {
+        if constexpr (Hash::fastrange)
+        {
+            return fastrange(value, buckets);
+        }
+        else
+        {
+            // Mask is identical to modulo for power of two, avoids division.
+            return is_zero(mask) ? value % buckets : value & mask;
+        }
     }
 
+    // Link is the leading bytes of the slot, trailing bytes are ignored.
+    static inline Link to_link(slot value) NOEXCEPT;
+    static inline slot to_slot(const bytes& link) NOEXCEPT;
+
+    // Filter bits of the slot, and the two filter bits selected by key.
+    static constexpr slot filter_mask() NOEXCEPT;
+    static constexpr slot to_filter(const Key& key) NOEXCEPT;
+
+    Link top(const Link& index, slot filter) const NOEXCEPT;
+    bool push(const bytes& current, bytes& next, const Link& index,
+        slot filter) NOEXCEPT;
+
+    // Byte offset of bucket index (current or prior) within head file.
+    inline size_t position(const Link& index) const NOEXCEPT;
+
+    // A grown head has no region immediately following the body count.
+    inline bool is_grown() const NOEXCEPT;
+    bool set_trailer() NOEXCEPT;
+
     storage& file_;
-    const Link buckets_;
+    const Link initial_;
+    const bool aligned_;
+    const size_t slot_;
+
+    // Layout is changed only with exclusive access (or not thread safe).
+    // [body_size][[bucket[0]...bucket[buckets-1]]][...][trailer]
+    std::atomic<size_t> offset_;
+    std::atomic<size_t> buckets_;
+    std::atomic<size_t> mask_;
+    std::atomic<size_t> prior_offset_{};
+    std::atomic<size_t> prior_buckets_{};
+    std::atomic<size_t> prior_mask_{};
+    std::atomic<size_t> cursor_{};
+
     mutable std::shared_mutex mutex_{};
 };
 
@@ -89,7 +201,7 @@ private:
 } // namespace libbitcoin
 
 
-#define TEMPLATE template <typename Link, typename Key, bool Hash>
+#define TEMPLATE template <typename Link, typename Key, typename Hash>
 #define CLASS head<Link, Key, Hash>
 
 #include <bitcoin/database/impl/primitives/head.ipp>
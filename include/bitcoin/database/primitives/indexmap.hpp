@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_INDEXMAP_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_INDEXMAP_HPP
+
+#include <atomic>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/linkage.hpp>
+#include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/view.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Direct-indexed alternative to hashmap, for tables searchable by a dense
+/// surrogate key (such as header link). The key is the little endian index of
+/// its head slot, so a search reads one slot and no conflict list. The head
+/// grows (terminal filled) only by an explicit reserve(), presized from the
+/// count of keys (such as headers), so writes never grow it. Elements are
+/// [next][key][data] as in hashmap, where next is the prior element of the
+/// same key, so the most recent is found and prior elements are retained.
+/// Aligned slots are read and pushed lock-free, otherwise slots occupy link
+/// size and are guarded by one mutex (as head). The head file format differs,
+/// so this must match the head file (verify fails otherwise). The slot that
+/// follows the body count is a marker, so that a hashmap head file (of the
+/// same size) is not verified as an indexmap head.
+template <typename Link, typename Key, size_t Size>
+class indexmap
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(indexmap);
+
+    using key = Key;
+    using link = Link;
+
+    /// Slots is the initial head size, more than one enables the instance.
+    indexmap(storage& header, storage& body, const Link& slots,
+        bool aligned=false) NOEXCEPT;
+
+    /// Setup, not thread safe.
+    /// -----------------------------------------------------------------------
+
+    bool create() NOEXCEPT;
+    bool close() NOEXCEPT;
+    bool backup() NOEXCEPT;
+    bool restore() NOEXCEPT;
+    bool verify() NOEXCEPT;
+
+    /// Sizing.
+    /// -----------------------------------------------------------------------
+
+    /// The instance is enabled (more than 1 initial slot).
+    bool enabled() const NOEXCEPT;
+
+    /// Head slot count (as hashmap buckets).
+    size_t buckets() const NOEXCEPT;
+
+    /// Head file bytes.
+    size_t head_size() const NOEXCEPT;
+
+    /// Body file bytes.
+    size_t body_size() const NOEXCEPT;
+
+    /// Count of records (or body file bytes if slab).
+    Link count() const NOEXCEPT;
+
+    /// Growth.
+    /// -----------------------------------------------------------------------
+
+    /// Grow head (doubling) to include the slots of keys below count (false
+    /// if failed). Not invoked by writes, which fail for keys beyond the head.
+    /// Requires that caller holds no memory of the table, as growth excludes
+    /// all access (see store::maintain).
+    bool reserve(size_t count) NOEXCEPT;
+
+    /// Errors.
+    /// -----------------------------------------------------------------------
+
+    /// Get the fault condition.
+    code get_fault() const NOEXCEPT;
+
+    /// Get the space required to clear the disk full condition.
+    size_t get_space() const NOEXCEPT;
+
+    /// Resume from disk full condition.
+    code reload() NOEXCEPT;
+
+    /// Query interface.
+    /// -----------------------------------------------------------------------
+
+    /// Return the link in the slot of the index (for table scanning).
+    Link top(const Link& index) const NOEXCEPT;
+
+    /// True if an instance of object with key exists.
+    bool exists(const Key& key) const NOEXCEPT;
+
+    /// Return most recent element link or terimnal if not found/error.
+    Link first(const Key& key) const NOEXCEPT;
+
+    /// Allocate element at returned link (follow with set|put).
+    Link allocate(const Link& size) NOEXCEPT;
+
+    /// Return ptr for batch processing, holds shared lock on storage remap.
+    memory_ptr get_memory() const NOEXCEPT;
+
+    /// Return the associated search key (terminal link returns default).
+    Key get_key(const Link& link) NOEXCEPT;
+
+    /// Get most recent element matching the search key, false if not found.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool find(const Key& key, Element& element) const NOEXCEPT;
+
+    /// Get element at link, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool get(const Link& link, Element& element) const NOEXCEPT;
+
+    /// Get element at link using memory object, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool get(const memory_ptr& ptr, const Link& link,
+        Element& element) NOEXCEPT;
+
+    /// Set element into previously allocated link (follow with commit).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool set(const Link& link, const Element& element) NOEXCEPT;
+
+    /// Allocate and set element, and return link (follow with commit).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    Link set_link(const Element& element) NOEXCEPT;
+
+    /// Allocate, set, commit element to key, and return link.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    Link put_link(const Key& key, const Element& element) NOEXCEPT;
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put_link(Link& link, const Key& key, const Element& element) NOEXCEPT;
+
+    /// Allocate, set, commit element to key.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put(const Key& key, const Element& element) NOEXCEPT;
+
+    /// Set and commit previously allocated element at link to key.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put(const Link& link, const Key& key, const Element& element) NOEXCEPT;
+
+    /// Commit previously set element at link to key.
+    bool commit(const Link& link, const Key& key) NOEXCEPT;
+    Link commit_link(const Link& link, const Key& key) NOEXCEPT;
+
+protected:
+    /// Get element at link using memory object, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool read(const memory_ptr& ptr, const Link& link,
+        Element& element) NOEXCEPT;
+
+private:
+    using slot = uint64_t;
+    using slot_bytes = std_array<uint8_t, sizeof(slot)>;
+    using bytes = typename Link::bytes;
+    using key_link = linkage<array_count<Key>>;
+    using manager = database::manager<Link, Key, Size>;
+    static_assert(Link::size <= sizeof(slot));
+
+    static constexpr auto is_slab = (Size == max_size_t);
+    static constexpr auto index_size = Link::size + array_count<Key>;
+
+    template <size_t Bytes>
+    static auto& array_cast(memory::iterator buffer) NOEXCEPT
+    {
+        return system::unsafe_array_cast<uint8_t, Bytes>(buffer);
+    }
+
+    // The greatest non-terminal link, which no table of a head can reach.
+    static constexpr auto marker = sub1(Link::terminal);
+
+    // Link is the leading bytes of the slot, trailing bytes are terminal.
+    static inline Link to_link(slot value) NOEXCEPT;
+    static inline slot to_slot(const bytes& link) NOEXCEPT;
+
+    // Slot index of the key, terminal key has no slot.
+    static inline size_t to_index(const Key& key) NOEXCEPT;
+
+    // Byte offset of slot index within head file.
+    inline size_t position(size_t index) const NOEXCEPT;
+
+    // Slot access requires that caller holds body memory (precludes growth).
+    Link slot_link(size_t index) const NOEXCEPT;
+    bool push(const bytes& current, bytes& next, size_t index) NOEXCEPT;
+
+    // Most recent element link of key, from whole table memory.
+    Link first(const memory_ptr& ptr, const Key& key) const NOEXCEPT;
+
+    // Set slot layout from head file size, false if not marked.
+    bool open() NOEXCEPT;
+    bool is_marked() const NOEXCEPT;
+    bool set_marker() NOEXCEPT;
+    bool get_body_count(Link& count) const NOEXCEPT;
+    bool set_body_count(const Link& count) NOEXCEPT;
+
+    storage& head_;
+    manager manager_;
+    const size_t initial_;
+    const bool aligned_;
+    const size_t slot_;
+
+    // Changed only with exclusive access to body (or not thread safe).
+    std::atomic<size_t> slots_;
+
+    mutable std::shared_mutex mutex_{};
+};
+
+template <typename Element>
+using index_map = indexmap<linkage<Element::pk>,
+    system::data_array<Element::sk>, Element::size>;
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <typename Link, typename Key, size_t Size>
+#define CLASS indexmap<Link, Key, Size>
+
+#include <bitcoin/database/impl/primitives/indexmap.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
@@ -19,10 +19,13 @@
 #ifndef LIBBITCOIN_DATABASE_PRIMITIVES_ITERATOR_HPP
 #define LIBBITCOIN_DATABASE_PRIMITIVES_ITERATOR_HPP
 
+#include <type_traits>
+#include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/matcher.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -35,18 +38,62 @@ namespace database {
 /// manager.get(), WHICH DESPITE BEING A READ WOULD CAUSE A DEADLOCK. THIS IS
 /// BECAUSE IT CANNOT COMPLETE ITS READ WHILE REMAP IS WAITING ON ACCESS.
 
+/// Caller-held table memory (shared remap lock) for borrowing iterators.
+/// Not copyable or movable, so it cannot leave the scope that obtained it.
+/// While held, reads of the same table must go through the guard (see above),
+/// which allocates and locks nothing further.
+class guard
+{
+public:
+    DELETE_COPY_MOVE(guard);
+    ~guard() = default;
+
+    explicit guard(memory_ptr&& memory) NOEXCEPT
+      : memory_(std::move(memory))
+    {
+    }
+
+    /// Access the underlying memory pointer.
+    inline const memory_ptr& get() const NOEXCEPT
+    {
+        return memory_;
+    }
+
+private:
+    const memory_ptr memory_;
+};
+
 /// This class is not thread safe.
 /// Size non-max implies record manager (ordinal record links).
-template <typename Link, typename Key, size_t Size = max_size_t>
+/// Borrowed implies the iterator references a caller-held guard, which does
+/// not allocate. A borrowed iterator cannot be constructed from a temporary
+/// guard and is neither copyable nor movable, so it is confined to the scope
+/// in which it is declared. As that is within the scope of the guard it
+/// references, it cannot outlive the guard (unless dynamically allocated).
+template <typename Link, typename Key, size_t Size = max_size_t,
+    bool Borrowed = false>
 class iterator
 {
 public:
-    DEFAULT_COPY_MOVE_DESTRUCT(iterator);
+    /// Borrowed iterators cannot be copied or moved out of the guard scope.
+    iterator(iterator&&) NOEXCEPT requires (!Borrowed) = default;
+    iterator(const iterator&) NOEXCEPT requires (!Borrowed) = default;
+    iterator(iterator&&) requires (Borrowed) = delete;
+    iterator(const iterator&) requires (Borrowed) = delete;
+    iterator& operator=(iterator&&) = delete;
+    iterator& operator=(const iterator&) = delete;
+    ~iterator() = default;
 
     /// This advances to first match (or terminal).
     /// Key must be passed as an l-value as it is held by reference.
     iterator(const memory_ptr& data, const Link& start,
-        const Key& key) NOEXCEPT;
+        const Key& key) NOEXCEPT requires (!Borrowed);
+
+    /// This advances to first match (or terminal), references the guard.
+    iterator(const guard& memory, const Link& start,
+        const Key& key) NOEXCEPT requires (Borrowed);
+    iterator(const guard&& memory, const Link& start,
+        const Key& key) = delete;
 
     /// Advance to and return next iterator.
     bool advance() NOEXCEPT;
@@ -67,11 +114,15 @@ protected:
 
 private:
     using manager = database::manager<Link, Key, Size>;
+    using match = matcher<Link, Key>;
 
     // This is not thread safe, but it's object is not modified here and the
     // memory that it refers to is not addressable until written, and writes
     // are guarded by allocator, which is protected by mutex.
-    const memory_ptr memory_;
+    // A borrowed iterator holds the guard by reference, which owns memory.
+    using memory_holder = std::conditional_t<Borrowed, const guard&,
+        const memory_ptr>;
+    memory_holder memory_;
 
     // This is thread safe.
     const Key key_;
@@ -84,8 +135,8 @@ private:
 } // namespace libbitcoin
 
 #define TEMPLATE \
-template <typename Link, typename Key, size_t Size>
-#define CLASS iterator<Link, Key, Size>
+template <typename Link, typename Key, size_t Size, bool Borrowed>
+#define CLASS iterator<Link, Key, Size, Borrowed>
 
 #include <bitcoin/database/impl/primitives/iterator.ipp>
 
@@ -63,6 +63,13 @@ public:
     /// Return memory object for full memory map (null only if oom or unloaded).
     memory_ptr get() const NOEXCEPT;
 
+    /// As get(link) and get(), but the memory is to be written.
+    memory_ptr get_write(const Link& link) const NOEXCEPT;
+    memory_ptr get_write() const NOEXCEPT;
+
+    /// Return exclusive memory object for full memory map (blocks all others).
+    memory_ptr get_exclusive() const NOEXCEPT;
+
     /// Get the fault condition.
     code get_fault() const NOEXCEPT;
 
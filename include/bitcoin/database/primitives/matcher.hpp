@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_MATCHER_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_MATCHER_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Chain walk of hash table elements ([link][key]...), specialized at compile
+/// time on key and link size. Keys of 32 bytes are compared with one vector
+/// instruction where available (AVX2, otherwise two with SSE2), keys of up to
+/// eight bytes as one integer, with a scalar fallback. Where the element is
+/// at least eight bytes, its next link is read with one unaligned load and a
+/// mask. Callers must ensure the element is within memory (offset not null).
+template <typename Link, typename Key>
+struct matcher
+{
+    static constexpr size_t key_size = array_count<Key>;
+
+    /// Next link of the element.
+    static inline Link next(const uint8_t* element) NOEXCEPT;
+
+    /// True if key is equal to the key of the element.
+    static inline bool is_match(const Key& key,
+        const uint8_t* element) NOEXCEPT;
+
+    /// True if the key bytes are equal.
+    static inline bool is_equal(const uint8_t* left,
+        const uint8_t* right) NOEXCEPT;
+
+private:
+    static constexpr bool wide = Link::size + key_size >= sizeof(uint64_t);
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <typename Link, typename Key>
+#define CLASS matcher<Link, Key>
+
+#include <bitcoin/database/impl/primitives/matcher.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
@@ -20,10 +20,16 @@
 #define LIBBITCOIN_DATABASE_PRIMITIVES_PRIMITIVES_HPP
 
 #include <bitcoin/database/primitives/arraymap.hpp>
+#include <bitcoin/database/primitives/filter.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
 #include <bitcoin/database/primitives/hashmap.hpp>
 #include <bitcoin/database/primitives/head.hpp>
+#include <bitcoin/database/primitives/indexmap.hpp>
 #include <bitcoin/database/primitives/iterator.hpp>
 #include <bitcoin/database/primitives/linkage.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/matcher.hpp>
+#include <bitcoin/database/primitives/probemap.hpp>
+#include <bitcoin/database/primitives/view.hpp>
 
 #endif
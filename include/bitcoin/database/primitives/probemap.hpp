@@ -0,0 +1,242 @@
+/**
+/// Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+/// This file is part of libbitcoin.
+ *
+/// This program is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU Affero General Public License as published by
+/// the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+ *
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU Affero General Public License for more details.
+ *
+/// You should have received a copy of the GNU Affero General Public License
+/// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_PROBEMAP_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_PROBEMAP_HPP
+
+#include <atomic>
+#include <bit>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/hashers.hpp>
+#include <bitcoin/database/primitives/linkage.hpp>
+#include <bitcoin/database/primitives/manager.hpp>
+#include <bitcoin/database/primitives/view.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Open addressing alternative to hashmap, for fixed size records.
+/// The head is an array of aligned 8 byte slots (a power of two), each an
+/// element link followed by a tag of its key hash (in the link padding). Keys
+/// are linearly probed from their hashed slot to the first empty slot, and
+/// the body is read only for slots of matching tag, so that a search reads
+/// typically one head line and one body element (with no next link). The body
+/// is an array of [key][record] elements, so links are stable over growth.
+/// Duplicate keys are allowed, and the most recent is found (as hashmap).
+/// Slots are read and claimed lock-free, and double (rehash) by an explicit
+/// maintain() when the count of elements exceeds half of the slots, blocking
+/// all access while rehashing. Writes never grow the head.
+template <typename Link, typename Key, size_t Size, typename Hash>
+class probemap
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(probemap);
+
+    using key = Key;
+    using link = Link;
+
+    /// Slots are rounded up to a power of two (minimum two).
+    probemap(storage& header, storage& body, const Link& slots) NOEXCEPT;
+
+    /// Setup, not thread safe.
+    /// -----------------------------------------------------------------------
+
+    bool create() NOEXCEPT;
+    bool close() NOEXCEPT;
+    bool backup() NOEXCEPT;
+    bool restore() NOEXCEPT;
+    bool verify() NOEXCEPT;
+
+    /// Sizing.
+    /// -----------------------------------------------------------------------
+
+    /// Head slot count.
+    size_t slots() const NOEXCEPT;
+
+    /// Head file bytes.
+    size_t head_size() const NOEXCEPT;
+
+    /// Body file bytes.
+    size_t body_size() const NOEXCEPT;
+
+    /// Count of records.
+    Link count() const NOEXCEPT;
+
+    /// Errors.
+    /// -----------------------------------------------------------------------
+
+    /// Get the fault condition.
+    code get_fault() const NOEXCEPT;
+
+    /// Get the space required to clear the disk full condition.
+    size_t get_space() const NOEXCEPT;
+
+    /// Resume from disk full condition.
+    code reload() NOEXCEPT;
+
+    /// Growth, blocks all access to the table while executing (as remap).
+    /// Must not be called while holding memory of the table.
+    /// -----------------------------------------------------------------------
+
+    /// Double slots and rehash all elements (false if failed). Elements are
+    /// rehashed into new slots before publication, so failure retains head.
+    bool grow() NOEXCEPT;
+
+    /// Grow until count does not exceed half of slots (false if failed). Not
+    /// invoked by writes, caller must preclude concurrent writes to the table
+    /// (see store::maintain), and writes fail once slots are exhausted.
+    bool maintain() NOEXCEPT;
+
+    /// Query interface.
+    /// -----------------------------------------------------------------------
+
+    /// True if an instance of object with key exists.
+    bool exists(const Key& key) const NOEXCEPT;
+
+    /// Return most recent element link or terimnal if not found/error.
+    Link first(const Key& key) const NOEXCEPT;
+
+    /// Allocate element at returned link (follow with set|put).
+    Link allocate(const Link& size) NOEXCEPT;
+
+    /// Return ptr for batch processing, holds shared lock on storage remap.
+    memory_ptr get_memory() const NOEXCEPT;
+
+    /// Return the associated search key (terminal link returns default).
+    Key get_key(const Link& link) NOEXCEPT;
+
+    /// Get most recent element matching the search key, false if not found.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool find(const Key& key, Element& element) const NOEXCEPT;
+
+    /// Get element at link, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool get(const Link& link, Element& element) const NOEXCEPT;
+
+    /// Get element at link using memory object, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool get(const memory_ptr& ptr, const Link& link,
+        Element& element) NOEXCEPT;
+
+    /// Set element into previously allocated link (follow with commit).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool set(const Link& link, const Element& element) NOEXCEPT;
+
+    /// Allocate and set element, and return link (follow with commit).
+    template <typename Element, if_equal<Element::size, Size> = true>
+    Link set_link(const Element& element) NOEXCEPT;
+
+    /// Allocate, set, commit element to key, and return link.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    Link put_link(const Key& key, const Element& element) NOEXCEPT;
+
+    /// Allocate, set, commit element to key.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put(const Key& key, const Element& element) NOEXCEPT;
+
+    /// Set and commit previously allocated element at link to key.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool put(const Link& link, const Key& key, const Element& element) NOEXCEPT;
+
+    /// Commit previously set element at link to key.
+    bool commit(const Link& link, const Key& key) NOEXCEPT;
+    Link commit_link(const Link& link, const Key& key) NOEXCEPT;
+
+protected:
+    /// Get element at link using memory object, false if deserialize error.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    static bool read(const memory_ptr& ptr, const Link& link,
+        Element& element) NOEXCEPT;
+
+private:
+    using slot = uint64_t;
+    using slot_bytes = std_array<uint8_t, sizeof(slot)>;
+    static_assert(Link::size <= sizeof(slot));
+    static_assert(Size != max_size_t, "probemap requires fixed record size");
+
+    // Body element is [key][record], with no next link (an array).
+    static constexpr auto key_size = array_count<Key>;
+    using manager = database::manager<Link, system::data_array<zero>,
+        key_size + Size>;
+
+    // Head is [body_count][slot[0]...slot[slots-1]], in 8 byte slots.
+    static constexpr slot empty = system::bit_all<slot>;
+    static constexpr size_t tag_bits = system::to_bits(sizeof(slot) -
+        Link::size);
+
+    template <size_t Bytes>
+    static auto& array_cast(memory::iterator buffer) NOEXCEPT
+    {
+        return system::unsafe_array_cast<uint8_t, Bytes>(buffer);
+    }
+
+    // Slot of key hash (fastrange or mask, by policy).
+    static constexpr size_t reduce(size_t value, size_t slots) NOEXCEPT;
+
+    // Tag bits of the slot, and the tag of key (within the slot padding).
+    static constexpr slot tag_mask() NOEXCEPT;
+    static constexpr slot to_tag(const Key& key) NOEXCEPT;
+
+    // Link is the leading bytes of the slot, trailing bytes are the tag.
+    static inline Link to_link(slot value) NOEXCEPT;
+    static inline slot to_slot(const typename Link::bytes& link,
+        slot tag) NOEXCEPT;
+    static inline size_t position(size_t index) NOEXCEPT;
+
+    // Match element key at link (from whole table memory).
+    static bool is_match(const memory_ptr& ptr, const Link& link,
+        const Key& key) NOEXCEPT;
+
+    // Most recent element link of key, from whole table memory.
+    Link first(const memory_ptr& ptr, const Key& key) const NOEXCEPT;
+
+    // Claim first empty slot of key for link, requires table memory.
+    bool push(const Link& link, const Key& key) NOEXCEPT;
+
+    // Set slot layout from head file size.
+    bool open() NOEXCEPT;
+    bool get_body_count(Link& count) const NOEXCEPT;
+    bool set_body_count(const Link& count) NOEXCEPT;
+
+    storage& head_;
+    manager manager_;
+    const size_t initial_;
+
+    // Changed only with exclusive access to body (or not thread safe).
+    std::atomic<size_t> slots_;
+};
+
+template <typename Element>
+using probe_map = probemap<linkage<Element::pk>,
+    system::data_array<Element::sk>, Element::size,
+    typename Element::hash_function>;
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <typename Link, typename Key, size_t Size, typename Hash>
+#define CLASS probemap<Link, Key, Size, Hash>
+
+#include <bitcoin/database/impl/primitives/probemap.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_HPP
+
+#include <bit>
+#include <cstring>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Little-endian unsigned integer field of Size bytes at static Offset within
+/// an element. Offsets are from the search key (hashmap) or from the record
+/// (arraymap), so that key fields are also addressable.
+template <size_t Offset, size_t Size>
+struct field
+{
+    using integer = unsigned_type<Size>;
+    static constexpr auto offset = Offset;
+    static constexpr auto size = Size;
+    static constexpr auto end = Offset + Size;
+
+    /// Read the field from element memory (unaligned little-endian load).
+    static inline integer get(const uint8_t* element) NOEXCEPT
+    {
+        const auto data = std::next(element, Offset);
+        integer value{};
+
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            std::memcpy(&value, data, Size);
+        }
+        else
+        {
+            for (size_t byte = 0; byte < Size; ++byte)
+                value |= static_cast<integer>(data[byte]) << to_bits(byte);
+        }
+
+        return value;
+    }
+};
+
+/// A view is a record element read from memory at static field offsets by
+/// from_memory(element) in place of from_data(reader), avoiding the stream.
+template <typename Element>
+constexpr bool is_view = requires(Element& element, const uint8_t* data)
+{
+    element.from_memory(data);
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -148,6 +148,8 @@ public:
     size_t candidate_size() const NOEXCEPT;
     size_t confirmed_size() const NOEXCEPT;
     size_t strong_tx_size() const NOEXCEPT;
+    size_t strong_size() const NOEXCEPT;
+    size_t lineage_size() const NOEXCEPT;
     size_t validated_tx_size() const NOEXCEPT;
     size_t validated_bk_size() const NOEXCEPT;
     size_t address_size() const NOEXCEPT;
@@ -167,6 +169,8 @@ public:
     size_t candidate_body_size() const NOEXCEPT;
     size_t confirmed_body_size() const NOEXCEPT;
     size_t strong_tx_body_size() const NOEXCEPT;
+    size_t strong_body_size() const NOEXCEPT;
+    size_t lineage_body_size() const NOEXCEPT;
     size_t validated_tx_body_size() const NOEXCEPT;
     size_t validated_bk_body_size() const NOEXCEPT;
     size_t address_body_size() const NOEXCEPT;
@@ -186,6 +190,8 @@ public:
     size_t candidate_head_size() const NOEXCEPT;
     size_t confirmed_head_size() const NOEXCEPT;
     size_t strong_tx_head_size() const NOEXCEPT;
+    size_t strong_head_size() const NOEXCEPT;
+    size_t lineage_head_size() const NOEXCEPT;
     size_t validated_tx_head_size() const NOEXCEPT;
     size_t validated_bk_head_size() const NOEXCEPT;
     size_t address_head_size() const NOEXCEPT;
@@ -211,6 +217,8 @@ public:
     size_t candidate_records() const NOEXCEPT;
     size_t confirmed_records() const NOEXCEPT;
     size_t strong_tx_records() const NOEXCEPT;
+    size_t strong_records() const NOEXCEPT;
+    size_t lineage_records() const NOEXCEPT;
     size_t address_records() const NOEXCEPT;
 
     /// Counters (archive slabs - txs/puts/neutrino can be derived).
@@ -538,6 +546,8 @@ protected:
 
     // Critical path
     inline tx_links to_strong_txs(const tx_link& link) const NOEXCEPT;
+    inline tx_links to_strong_txs(const guard& strongs,
+        const tx_link& link) const NOEXCEPT;
     inline tx_links to_strong_txs(const hash_digest& tx_hash) const NOEXCEPT;
     inline strong_pair to_strong(const hash_digest& tx_hash) const NOEXCEPT;
 
@@ -547,6 +557,8 @@ protected:
     inline code to_tx_code(linkage<schema::code>::integer value) const NOEXCEPT;
     inline bool is_sufficient(const context& current,
         const context& evaluated) const NOEXCEPT;
+    inline bool get_lineage(table::lineage::record& out,
+        const header_link& link) const NOEXCEPT;
 
     /// Confirm.
     /// -----------------------------------------------------------------------
@@ -563,6 +575,8 @@ protected:
         const tx_link& self) const NOEXCEPT;
     error::error_t spent_prevout(const foreign_point& point,
         const tx_link& self) const NOEXCEPT;
+    error::error_t spent_prevout(const guard& spends,
+        const foreign_point& point, const tx_link& self) const NOEXCEPT;
     error::error_t unspendable_prevout(const point_link& link,
         uint32_t sequence, uint32_t version,
         const context& ctx) const NOEXCEPT;
@@ -617,6 +631,7 @@ private:
     // These are thread safe.
     Store& store_;
     bool minimize_;
+    bool lineage_;
 };
 
 } // namespace database
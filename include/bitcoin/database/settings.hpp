@@ -22,6 +22,7 @@
 #include <filesystem>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/advice.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -40,50 +41,111 @@ struct BCD_API settings
     std::filesystem::path path;
     bool minimize;
 
+    /// Background body writeback interval in milliseconds (zero disables).
+    uint32_t flush_interval;
+
+    /// Allocate body disk space upon growth, vs. sparse files (Linux only).
+    bool preallocate;
+
+    /// Resident bytes of each body under pool storage (zero is unbounded).
+    uint64_t pool_budget;
+
+    /// Hash table buckets in aligned 8 byte slots with lock-free access, vs.
+    /// link-sized slots under a table mutex. Head format is set upon create.
+    /// Aligned slots also carry key fingerprints for tables that specify.
+    bool aligned_heads;
+
+    /// Hash table buckets double when average conflict list length exceeds
+    /// this value, with lists migrated incrementally (zero disables growth).
+    uint32_t bucket_load;
+
+    /// Copy header chain walk fields (parent, height, version, timestamp and
+    /// bits) to the dense lineage table, read by chain state walks.
+    bool header_lineage;
+
     /// Archives.
     /// -----------------------------------------------------------------------
 
     uint32_t header_buckets;
     uint64_t header_size;
     uint16_t header_rate;
+    uint64_t header_reserve;
+    advice header_advice;
 
     uint64_t input_size;
     uint16_t input_rate;
+    uint64_t input_reserve;
+    advice input_advice;
 
     uint64_t output_size;
     uint16_t output_rate;
+    uint64_t output_reserve;
+    advice output_advice;
 
     uint32_t point_buckets;
     uint64_t point_size;
     uint16_t point_rate;
+    uint64_t point_reserve;
+    advice point_advice;
+
+    /// Bytes of persistent point key filter (zero disables).
+    uint64_t point_filter;
 
     uint64_t puts_size;
     uint16_t puts_rate;
+    uint64_t puts_reserve;
+    advice puts_advice;
 
     uint32_t spend_buckets;
     uint64_t spend_size;
     uint16_t spend_rate;
+    uint64_t spend_reserve;
+    advice spend_advice;
 
     uint32_t tx_buckets;
     uint64_t tx_size;
     uint16_t tx_rate;
+    uint64_t tx_reserve;
+    advice tx_advice;
+
+    /// Bytes of persistent tx key filter (zero disables).
+    uint64_t tx_filter;
 
+    /// Initial txs head slots, which grow with the header table.
     uint32_t txs_buckets;
     uint64_t txs_size;
     uint16_t txs_rate;
+    uint64_t txs_reserve;
+    advice txs_advice;
 
     /// Indexes.
     /// -----------------------------------------------------------------------
 
     uint64_t candidate_size;
     uint16_t candidate_rate;
+    uint64_t candidate_reserve;
+    advice candidate_advice;
 
     uint64_t confirmed_size;
     uint16_t confirmed_rate;
+    uint64_t confirmed_reserve;
+    advice confirmed_advice;
 
     uint32_t strong_tx_buckets;
     uint64_t strong_tx_size;
     uint16_t strong_tx_rate;
+    uint64_t strong_tx_reserve;
+    advice strong_tx_advice;
+
+    uint64_t strong_size;
+    uint16_t strong_rate;
+    uint64_t strong_reserve;
+    advice strong_advice;
+
+    uint64_t lineage_size;
+    uint16_t lineage_rate;
+    uint64_t lineage_reserve;
+    advice lineage_advice;
 
     /// Caches.
     /// -----------------------------------------------------------------------
@@ -91,10 +153,14 @@ struct BCD_API settings
     uint32_t validated_bk_buckets;
     uint64_t validated_bk_size;
     uint16_t validated_bk_rate;
+    uint64_t validated_bk_reserve;
+    advice validated_bk_advice;
 
     uint32_t validated_tx_buckets;
     uint64_t validated_tx_size;
     uint16_t validated_tx_rate;
+    uint64_t validated_tx_reserve;
+    advice validated_tx_advice;
 
     /// Optionals.
     /// -----------------------------------------------------------------------
@@ -102,10 +168,14 @@ struct BCD_API settings
     uint32_t address_buckets;
     uint64_t address_size;
     uint16_t address_rate;
+    uint64_t address_reserve;
+    advice address_advice;
 
     uint32_t neutrino_buckets;
     uint64_t neutrino_size;
     uint16_t neutrino_rate;
+    uint64_t neutrino_reserve;
+    advice neutrino_advice;
 
     ////uint32_t bootstrap_size;
     ////uint16_t bootstrap_rate;
@@ -19,9 +19,12 @@
 #ifndef LIBBITCOIN_DATABASE_STORE_HPP
 #define LIBBITCOIN_DATABASE_STORE_HPP
 
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <bitcoin/database/boost.hpp>
 #include <bitcoin/database/define.hpp>
@@ -42,10 +45,11 @@ template <typename Storage, if_base_of<storage, Storage> = true>
 class store
 {
 public:
-    DELETE_COPY_MOVE_DESTRUCT(store);
+    DELETE_COPY_MOVE(store);
 
     typedef std::function<void(event_t, table_t)> event_handler;
     typedef std::function<void(const code&, table_t)> error_handler;
+    typedef std::function<void(size_t, size_t, table_t)> pending_handler;
     typedef std::shared_lock<std::shared_timed_mutex> transactor;
 
     // event and table names, useful for internal logging.
@@ -55,6 +59,9 @@ public:
     /// Construct a store from settings.
     store(const settings& config) NOEXCEPT;
 
+    /// Stop background writeback if running.
+    virtual ~store() NOEXCEPT;
+
     /// Methods.
     /// -----------------------------------------------------------------------
 
@@ -67,6 +74,21 @@ public:
     /// Snapshot the set of tables (from loaded, leaves loaded).
     code snapshot(const event_handler& handler) NOEXCEPT;
 
+    /// Begin writeback of bodies appended since last sync (from loaded).
+    /// Does not suspend writes, so snapshot flush covers only the remainder.
+    code sync() NOEXCEPT;
+
+    /// Grow or migrate hash table heads one step (from loaded, leaves loaded).
+    /// Writes do not grow heads (requires bucket_load), so heads grow only by
+    /// this call or by the background flusher (requires flush_interval), which
+    /// steps heads at each interval when no transactor is held. Each step
+    /// suspends all writes (exclusive transactor) for the duration of one
+    /// bounded migration step (see hashmap::maintain), so a caller should
+    /// invoke it when writes may be briefly stalled (e.g. between blocks).
+    /// Header keyed (index map) heads are also presized to twice the header
+    /// count, otherwise these grow as headers are archived (rarely, doubling).
+    code maintain(const event_handler& handler) NOEXCEPT;
+
     /// Restore the most recent snapshot (from closed, leaves loaded).
     code restore(const event_handler& handler) NOEXCEPT;
 
@@ -91,9 +113,15 @@ public:
     /// Dump all error/full conditions to handler.
     void report(const error_handler& handler) const NOEXCEPT;
 
+    /// Dump bytes pending writeback and pending flush (lag) of each body.
+    void pending(const pending_handler& handler) const NOEXCEPT;
+
     /// Favor minimum size over thrashing guard (requires high memory).
     bool minimize() const NOEXCEPT;
 
+    /// Header chain walk fields are copied to the lineage table.
+    bool header_lineage() const NOEXCEPT;
+
     /// Tables.
     /// -----------------------------------------------------------------------
 
@@ -111,6 +139,8 @@ public:
     table::height candidate;
     table::height confirmed;
     table::strong_tx strong_tx;
+    table::strong strong;
+    table::lineage lineage;
 
     /// Caches.
     table::validated_bk validated_bk;
@@ -128,6 +158,18 @@ protected:
     code backup(const event_handler& handler) NOEXCEPT;
     code dump(const std::filesystem::path& folder,
         const event_handler& handler) NOEXCEPT;
+    void start_flusher() NOEXCEPT;
+    void stop_flusher() NOEXCEPT;
+
+    // Step table heads, requires exclusive transactor.
+    code maintain_(const event_handler& handler) NOEXCEPT;
+
+    // Write or verify the store format version (see schema::format).
+    code create_format() const NOEXCEPT;
+    code verify_format() const NOEXCEPT;
+
+    // Set lineage records for headers beyond its count (when enabled).
+    code backfill_lineage() NOEXCEPT;
 
     // These are thread safe.
     const settings& configuration_;
@@ -150,6 +192,7 @@ protected:
     // record hashmap
     Storage point_head_;
     Storage point_body_;
+    Storage point_filter_;
 
     // array
     Storage puts_head_;
@@ -162,6 +205,7 @@ protected:
     // record hashmap
     Storage tx_head_;
     Storage tx_body_;
+    Storage tx_filter_;
 
     // slab hashmap
     Storage txs_head_;
@@ -182,6 +226,12 @@ protected:
     Storage strong_tx_head_;
     Storage strong_tx_body_;
 
+    // array
+    Storage strong_head_;
+    Storage strong_body_;
+    Storage lineage_head_;
+    Storage lineage_body_;
+
     /// Caches.
     /// -----------------------------------------------------------------------
 
@@ -220,6 +270,12 @@ protected:
     interprocess_lock process_lock_;
     std::shared_timed_mutex transactor_mutex_{};
 
+    // These are protected by flusher_mutex_.
+    std::thread flusher_{};
+    bool stopping_{};
+    std::mutex flusher_mutex_{};
+    std::condition_variable flusher_condition_{};
+
 private:
     using path = std::filesystem::path;
 
@@ -233,6 +289,11 @@ private:
         return folder / (name + schema::ext::data);
     }
 
+    static inline path filter(const path& folder, const std::string& name) NOEXCEPT
+    {
+        return folder / (name + schema::ext::filter);
+    }
+
     static inline path lock(const path& folder, const std::string& name) NOEXCEPT
     {
         return folder / (name + schema::ext::lock);
@@ -37,6 +37,22 @@ struct header
     using search_key = search<schema::hash>;
     using hash_map<schema::header>::hashmap;
 
+    /// Element field positions (from search key), for views.
+    struct fields
+      : public schema::header
+    {
+        using flags       = field<sk, context::flag::size>;
+        using height      = field<flags::end, context::block::size>;
+        using mtp         = field<height::end, sizeof(uint32_t)>;
+        using milestone   = field<mtp::end, schema::bit>;
+        using parent_fk   = field<milestone::end, link::size>;
+        using version     = field<parent_fk::end, sizeof(uint32_t)>;
+        using timestamp   = field<version::end, sizeof(uint32_t)>;
+        using bits        = field<timestamp::end, sizeof(uint32_t)>;
+        using nonce       = field<bits::end, sizeof(uint32_t)>;
+        static_assert(nonce::end + schema::hash == sk + minsize);
+    };
+
     struct record
       : public schema::header
     {        
@@ -174,11 +190,10 @@ struct header
     struct get_version
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::size + schema::bit + link::size);
-            version = source.read_little_endian<uint32_t>();
-            return source;
+            version = fields::version::get(data);
+            return true;
         }
 
         uint32_t version{};
@@ -187,12 +202,10 @@ struct header
     struct get_timestamp
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::size + schema::bit + link::size +
-                sizeof(uint32_t));
-            timestamp = source.read_little_endian<uint32_t>();
-            return source;
+            timestamp = fields::timestamp::get(data);
+            return true;
         }
 
         uint32_t timestamp{};
@@ -201,12 +214,10 @@ struct header
     struct get_bits
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::size + schema::bit + link::size +
-                sizeof(uint32_t) + sizeof(uint32_t));
-            bits = source.read_little_endian<uint32_t>();
-            return source;
+            bits = fields::bits::get(data);
+            return true;
         }
 
         uint32_t bits{};
@@ -215,11 +226,10 @@ struct header
     struct get_parent_fk
       : public schema::header
     {        
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::size + schema::bit);
-            parent_fk = source.read_little_endian<link::integer, link::size>();
-            return source;
+            parent_fk = fields::parent_fk::get(data);
+            return true;
         }
 
         link::integer parent_fk{};
@@ -228,11 +238,10 @@ struct header
     struct get_flags
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            using flag = context::flag;
-            flags = source.read_little_endian<flag::integer, flag::size>();
-            return source;
+            flags = fields::flags::get(data);
+            return true;
         }
 
         context::flag::integer flags{};
@@ -241,25 +250,43 @@ struct header
     struct get_height
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            using block = context::block;
-            source.skip_bytes(context::flag::size);
-            height = source.read_little_endian<block::integer, block::size>();
-            return source;
+            height = fields::height::get(data);
+            return true;
+        }
+
+        context::block::integer height{};
+    };
+
+    /// Chain state walk fields (see lineage).
+    struct get_lineage
+      : public schema::header
+    {
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
+        {
+            parent_fk = fields::parent_fk::get(data);
+            version   = fields::version::get(data);
+            timestamp = fields::timestamp::get(data);
+            bits      = fields::bits::get(data);
+            height    = fields::height::get(data);
+            return true;
         }
 
+        link::integer parent_fk{};
+        uint32_t version{};
+        uint32_t timestamp{};
+        uint32_t bits{};
         context::block::integer height{};
     };
 
     struct get_mtp
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::flag::size + context::block::size);
-            mtp = source.read_little_endian<uint32_t>();
-            return source;
+            mtp = fields::mtp::get(data);
+            return true;
         }
 
         uint32_t mtp{};
@@ -268,11 +295,10 @@ struct header
     struct get_milestone
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(context::size);
-            milestone = to_bool(source.read_byte());
-            return source;
+            milestone = to_bool(fields::milestone::get(data));
+            return true;
         }
 
         bool milestone{};
@@ -299,10 +325,12 @@ struct header
     struct record_context
       : public schema::header
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            context::from_data(source, ctx);
-            return source;
+            ctx.flags  = fields::flags::get(data);
+            ctx.height = fields::height::get(data);
+            ctx.mtp    = fields::mtp::get(data);
+            return true;
         }
 
         context ctx{};
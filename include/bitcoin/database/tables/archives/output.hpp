@@ -34,12 +34,141 @@ BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 /// Output is a blob (set of non-searchable slabs).
 /// Output can be obtained by fk navigation (eg from tx/index). 
+/// Scripts of common templates are stored as template tag and payload.
 struct output
   : public array_map<schema::output>
 {
     using tx = linkage<schema::tx>;
     using array_map<schema::output>::arraymap;
 
+    /// Template tags follow the eight byte size prefix, which no stored script
+    /// can have (block size limited), so other scripts retain the serialized
+    /// (size prefixed) form and stores without templates remain readable.
+    static constexpr uint8_t escape = system::varint_eight_bytes;
+    static constexpr uint8_t nonstandard = 0x00;
+    static constexpr uint8_t pay_key_hash = 0x01;
+    static constexpr uint8_t pay_script_hash = 0x02;
+    static constexpr uint8_t pay_witness_key_hash = 0x03;
+    static constexpr uint8_t pay_witness_script_hash = 0x04;
+    static constexpr uint8_t pay_taproot = 0x05;
+
+    static constexpr size_t payload_size(uint8_t tag) NOEXCEPT
+    {
+        return tag == pay_witness_script_hash || tag == pay_taproot ?
+            system::hash_size : system::short_hash_size;
+    }
+
+    static inline uint8_t to_tag(const system::chain::script& script) NOEXCEPT
+    {
+        using namespace system::chain;
+        const auto& ops = script.ops();
+        const auto is = [&](size_t index, opcode code) NOEXCEPT
+        {
+            return ops.at(index).code() == code;
+        };
+        const auto is_push = [&](size_t index, size_t size) NOEXCEPT
+        {
+            // Data size excludes underflow of the push.
+            const auto& op = ops.at(index);
+            return op.code() == operation::opcode_from_size(size) &&
+                op.data().size() == size;
+        };
+
+        switch (ops.size())
+        {
+            case 2:
+                if (is(0, opcode::push_size_0) && is_push(1, 20))
+                    return pay_witness_key_hash;
+                if (is(0, opcode::push_size_0) && is_push(1, 32))
+                    return pay_witness_script_hash;
+                if (is(0, opcode::push_positive_1) && is_push(1, 32))
+                    return pay_taproot;
+                return nonstandard;
+            case 3:
+                if (is(0, opcode::hash160) && is_push(1, 20) &&
+                    is(2, opcode::equal))
+                    return pay_script_hash;
+                return nonstandard;
+            case 5:
+                if (is(0, opcode::dup) && is(1, opcode::hash160) &&
+                    is_push(2, 20) && is(3, opcode::equalverify) &&
+                    is(4, opcode::checksig))
+                    return pay_key_hash;
+                return nonstandard;
+            default:
+                return nonstandard;
+        }
+    }
+
+    static inline size_t script_size(
+        const system::chain::script& script) NOEXCEPT
+    {
+        const auto tag = to_tag(script);
+        if (tag != nonstandard)
+            return two + payload_size(tag);
+
+        return script.serialized_size(true);
+    }
+
+    static inline void write_script(flipper& sink,
+        const system::chain::script& script) NOEXCEPT
+    {
+        using namespace system;
+        const auto tag = to_tag(script);
+        if (tag != nonstandard)
+        {
+            // Payload is the only push of each template.
+            sink.write_byte(escape);
+            sink.write_byte(tag);
+            sink.write_bytes(script.ops().at(tag == pay_key_hash ? two :
+                one).data());
+            return;
+        }
+
+        script.to_data(sink, true);
+    }
+
+    static inline system::chain::script read_script(reader& source) NOEXCEPT
+    {
+        using namespace system;
+        using namespace system::chain;
+        if (source.peek_byte() != escape)
+            return { source, true };
+
+        source.skip_bytes(one);
+        const auto tag = source.read_byte();
+        if (tag < pay_key_hash || tag > pay_taproot)
+        {
+            source.invalidate();
+            return {};
+        }
+
+        const auto payload = source.read_bytes(payload_size(tag));
+        const auto code = [](opcode value) NOEXCEPT
+        {
+            return static_cast<uint8_t>(value);
+        };
+
+        const auto push = code(operation::opcode_from_size(payload.size()));
+        switch (tag)
+        {
+            case pay_key_hash:
+                return { splice(data_chunk{ code(opcode::dup),
+                    code(opcode::hash160), push }, payload,
+                    data_chunk{ code(opcode::equalverify),
+                    code(opcode::checksig) }), false };
+            case pay_script_hash:
+                return { splice(data_chunk{ code(opcode::hash160), push },
+                    payload, data_chunk{ code(opcode::equal) }), false };
+            case pay_taproot:
+                return { splice(data_chunk{ code(opcode::push_positive_1),
+                    push }, payload), false };
+            default:
+                return { splice(data_chunk{ code(opcode::push_size_0),
+                    push }, payload), false };
+        }
+    }
+
     struct slab
       : public schema::output
     {
@@ -48,7 +177,7 @@ struct output
             return system::possible_narrow_cast<link::integer>(
                 tx::size +
                 variable_size(value) +
-                script.serialized_size(true));
+                script_size(script));
         }
 
         inline bool from_data(reader& source) NOEXCEPT
@@ -56,8 +185,9 @@ struct output
             using namespace system;
             parent_fk = source.read_little_endian<tx::integer, tx::size>();
             value     = source.read_variable();
-            script = chain::script{ source, true };
-            BC_ASSERT(source.get_read_position() == count());
+            script = read_script(source);
+
+            // Template scripts stored without tag exceed count (not asserted).
             return source;
         }
 
@@ -65,7 +195,7 @@ struct output
         {
             sink.write_little_endian<tx::integer, tx::size>(parent_fk);
             sink.write_variable(value);
-            script.to_data(sink, true);
+            write_script(sink, script);
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
@@ -93,7 +223,7 @@ struct output
             output = to_shared(new chain::output
             {
                 source.read_variable(),
-                to_shared<chain::script>(source, true)
+                to_shared<chain::script>(read_script(source))
             });
 
             return source;
@@ -135,14 +265,14 @@ struct output
             return system::possible_narrow_cast<link::integer>(
                 tx::size +
                 variable_size(output.value()) +
-                output.script().serialized_size(true));
+                script_size(output.script()));
         }
 
         inline bool to_data(flipper& sink) const NOEXCEPT
         {
             sink.write_little_endian<tx::integer, tx::size>(parent_fk);
             sink.write_variable(output.value());
-            output.script().to_data(sink, true);
+            write_script(sink, output.script());
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
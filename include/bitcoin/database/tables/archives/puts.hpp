@@ -31,6 +31,11 @@ namespace database {
 namespace table {
 
 /// Puts is an blob of spend and output fk records.
+/// The spends of a tx are allocated contiguously, so only the first spend fk
+/// is stored (if any), followed by each output fk. Spend fks are expanded from
+/// the first by the preallocated spend_fks size (the tx ins_count). Slabs of
+/// the prior layout are not distinguishable, so stores of prior format are not
+/// opened (see schema::format).
 struct puts
   : public array_map<schema::puts>
 {
@@ -40,28 +45,32 @@ struct puts
     using output_links = std_vector<out::integer>;
     using array_map<schema::puts>::arraymap;
 
-    // TODO: There is a potential optimization available given that the inputs
-    // (spend puts) for a given transaction are sequential. This means that an
-    // offset with count are sufficient to store and number of spends. This is
-    // more efficient if store averages more than two spends per tx (maybe).
+    static inline void read_spends(reader& source,
+        spend_links& spend_fks) NOEXCEPT
+    {
+        if (spend_fks.empty())
+            return;
+
+        auto fk = source.read_little_endian<spend::integer, spend::size>();
+        std::for_each(spend_fks.begin(), spend_fks.end(), [&](auto& link) NOEXCEPT
+        {
+            link = fk++;
+        });
+    }
 
     struct slab
       : public schema::puts
     {
         link count() const NOEXCEPT
         {
-            const auto fks = spend_fks.size() * spend::size +
+            const auto fks = (spend_fks.empty() ? zero : spend::size) +
                 out_fks.size() * out::size;
             return system::possible_narrow_cast<link::integer>(fks);
         }
 
         inline bool from_data(reader& source) NOEXCEPT
         {
-            std::for_each(spend_fks.begin(), spend_fks.end(), [&](auto& fk) NOEXCEPT
-            {
-                fk = source.read_little_endian<spend::integer, spend::size>();
-            });
-
+            read_spends(source, spend_fks);
             std::for_each(out_fks.begin(), out_fks.end(), [&](auto& fk) NOEXCEPT
             {
                 fk = source.read_little_endian<out::integer, out::size>();
@@ -73,10 +82,12 @@ struct puts
 
         inline bool to_data(flipper& sink) const NOEXCEPT
         {
-            std::for_each(spend_fks.begin(), spend_fks.end(), [&](const auto& fk) NOEXCEPT
+            if (!spend_fks.empty())
             {
-                sink.write_little_endian<spend::integer, spend::size>(fk);
-            });
+                BC_ASSERT(contiguous());
+                sink.write_little_endian<spend::integer, spend::size>(
+                    spend_fks.front());
+            }
 
             std::for_each(out_fks.begin(), out_fks.end(), [&](const auto& fk) NOEXCEPT
             {
@@ -87,6 +98,15 @@ struct puts
             return sink;
         }
 
+        inline bool contiguous() const NOEXCEPT
+        {
+            return std::adjacent_find(spend_fks.begin(), spend_fks.end(),
+                [](const auto& left, const auto& right) NOEXCEPT
+                {
+                    return right != add1(left);
+                }) == spend_fks.end();
+        }
+
         inline bool operator==(const slab& other) const NOEXCEPT
         {
             return spend_fks == other.spend_fks
@@ -102,11 +122,7 @@ struct puts
     {
         inline bool from_data(reader& source) NOEXCEPT
         {
-            std::for_each(spend_fks.begin(), spend_fks.end(), [&](auto& fk) NOEXCEPT
-            {
-                fk = source.read_little_endian<spend::integer, spend::size>();
-            });
-
+            read_spends(source, spend_fks);
             return source;
         }
 
@@ -134,10 +150,12 @@ struct puts
     {
         inline bool from_data(reader& source) NOEXCEPT
         {
-            spend_fk = source.read_little_endian<spend::integer, spend::size>();
+            spend_fk = source.read_little_endian<spend::integer, spend::size>() +
+                index;
             return source;
         }
 
+        const spend::integer index{};
         spend::integer spend_fk{};
     };
 
@@ -58,6 +58,19 @@ struct spend
         };
     }
 
+    /// Element field positions (from search key), for views.
+    struct fields
+      : public schema::spend
+    {
+        using point_fk    = field<zero, pt::size>;
+        using point_index = field<point_fk::end, ix::size>;
+        using parent_fk   = field<point_index::end, tx::size>;
+        using sequence    = field<parent_fk::end, sizeof(uint32_t)>;
+        using input_fk    = field<sequence::end, in::size>;
+        static_assert(point_index::end == sk);
+        static_assert(input_fk::end == sk + minsize);
+    };
+
     struct record
       : public schema::spend
     {
@@ -94,20 +107,17 @@ struct spend
     struct get_input
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.rewind_bytes(sk);
-            point_fk = source.read_little_endian<pt::integer, pt::size>();
-            point_index = source.read_little_endian<ix::integer, ix::size>();
+            point_fk = fields::point_fk::get(data);
+            point_index = fields::point_index::get(data);
 
             if (null_point(point_fk))
                 point_index = system::chain::point::null_index;
 
-            source.skip_bytes(tx::size);
-            sequence = source.read_little_endian<uint32_t>();
-            input_fk = source.read_little_endian<in::integer, in::size>();
-            BC_ASSERT(source.get_read_position() == minrow);
-            return source;
+            sequence = fields::sequence::get(data);
+            input_fk = fields::input_fk::get(data);
+            return true;
         }
 
         inline bool is_null() const NOEXCEPT
@@ -124,10 +134,10 @@ struct spend
     struct get_parent
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            parent_fk = source.read_little_endian<tx::integer, tx::size>();
-            return source;
+            parent_fk = fields::parent_fk::get(data);
+            return true;
         }
 
         tx::integer parent_fk{};
@@ -136,11 +146,10 @@ struct spend
     struct get_point
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.rewind_bytes(sk);
-            point_fk = source.read_little_endian<pt::integer, pt::size>();
-            return source;
+            point_fk = fields::point_fk::get(data);
+            return true;
         }
 
         inline bool is_null() const NOEXCEPT
@@ -167,16 +176,15 @@ struct spend
     struct get_prevout
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.rewind_bytes(sk);
-            point_fk = source.read_little_endian<pt::integer, pt::size>();
-            point_index = source.read_little_endian<ix::integer, ix::size>();
+            point_fk = fields::point_fk::get(data);
+            point_index = fields::point_index::get(data);
 
             if (null_point(point_fk))
                 point_index = system::chain::point::null_index;
 
-            return source;
+            return true;
         }
 
         inline bool is_null() const NOEXCEPT
@@ -191,17 +199,16 @@ struct spend
     struct get_prevout_parent
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.rewind_bytes(sk);
-            point_fk = source.read_little_endian<pt::integer, pt::size>();
-            point_index = source.read_little_endian<ix::integer, ix::size>();
+            point_fk = fields::point_fk::get(data);
+            point_index = fields::point_index::get(data);
 
             if (null_point(point_fk))
                 point_index = system::chain::point::null_index;
 
-            parent_fk = source.read_little_endian<tx::integer, tx::size>();
-            return source;
+            parent_fk = fields::parent_fk::get(data);
+            return true;
         }
 
         inline search_key prevout() const NOEXCEPT
@@ -222,18 +229,16 @@ struct spend
     struct get_prevout_sequence
       : public schema::spend
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.rewind_bytes(sk);
-            point_fk = source.read_little_endian<pt::integer, pt::size>();
-            point_index = source.read_little_endian<ix::integer, ix::size>();
+            point_fk = fields::point_fk::get(data);
+            point_index = fields::point_index::get(data);
 
             if (null_point(point_fk))
                 point_index = system::chain::point::null_index;
 
-            source.skip_bytes(tx::size);
-            sequence = source.read_little_endian<uint32_t>();
-            return source;
+            sequence = fields::sequence::get(data);
+            return true;
         }
 
         inline search_key prevout() const NOEXCEPT
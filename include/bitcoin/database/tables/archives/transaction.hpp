@@ -41,22 +41,28 @@ struct transaction
     using search_key = search<schema::hash>;
     using hash_map<schema::transaction>::hashmap;
 
-    static constexpr size_t skip_to_version =
-        schema::bit +
-        bytes::size +
-        bytes::size +
-        sizeof(uint32_t);
-
-    static constexpr size_t skip_to_puts =
-        skip_to_version +
-        sizeof(uint32_t);
+    /// Element field positions (from search key), for views.
+    struct fields
+      : public schema::transaction
+    {
+        using coinbase   = field<sk, schema::bit>;
+        using light      = field<coinbase::end, bytes::size>;
+        using heavy      = field<light::end, bytes::size>;
+        using locktime   = field<heavy::end, sizeof(uint32_t)>;
+        using version    = field<locktime::end, sizeof(uint32_t)>;
+        using ins_count  = field<version::end, ix::size>;
+        using outs_count = field<ins_count::end, ix::size>;
+        using puts_fk    = field<outs_count::end, puts::size>;
+        static_assert(puts_fk::end == sk + minsize);
+    };
 
     struct record
       : public schema::transaction
     {
         inline puts::integer outs_fk() const NOEXCEPT
         {
-            return puts_fk + (ins_count * spend::size);
+            // Contiguous spends are stored as their first link.
+            return puts_fk + (is_zero(ins_count) ? zero : spend::size);
         }
 
         inline bool from_data(reader& source) NOEXCEPT
@@ -180,12 +186,11 @@ struct transaction
     struct get_put_counts
       : public schema::transaction
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(skip_to_puts);
-            ins_count  = source.read_little_endian<ix::integer, ix::size>();
-            outs_count = source.read_little_endian<ix::integer, ix::size>();
-            return source;
+            ins_count  = fields::ins_count::get(data);
+            outs_count = fields::outs_count::get(data);
+            return true;
         }
 
         ix::integer ins_count{};
@@ -197,16 +202,16 @@ struct transaction
     {
         inline puts::integer outs_fk() const NOEXCEPT
         {
-            return puts_fk + (ins_count * spend::size);
+            // Contiguous spends are stored as their first link.
+            return puts_fk + (is_zero(ins_count) ? zero : spend::size);
         }
 
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(skip_to_puts);
-            ins_count  = source.read_little_endian<ix::integer, ix::size>();
-            outs_count = source.read_little_endian<ix::integer, ix::size>();
-            puts_fk    = source.read_little_endian<puts::integer, puts::size>();
-            return source;
+            ins_count  = fields::ins_count::get(data);
+            outs_count = fields::outs_count::get(data);
+            puts_fk    = fields::puts_fk::get(data);
+            return true;
         }
 
         ix::integer ins_count{};
@@ -219,17 +224,17 @@ struct transaction
     {
         inline puts::integer outs_fk() const NOEXCEPT
         {
-            return puts_fk + (ins_count * spend::size);
+            // Contiguous spends are stored as their first link.
+            return puts_fk + (is_zero(ins_count) ? zero : spend::size);
         }
 
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(skip_to_version);
-            version = source.read_little_endian<uint32_t>();
-            ins_count  = source.read_little_endian<ix::integer, ix::size>();
-            outs_count = source.read_little_endian<ix::integer, ix::size>();
-            puts_fk    = source.read_little_endian<puts::integer, puts::size>();
-            return source;
+            version    = fields::version::get(data);
+            ins_count  = fields::ins_count::get(data);
+            outs_count = fields::outs_count::get(data);
+            puts_fk    = fields::puts_fk::get(data);
+            return true;
         }
 
         uint32_t version{};
@@ -241,45 +246,43 @@ struct transaction
     struct get_spend
       : public schema::transaction
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(skip_to_puts);
-            const auto ins_count = source.read_little_endian<ix::integer, ix::size>();
+            const auto ins_count = fields::ins_count::get(data);
 
             if (index >= ins_count)
             {
-                spend_fk = puts::terminal;
-                return source;
+                puts_fk = puts::terminal;
+                return true;
             }
 
-            source.skip_bytes(ix::size);
-            const auto puts_fk = source.read_little_endian<puts::integer, puts::size>();
-            spend_fk = puts_fk + (index * spend::size);
-            return source;
+            // Spends are contiguous, so index is applied to the stored base.
+            puts_fk = fields::puts_fk::get(data);
+            return true;
         }
 
         const puts::integer index{};
-        puts::integer spend_fk{};
+        puts::integer puts_fk{};
     };
 
     struct get_output
       : public schema::transaction
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            source.skip_bytes(skip_to_puts);
-            const auto ins_count = source.read_little_endian<ix::integer, ix::size>();
-            const auto outs_count = source.read_little_endian<ix::integer, ix::size>();
+            const auto ins_count = fields::ins_count::get(data);
+            const auto outs_count = fields::outs_count::get(data);
 
             if (index >= outs_count)
             {
                 out_fk = puts::terminal;
-                return source;
+                return true;
             }
 
-            const auto puts_fk = source.read_little_endian<puts::integer, puts::size>();
-            out_fk = puts_fk + (ins_count * spend::size) + (index * out::size);
-            return source;
+            const auto puts_fk = fields::puts_fk::get(data);
+            out_fk = puts_fk + (is_zero(ins_count) ? zero : spend::size) +
+                (index * out::size);
+            return true;
         }
 
         const puts::integer index{};
@@ -289,10 +292,10 @@ struct transaction
     struct get_coinbase
       : public schema::transaction
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            coinbase = to_bool(source.read_byte());
-            return source;
+            coinbase = to_bool(fields::coinbase::get(data));
+            return true;
         }
 
         bool coinbase{};
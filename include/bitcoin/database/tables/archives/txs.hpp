@@ -30,14 +30,14 @@ namespace libbitcoin {
 namespace database {
 namespace table {
 
-/// Txs is a slab hashmap of tx fks (first is count), searchable by header.fk.
+/// Txs is a slab indexmap of tx fks (first is count), searchable by header.fk.
 struct txs
-  : public hash_map<schema::txs>
+  : public index_map<schema::txs>
 {
     using tx = linkage<schema::tx>;
     using keys = std_vector<tx::integer>;
     using bytes = linkage<schema::size>;
-    using hash_map<schema::txs>::hashmap;
+    using index_map<schema::txs>::indexmap;
 
     struct slab
       : public schema::txs
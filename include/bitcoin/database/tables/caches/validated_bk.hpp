@@ -28,12 +28,12 @@ namespace libbitcoin {
 namespace database {
 namespace table {
 
-/// validated_bk is a slab hashmap of block validation state.
+/// validated_bk is a slab indexmap of block validation state.
 struct validated_bk
-  : public hash_map<schema::validated_bk>
+  : public index_map<schema::validated_bk>
 {
     using coding = linkage<schema::code>;
-    using hash_map<schema::validated_bk>::hashmap;
+    using index_map<schema::validated_bk>::indexmap;
 
     struct slab
       : public schema::validated_bk
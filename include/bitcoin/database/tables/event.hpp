@@ -41,7 +41,9 @@ enum class event_t
     archive_snapshot,
 
     restore_table,
-    recover_snapshot
+    recover_snapshot,
+
+    maintain_table
 };
 
 } // namespace database
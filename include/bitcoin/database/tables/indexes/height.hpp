@@ -38,10 +38,10 @@ struct height
     struct record
       : public schema::height
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            header_fk = source.read_little_endian<block::integer, block::size>();
-            return source;
+            header_fk = field<zero, block::size>::get(data);
+            return true;
         }
 
         inline bool to_data(flipper& sink) const NOEXCEPT
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TABLES_INDEXES_LINEAGE_HPP
+#define LIBBITCOIN_DATABASE_TABLES_INDEXES_LINEAGE_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/context.hpp>
+#include <bitcoin/database/tables/schema.hpp>
+
+namespace libbitcoin {
+namespace database {
+namespace table {
+
+/// lineage is an array of header chain walk fields, indexed by header link.
+/// These are copies of the header record fields read by chain state and
+/// retarget walks, so that a walk reads dense records instead of full header
+/// rows. Records not yet set are zero filled (set flag is false).
+struct lineage
+  : public array_map<schema::lineage>
+{
+    using block = linkage<schema::block>;
+    using array_map<schema::lineage>::arraymap;
+
+    /// Element field positions, for views.
+    struct fields
+      : public schema::lineage
+    {
+        using parent_fk = field<zero, block::size>;
+        using version   = field<parent_fk::end, sizeof(uint32_t)>;
+        using timestamp = field<version::end, sizeof(uint32_t)>;
+        using bits      = field<timestamp::end, sizeof(uint32_t)>;
+        using height    = field<bits::end, context::block::size>;
+        using set       = field<height::end, schema::bit>;
+        static_assert(set::end == minsize);
+    };
+
+    struct record
+      : public schema::lineage
+    {
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
+        {
+            parent_fk = fields::parent_fk::get(data);
+            version   = fields::version::get(data);
+            timestamp = fields::timestamp::get(data);
+            bits      = fields::bits::get(data);
+            height    = fields::height::get(data);
+            set       = to_bool(fields::set::get(data));
+            return true;
+        }
+
+        inline bool to_data(flipper& sink) const NOEXCEPT
+        {
+            // Set flag is written last as it marks the record as set.
+            sink.write_little_endian<block::integer, block::size>(parent_fk);
+            sink.write_little_endian<uint32_t>(version);
+            sink.write_little_endian<uint32_t>(timestamp);
+            sink.write_little_endian<uint32_t>(bits);
+            sink.write_little_endian<context::block::integer,
+                context::block::size>(height);
+            sink.write_byte(to_int<uint8_t>(set));
+            return sink;
+        }
+
+        /// False if the record has not been set (zero filled).
+        inline bool is_set() const NOEXCEPT
+        {
+            return set;
+        }
+
+        inline bool operator==(const record& other) const NOEXCEPT
+        {
+            return parent_fk == other.parent_fk
+                && version   == other.version
+                && timestamp == other.timestamp
+                && bits      == other.bits
+                && height    == other.height
+                && set       == other.set;
+        }
+
+        block::integer parent_fk{};
+        uint32_t version{};
+        uint32_t timestamp{};
+        uint32_t bits{};
+        context::block::integer height{};
+        bool set{};
+    };
+};
+
+} // namespace table
+} // namespace database
+} // namespace libbitcoin
+
+#endif
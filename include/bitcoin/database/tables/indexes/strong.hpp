@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TABLES_INDEXES_STRONG_HPP
+#define LIBBITCOIN_DATABASE_TABLES_INDEXES_STRONG_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/schema.hpp>
+
+namespace libbitcoin {
+namespace database {
+namespace table {
+
+/// strong is an array of tx confirmation state, indexed by tx link.
+/// Each record is the current (strong_tx top) association of the tx, with
+/// records not yet set zero filled (set flag is false). An unset record does
+/// not imply not strong, as the tx may precede the index (see strong_tx).
+struct strong
+  : public array_map<schema::strong>
+{
+    using block = linkage<schema::block>;
+    using array_map<schema::strong>::arraymap;
+
+    /// Element field positions, for views.
+    struct fields
+      : public schema::strong
+    {
+        using header_fk = field<zero, block::size>;
+        using positive  = field<header_fk::end, schema::bit>;
+        using set       = field<positive::end, schema::bit>;
+        static_assert(set::end == minsize);
+    };
+
+    struct record
+      : public schema::strong
+    {
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
+        {
+            header_fk = fields::header_fk::get(data);
+            positive = to_bool(fields::positive::get(data));
+            set = to_bool(fields::set::get(data));
+            return true;
+        }
+
+        inline bool to_data(flipper& sink) const NOEXCEPT
+        {
+            // Set flag is written last as it marks the record as set.
+            sink.write_little_endian<block::integer, block::size>(header_fk);
+            sink.write_byte(to_int<uint8_t>(positive));
+            sink.write_byte(to_int<uint8_t>(set));
+            return sink;
+        }
+
+        /// False if the record has not been set (zero filled).
+        inline bool is_set() const NOEXCEPT
+        {
+            return set;
+        }
+
+        /// True if the tx is strong by header_fk.
+        inline bool is_strong() const NOEXCEPT
+        {
+            return positive && header_fk != block::terminal;
+        }
+
+        inline bool operator==(const record& other) const NOEXCEPT
+        {
+            return header_fk == other.header_fk
+                && positive == other.positive
+                && set == other.set;
+        }
+
+        block::integer header_fk{};
+        bool positive{};
+        bool set{};
+    };
+};
+
+} // namespace table
+} // namespace database
+} // namespace libbitcoin
+
+#endif
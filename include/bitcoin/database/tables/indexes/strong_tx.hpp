@@ -35,14 +35,23 @@ struct strong_tx
     using block = linkage<schema::block>;
     using hash_map<schema::strong_tx>::hashmap;
 
+    /// Element field positions (from search key), for views.
+    struct fields
+      : public schema::strong_tx
+    {
+        using header_fk = field<sk, block::size>;
+        using positive  = field<header_fk::end, schema::bit>;
+        static_assert(positive::end == sk + minsize);
+    };
+
     struct record
       : public schema::strong_tx
     {
-        inline bool from_data(reader& source) NOEXCEPT
+        inline bool from_memory(const uint8_t* data) NOEXCEPT
         {
-            header_fk = source.read_little_endian<block::integer, block::size>();
-            positive = to_bool(source.read_byte());
-            return source;
+            header_fk = fields::header_fk::get(data);
+            positive = to_bool(fields::positive::get(data));
+            return true;
         }
 
         inline bool to_data(finalizer& sink) const NOEXCEPT
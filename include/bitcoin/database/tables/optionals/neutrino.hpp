@@ -28,11 +28,11 @@ namespace libbitcoin {
 namespace database {
 namespace table {
 
-/// neutrino is a slab hashmap of neutrino filters.
+/// neutrino is a slab indexmap of neutrino filters.
 struct neutrino
-  : public hash_map<schema::neutrino>
+  : public index_map<schema::neutrino>
 {
-    using hash_map<schema::neutrino>::hashmap;
+    using index_map<schema::neutrino>::indexmap;
 
     struct slab
       : public schema::neutrino
@@ -58,6 +58,8 @@ namespace schema
         constexpr auto candidate = "candidate";
         constexpr auto confirmed = "confirmed";
         constexpr auto strong_tx = "strong_tx";
+        constexpr auto strong = "strong";
+        constexpr auto lineage = "lineage";
         ////constexpr auto spent_out = "spent_out";
     }
 
@@ -79,9 +81,18 @@ namespace schema
         constexpr auto process = "process";
     }
 
+    /// The version is incremented for any change to the layout of a table,
+    /// and a store of any other version is not opened (or restored).
+    namespace format
+    {
+        constexpr auto name = "format";
+        constexpr uint32_t version = 1;
+    }
+
     namespace ext
     {
         constexpr auto head = ".head";
+        constexpr auto filter = ".filter";
         constexpr auto data = ".data";
         constexpr auto lock = ".lock";
     }
@@ -131,7 +142,7 @@ namespace schema
     // record hashmap
     struct header
     {
-        static constexpr bool hash_function = false;
+        using hash_function = unique_hasher;
         static constexpr size_t pk = schema::block;
         static constexpr size_t sk = schema::hash;
         static constexpr size_t minsize =
@@ -167,10 +178,10 @@ namespace schema
         static_assert(minrow == 9u);
     };
 
-    // record hashmap
+    // record hashmap, fingerprinted (frequent misses).
     struct transaction
     {
-        static constexpr bool hash_function = false;
+        using hash_function = fingerprinted<unique_hasher>;
         static constexpr size_t pk = schema::tx;
         static constexpr size_t sk = schema::hash;
         static constexpr size_t minsize =
@@ -221,9 +232,10 @@ namespace schema
     };
 
     // moderate (sk:7) record multimap, with low multiple rate.
+    // Hasher determines bucket placement of existing stores (do not change).
     struct spend
     {
-        static constexpr bool hash_function = false;
+        using hash_function = unique_hasher;
         static constexpr size_t pk = schema::spend_;
         static constexpr size_t sk = transaction::pk + schema::index;
         static constexpr size_t minsize =
@@ -237,10 +249,10 @@ namespace schema
         static_assert(minrow == 24u);
     };
 
-    // record hashmap
+    // record hashmap, fingerprinted (frequent misses).
     struct point
     {
-        static constexpr bool hash_function = false;
+        using hash_function = fingerprinted<unique_hasher>;
         static constexpr size_t pk = schema::point_;
         static constexpr size_t sk = schema::hash;
         static constexpr size_t minsize = zero;
@@ -251,10 +263,9 @@ namespace schema
         static_assert(minrow == 36u);
     };
 
-    // slab hashmap
+    // slab indexmap (by header.pk)
     struct txs
     {
-        static constexpr bool hash_function = false;
         static constexpr size_t pk = schema::txs_;
         static constexpr size_t sk = schema::header::pk;
         static constexpr size_t minsize =
@@ -288,7 +299,7 @@ namespace schema
     // large (sk:32) record multimap, with high multiple rate.
     struct address
     {
-        static constexpr bool hash_function = false;
+        using hash_function = unique_hasher;
         static constexpr size_t pk = schema::puts_;
         ////static constexpr size_t sk = schema::point::pk;
         static constexpr size_t sk = schema::hash;
@@ -304,7 +315,7 @@ namespace schema
     // record hashmap
     struct strong_tx
     {
-        static constexpr bool hash_function = false;
+        using hash_function = unique_hasher;
         static constexpr size_t pk = schema::tx;
         static constexpr size_t sk = schema::transaction::pk;
         static constexpr size_t minsize =
@@ -316,13 +327,45 @@ namespace schema
         static_assert(minrow == 12u);
     };
 
+    // array (strong_tx top record indexed by tx)
+    struct strong
+    {
+        static constexpr size_t pk = schema::transaction::pk;
+        static constexpr size_t sk = zero;
+        static constexpr size_t minsize =
+            schema::header::pk + bit + bit;
+        static constexpr size_t minrow = minsize;
+        static constexpr size_t size = minsize;
+        static constexpr linkage<pk> count() NOEXCEPT { return 1; }
+        static_assert(minsize == 5u);
+        static_assert(minrow == 5u);
+    };
+
+    // array (header chain walk fields indexed by header)
+    struct lineage
+    {
+        static constexpr size_t pk = schema::header::pk;
+        static constexpr size_t sk = zero;
+        static constexpr size_t minsize =
+            schema::header::pk +
+            sizeof(uint32_t) +
+            sizeof(uint32_t) +
+            sizeof(uint32_t) +
+            schema::block +
+            schema::bit;
+        static constexpr size_t minrow = minsize;
+        static constexpr size_t size = minsize;
+        static constexpr linkage<pk> count() NOEXCEPT { return 1; }
+        static_assert(minsize == 19u);
+        static_assert(minrow == 19u);
+    };
+
     /// Cache tables.
     /// -----------------------------------------------------------------------
 
-    // slab hashmap
+    // slab indexmap (by header.pk)
     struct validated_bk
     {
-        static constexpr bool hash_function = false;
         static constexpr size_t pk = schema::bk_slab;
         static constexpr size_t sk = schema::header::pk;
         static constexpr size_t minsize =
@@ -338,7 +381,7 @@ namespace schema
     // modest (sk:4) slab multimap, with low multiple rate.
     struct validated_tx
     {
-        static constexpr bool hash_function = false;
+        using hash_function = unique_hasher;
         static constexpr size_t pk = schema::tx_slab;
         static constexpr size_t sk = schema::transaction::pk;
         static constexpr size_t minsize =
@@ -355,10 +398,9 @@ namespace schema
         static_assert(minrow == 23u);
     };
 
-    // slab hashmap
+    // slab indexmap (by header.pk)
     struct neutrino
     {
-        static constexpr bool hash_function = false;
         static constexpr size_t pk = schema::neutrino_;
         static constexpr size_t sk = schema::header::pk;
         static constexpr size_t minsize =
@@ -387,7 +429,7 @@ namespace schema
     ////// slab hashmap
     ////struct buffer
     ////{
-    ////    static constexpr bool hash_function = false;
+    ////    using hash_function = unique_hasher;
     ////    static constexpr size_t pk = schema::buffer_;
     ////    static constexpr size_t sk = schema::transaction::pk;
     ////    static constexpr size_t minsize = zero;
@@ -39,6 +39,7 @@ enum class table_t
     point_table,
     point_head,
     point_body,
+    point_filter,
     puts_table,
     puts_head,
     puts_body,
@@ -49,6 +50,7 @@ enum class table_t
     tx_head,
     txs_table,
     tx_body,
+    tx_filter,
     txs_head,
     txs_body,
 
@@ -62,6 +64,12 @@ enum class table_t
     strong_tx_table,
     strong_tx_head,
     strong_tx_body,
+    strong_table,
+    strong_head,
+    strong_body,
+    lineage_table,
+    lineage_head,
+    lineage_body,
 
     /// Caches.
     validated_bk_table,
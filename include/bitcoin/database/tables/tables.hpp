@@ -32,6 +32,8 @@
 #include <bitcoin/database/tables/caches/validated_tx.hpp>
 
 #include <bitcoin/database/tables/indexes/height.hpp>
+#include <bitcoin/database/tables/indexes/lineage.hpp>
+#include <bitcoin/database/tables/indexes/strong.hpp>
 #include <bitcoin/database/tables/indexes/strong_tx.hpp>
 
 #include <bitcoin/database/tables/optionals/address.hpp>
@@ -42,6 +42,8 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { reload_locked, "reloading locked file" },
     { flush_unloaded, "flushing unloaded file" },
     { flush_failure, "file failed to flush" },
+    { sync_unloaded, "syncing unloaded file" },
+    { sync_failure, "file failed to sync" },
     { unload_locked, "unloading locked file" },
     { unload_failure, "file failed to unload" },
 
@@ -52,6 +54,9 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { munmap_failure, "munmap failure" },
     { madvise_failure, "madvise failure" },
     { ftruncate_failure, "ftruncate failure" },
+    { fallocate_failure, "fallocate failure" },
+    { pread_failure, "pread failure" },
+    { pwrite_failure, "pwrite failure" },
     { fsync_failure, "fsync failure" },
 
     // locks
@@ -69,6 +74,7 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     // store
     { missing_snapshot, "missing snapshot" },
     { unloaded_file, "file not loaded" },
+    { store_format, "store format version not supported" },
 
     // tables
     { create_table, "failed to create table" },
@@ -76,6 +82,9 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { backup_table, "failed to backup table" },
     { restore_table, "failed to restore table" },
     { verify_table, "failed to verify table" },
+    { maintain_table, "failed to maintain table" },
+    { scan_table, "failed to scan table" },
+    { scan_stopped, "table scan stopped" },
 
     // states
     { tx_connected, "transaction connected" },
@@ -111,6 +120,8 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
 
     // header archive
     { header_put, "header_put" },
+    { header_lineage_set, "header_lineage_set" },
+    { header_reserve, "header_reserve" },
 
     // txs archive
     { txs_header, "txs_header" },
@@ -172,6 +172,55 @@ code create_file_ex(const path& to, const uint8_t* data, size_t size) NOEXCEPT
     }
 }
 
+bool read_file(const path& from, uint8_t* data, size_t size) NOEXCEPT
+{
+    return !read_file_ex(from, data, size);
+}
+
+code read_file_ex(const path& from, uint8_t* data, size_t size) NOEXCEPT
+{
+    size_t out{};
+    if (const auto ec = size_ex(out, from))
+        return ec;
+
+    if (out != size)
+        return system::error::errorno_t::invalid_argument;
+
+    // Binary mode on Windows ensures that \r\n not replaced with \n.
+    try
+    {
+        // Throws.
+        ifstream file(from, std::ios_base::binary);
+
+        // Allow throw.
+        file.exceptions(std::ifstream::failbit);
+
+        // noexcept.
+        if (!file.good())
+            return system::error::errorno_t::not_a_stream;
+
+        // May throw.
+        file.read(pointer_cast<char>(data), size);
+
+        // noexcept.
+        if (!file.good())
+            return system::error::errorno_t::not_a_stream;
+
+        // Sets failbit (but not noexcept).
+        file.close();
+
+        // noexcept.
+        return file.good() ?
+            system::error::errorno_t::no_error :
+            system::error::errorno_t::stream_timeout;
+    }
+    catch (const std::ios_base::failure& e)
+    {
+        // Prefer throw, since we get a platform code.
+        return e.code();
+    }
+}
+
 // directory|file
 bool remove(const path& name) NOEXCEPT
 {
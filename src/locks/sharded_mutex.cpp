@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+
+#include <atomic>
+#include <thread>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_ARRAY_INDEXING)
+
+// Reader and writer each publish (seq_cst) before reading the other's state
+// (seq_cst), so at least one of any racing pair observes the other and backs
+// off. A reader never waits while holding its slot count, so recursive shared
+// locks cannot deadlock against a pending writer.
+
+sharded_mutex::sharded_mutex() NOEXCEPT
+{
+}
+
+// static
+size_t sharded_mutex::index() NOEXCEPT
+{
+    // Threads are assigned slots round robin upon first use of any instance.
+    static std::atomic<size_t> next{ zero };
+    thread_local const size_t slot = next.fetch_add(one) % slots;
+    return slot;
+}
+
+// A shared lock may be released on a thread other than the one that acquired
+// it, which moves one count between slots. So slots are summed (modulo) rather
+// than tested individually. A concurrent release can only cause a miscount in
+// the conservative direction.
+bool sharded_mutex::is_free() const NOEXCEPT
+{
+    size_t readers{};
+    for (const auto& slot: slots_)
+        readers += slot.readers.load();
+
+    return is_zero(readers);
+}
+
+// Exclusive.
+// ----------------------------------------------------------------------------
+
+void sharded_mutex::lock() NOEXCEPT
+{
+    while (!try_lock())
+        std::this_thread::yield();
+}
+
+bool sharded_mutex::try_lock() NOEXCEPT
+{
+    if (writer_.exchange(true))
+        return false;
+
+    if (is_free())
+        return true;
+
+    unlock();
+    return false;
+}
+
+void sharded_mutex::unlock() NOEXCEPT
+{
+    writer_.store(false);
+    writer_.notify_all();
+}
+
+// Shared.
+// ----------------------------------------------------------------------------
+
+void sharded_mutex::lock_shared() NOEXCEPT
+{
+    while (!try_lock_shared())
+        writer_.wait(true);
+}
+
+bool sharded_mutex::try_lock_shared() NOEXCEPT
+{
+    auto& readers = slots_[index()].readers;
+    readers.fetch_add(one);
+
+    if (!writer_.load())
+        return true;
+
+    readers.fetch_sub(one);
+    return false;
+}
+
+void sharded_mutex::unlock_shared() NOEXCEPT
+{
+    slots_[index()].readers.fetch_sub(one, std::memory_order_release);
+}
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace database
+} // namespace libbitcoin
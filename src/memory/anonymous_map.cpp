@@ -0,0 +1,766 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/database/memory/anonymous_map.hpp>
+
+#if defined(HAVE_MSC)
+    #include <io.h>
+    #include "mman-win32/mman.hpp"
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/types.h>
+    #include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
+#include <bitcoin/database/memory/utilities.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+using namespace system;
+
+constexpr auto fail = -1;
+
+anonymous_map::anonymous_map(const path& filename, size_t minimum,
+    size_t expansion, size_t reserve, advice hint, bool preallocate) NOEXCEPT
+  : filename_(filename), minimum_(minimum), expansion_(expansion),
+    reserve_(reserve), advice_(hint), preallocate_(preallocate)
+{
+}
+
+anonymous_map::~anonymous_map() NOEXCEPT
+{
+    BC_ASSERT_MSG(!loaded_, "memory allocated at destruct");
+    BC_ASSERT_MSG(is_null(memory_), "memory defined at destruct");
+    BC_ASSERT_MSG(is_zero(logical_.load()), "logical nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(capacity_.load()), "capacity nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(reserved_), "reservation nonzero at destruct");
+    BC_ASSERT_MSG(opened_ == file::invalid, "file open at destruct");
+}
+
+const std::filesystem::path& anonymous_map::file() const NOEXCEPT
+{
+    return filename_;
+}
+
+code anonymous_map::open() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (opened_ != file::invalid)
+        return error::open_open;
+
+    if (const auto ec = file::open_ex(opened_, filename_))
+        return ec;
+
+    size_t logical{};
+    const auto ec = file::size_ex(logical, opened_);
+    logical_.store(logical);
+    return ec;
+}
+
+code anonymous_map::close() NOEXCEPT
+{
+    std::unique_lock map_lock(remap_mutex_);
+    std::unique_lock field_lock(field_mutex_);
+
+    if (loaded_)
+        return error::close_loaded;
+
+    if (opened_ == file::invalid)
+        return error::success;
+
+    const auto descriptor = opened_;
+    opened_ = file::invalid;
+    logical_ = zero;
+
+    return file::close_ex(descriptor);
+}
+
+bool anonymous_map::is_open() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return opened_ != file::invalid;
+}
+
+// load, flush, unload.
+// ----------------------------------------------------------------------------
+// Each accessor holds a shared lock on remap_mutex_ (read/write access to
+// memory). Exclusive lock on remap_mutex_ ensures there are open accessor
+// objects, which allows for safely moving the memory.
+
+code anonymous_map::load() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::load_loaded;
+        }
+
+        // Updates fields.
+        const auto logical = logical_.load();
+        if (!map_(std::max(logical, minimum_)) || !read_(logical))
+        {
+            release_();
+            remap_mutex_.unlock();
+            return error::load_failure;
+        }
+
+        // Loaded file content is presumed flushed.
+        flushed_.store(logical);
+        remap_mutex_.unlock();
+        return error::success;
+    }
+
+    return error::load_locked;
+}
+
+// Suspend writes before calling.
+code anonymous_map::reload() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (!loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::reload_unloaded;
+        }
+
+        // Allow resume from disk (memory) full.
+        set_disk_space(zero);
+
+        remap_mutex_.unlock();
+        return error::success;
+    }
+
+    return error::reload_locked;
+}
+
+// Suspend writes before calling.
+code anonymous_map::flush() NOEXCEPT
+{
+    // Prevent unload, resize, remap.
+    std::shared_lock map_lock(remap_mutex_);
+    std::shared_lock field_lock(field_mutex_);
+
+    if (!loaded_)
+        return error::flush_unloaded;
+
+    // The full image is written, as any part of it may have been modified.
+    const auto end = logical_.load();
+    if (!write_(end))
+        return error::flush_failure;
+
+    if ((::ftruncate(opened_, end) == fail) || (::fsync(opened_) == fail))
+    {
+        set_first_code(error::fsync_failure);
+        return error::flush_failure;
+    }
+
+    flushed_.store(end);
+    return error::success;
+}
+
+code anonymous_map::sync() NOEXCEPT
+{
+    // loaded_ update is precluded by remap_mutex_ (atomic read).
+    std::shared_lock map_lock(remap_mutex_);
+    return loaded_ ? error::success : error::sync_unloaded;
+}
+
+// Suspend writes before calling.
+code anonymous_map::unload() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (!loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::success;
+        }
+
+        BC_ASSERT_MSG(logical_ <= capacity_, "logical size exceeds capacity");
+
+        // The full image is written (as with flush), so that the file is
+        // consistent upon close. Memory is retained upon failure (restartable).
+        const auto end = logical_.load();
+        if (!write_(end))
+        {
+            remap_mutex_.unlock();
+            return error::unload_failure;
+        }
+
+        if ((::ftruncate(opened_, end) == fail) || (::fsync(opened_) == fail))
+        {
+            set_first_code(error::fsync_failure);
+            remap_mutex_.unlock();
+            return error::unload_failure;
+        }
+
+        // Updates fields.
+        if (!release_())
+        {
+            remap_mutex_.unlock();
+            return error::unload_failure;
+        }
+
+        flushed_.store(end);
+        remap_mutex_.unlock();
+        return error::success;
+    }
+
+    return error::unload_locked;
+}
+
+bool anonymous_map::is_loaded() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return loaded_;
+}
+
+// Interface.
+// ----------------------------------------------------------------------------
+
+// Logical size is read without field_mutex_ so that get() does not contend.
+size_t anonymous_map::size() const NOEXCEPT
+{
+    return logical_.load();
+}
+
+size_t anonymous_map::capacity() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return capacity_;
+}
+
+size_t anonymous_map::pending() const NOEXCEPT
+{
+    return zero;
+}
+
+size_t anonymous_map::lag() const NOEXCEPT
+{
+    return floored_subtract(size(), flushed_.load());
+}
+
+size_t anonymous_map::reserved() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return reserved_;
+}
+
+bool anonymous_map::truncate(size_t size) NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (size > logical_)
+        return false;
+
+    logical_ = size;
+    flushed_.store(std::min(flushed_.load(), size));
+    return true;
+}
+
+// Allocation within capacity is lock-free (see map::allocate).
+size_t anonymous_map::allocate(size_t chunk) NOEXCEPT
+{
+    auto logical = logical_.load();
+    while (!is_add_overflow(logical, chunk) &&
+        (logical + chunk <= capacity_.load()) &&
+        (error_.load() == error::success))
+    {
+        if (logical_.compare_exchange_weak(logical, logical + chunk))
+            return logical;
+    }
+
+    std::unique_lock field_lock(field_mutex_);
+
+    // Lock-free allocation may advance logical concurrently (retry).
+    logical = logical_.load();
+    while (true)
+    {
+        if (fault_ || !loaded_ || is_add_overflow(logical, chunk))
+            return storage::eof;
+
+        const auto end = logical + chunk;
+        if (end > capacity_ && end <= reserved_)
+        {
+            // Memory full condition leaves store in valid state despite eof.
+            if (!extend_(std::min(to_capacity(end), reserved_)))
+                return storage::eof;
+        }
+        else if (end > capacity_)
+        {
+            const auto size = to_capacity(end);
+            std::unique_lock remap_lock(remap_mutex_);
+
+            // Memory full condition leaves store in valid state despite eof.
+            if (!remap_(size))
+                return storage::eof;
+        }
+
+        if (logical_.compare_exchange_strong(logical, end))
+            return logical;
+    }
+}
+
+memory_ptr anonymous_map::get(size_t offset) const NOEXCEPT
+{
+    // Obtaining logical before access prevents mutual mutex wait (deadlock).
+    const auto logical = size();
+
+    // Takes a shared lock on remap_mutex_ until destruct, blocking remap.
+    const auto ptr = std::allocate_shared<access>(allocator{}, remap_mutex_);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_ || is_null(ptr))
+        return nullptr;
+
+    // With offset > size the assignment is negative (stream is exhausted).
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    ptr->assign(memory_ + offset, memory_ + logical);
+    BC_POP_WARNING()
+    return ptr;
+}
+
+memory_ptr anonymous_map::get_write(size_t offset) const NOEXCEPT
+{
+    // The full image is written back (no write detection).
+    return get(offset);
+}
+
+memory_ptr anonymous_map::get_exclusive(size_t offset) const NOEXCEPT
+{
+    // Takes an exclusive lock on remap_mutex_ until destruct, blocking all
+    // accessors and remap. Logical is lock-free, and may only increase while
+    // held (allocation), with writes to allocation precluded by the lock.
+    const auto ptr = std::make_shared<exclusive>(remap_mutex_);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_ || is_null(ptr))
+        return nullptr;
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    ptr->assign(memory_ + offset, memory_ + size());
+    BC_POP_WARNING()
+    return ptr;
+}
+
+memory::iterator anonymous_map::get_raw(size_t offset) const NOEXCEPT
+{
+    // Pointer is otherwise unguarded, not remap safe (use for table heads).
+    if (offset > size())
+        return nullptr;
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    return memory_ + offset;
+    BC_POP_WARNING()
+}
+
+code anonymous_map::get_fault() const NOEXCEPT
+{
+    return error_.load();
+}
+
+size_t anonymous_map::get_space() const NOEXCEPT
+{
+    return space_.load();
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+size_t anonymous_map::to_capacity(size_t required) const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_STATIC_CAST)
+    const auto resize = required * ((expansion_ + 100.0) / 100.0);
+    const auto target = std::max(minimum_, static_cast<size_t>(resize));
+    BC_POP_WARNING()
+
+    BC_ASSERT(target >= required);
+    return target;
+}
+
+// Read-write protected by atomic, write-write protected by remap_mutex.
+void anonymous_map::set_first_code(const error::error_t& ec) NOEXCEPT
+{
+    if (!fault_)
+    {
+        // fault is not exposed so requires no atomic (fast read).
+        fault_ = true;
+
+        // error is atomic for public read exposure.
+        error_.store(ec);
+    }
+}
+
+void anonymous_map::set_disk_space(size_t required) NOEXCEPT
+{
+    space_.store(required);
+}
+
+// private, mman wrappers, not thread safe
+// ----------------------------------------------------------------------------
+
+constexpr auto anonymous_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if !defined(HAVE_MSC)
+    #if defined(MAP_NORESERVE)
+        constexpr auto reserve_flags = anonymous_flags | MAP_NORESERVE;
+    #else
+        constexpr auto reserve_flags = anonymous_flags;
+    #endif
+#endif
+
+// Round up to a multiple of page size (unrounded if page size unavailable).
+inline size_t to_page(size_t size) NOEXCEPT
+{
+    const auto page = page_size();
+    if (is_zero(page) || is_add_overflow(size, sub1(page)))
+        return size;
+
+    return ((size + sub1(page)) / page) * page;
+}
+
+// Round down to a multiple of page size (zero if page size unavailable).
+inline size_t to_page_floor(size_t size) NOEXCEPT
+{
+    const auto page = page_size();
+    return is_zero(page) ? zero : size - (size % page);
+}
+
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+
+// Reads [0, size) of the file into memory (size cannot exceed capacity).
+bool anonymous_map::read_(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size <= capacity_);
+
+    for (size_t read{}; read < size;)
+    {
+#if defined(HAVE_MSC)
+        const auto bytes = std::min<size_t>(size - read, max_int32);
+        const auto result = (::_lseeki64(opened_, read, SEEK_SET) == fail) ?
+            fail : ::_read(opened_, memory_ + read,
+                possible_narrow_cast<unsigned>(bytes));
+#else
+        const auto result = ::pread(opened_, memory_ + read, size - read,
+            read);
+#endif
+        if (is_negative(result) && errno == EINTR)
+            continue;
+
+        if (is_negative(result))
+        {
+            set_first_code(error::pread_failure);
+            return false;
+        }
+
+        // Unexpected end of file leaves the remainder zeroed.
+        if (is_zero(result))
+            break;
+
+        read += to_unsigned(result);
+    }
+
+    return true;
+}
+
+// Writes [0, size) of memory to the file.
+// disk_full: space is set but no code is set with false return.
+bool anonymous_map::write_(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size <= capacity_);
+
+    for (size_t written{}; written < size;)
+    {
+#if defined(HAVE_MSC)
+        const auto bytes = std::min<size_t>(size - written, max_int32);
+        const auto result = (::_lseeki64(opened_, written, SEEK_SET) == fail) ?
+            fail : ::_write(opened_, memory_ + written,
+                possible_narrow_cast<unsigned>(bytes));
+#else
+        const auto result = ::pwrite(opened_, memory_ + written,
+            size - written, written);
+#endif
+        if (is_negative(result) && errno == EINTR)
+            continue;
+
+        if (is_negative(result))
+        {
+            // Disk full is restartable (memory is unaffected).
+            if (errno == ENOSPC)
+                set_disk_space(size - written);
+            else
+                set_first_code(error::pwrite_failure);
+
+            return false;
+        }
+
+        written += to_unsigned(result);
+    }
+
+    return true;
+}
+
+// Always results in unloaded.
+bool anonymous_map::release_() NOEXCEPT
+{
+    const auto success = is_null(memory_) ||
+        (::munmap(memory_, std::max(capacity_.load(), reserved_)) != fail);
+
+    if (!success)
+        set_first_code(error::munmap_failure);
+
+    loaded_ = false;
+    capacity_ = zero;
+    reserved_ = zero;
+    memory_ = {};
+    return success;
+}
+
+// Allocation failure results in unloaded.
+bool anonymous_map::map_(size_t size) NOEXCEPT
+{
+    void* memory{ MAP_FAILED };
+
+#if !defined(HAVE_MSC)
+    // Reserve address space and commit its base. Reservation is inaccessible
+    // (PROT_NONE) and uncommitted, so it costs no memory.
+    if (reserve_ > size)
+    {
+        const auto base = ::mmap(nullptr, reserve_, PROT_NONE, reserve_flags,
+            -1, 0);
+
+        // Reservation failure falls back to an unreserved allocation.
+        if (base != MAP_FAILED)
+        {
+            memory = ::mmap(base, size, PROT_READ | PROT_WRITE,
+                anonymous_flags | MAP_FIXED, -1, 0);
+
+            if (memory == MAP_FAILED)
+                ::munmap(base, reserve_);
+            else
+                reserved_ = reserve_;
+        }
+    }
+#endif
+
+    if (memory == MAP_FAILED)
+        memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+            anonymous_flags, -1, 0);
+
+    if (memory == MAP_FAILED)
+    {
+        set_first_code(error::mmap_failure);
+        return false;
+    }
+
+    memory_ = pointer_cast<uint8_t>(memory);
+    capacity_ = size;
+    loaded_ = true;
+    return advise_(zero, size) && populate_(zero, size);
+}
+
+// Remap failure retains the prior memory (memory is not file-backed).
+bool anonymous_map::remap_(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size > capacity_);
+
+#if !defined(HAVE_MSC) && defined(MREMAP_MAYMOVE)
+    const auto memory = ::mremap(memory_, capacity_, size, MREMAP_MAYMOVE);
+#else
+    // Without mremap the memory is copied to a new allocation.
+    auto memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+        anonymous_flags, -1, 0);
+
+    if (memory != MAP_FAILED)
+    {
+        std::memcpy(memory, memory_, capacity_.load());
+        if (::munmap(memory_, capacity_) == fail)
+        {
+            ::munmap(memory, size);
+            memory = MAP_FAILED;
+        }
+    }
+#endif
+
+    if (memory == MAP_FAILED)
+    {
+        // Memory exhaustion is restartable, as prior memory is retained.
+        if (errno == ENOMEM)
+            set_disk_space(size - logical_);
+        else
+            set_first_code(error::mremap_failure);
+
+        return false;
+    }
+
+    // Growth beyond the reservation releases its uncommitted tail, but only
+    // once resized, so that a failed (restartable) remap retains reservation.
+    const auto prior = memory_;
+    const auto mapped = to_page(capacity_);
+    const auto start = to_page_floor(capacity_);
+    memory_ = pointer_cast<uint8_t>(memory);
+    capacity_ = size;
+
+    if (!is_zero(reserved_))
+    {
+        const auto reserved = reserved_;
+        reserved_ = zero;
+        if ((reserved > mapped) &&
+            (::munmap(prior + mapped, reserved - mapped) == fail))
+        {
+            set_first_code(error::munmap_failure);
+            return false;
+        }
+    }
+
+    return advise_(start, size) && populate_(start, size);
+}
+
+// Extension failure does not release, since readers are not excluded.
+// Growth within reservation commits pages over the reservation in place.
+bool anonymous_map::extend_(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size > capacity_ && size <= reserved_);
+
+#if defined(HAVE_MSC)
+    return false;
+#else
+    // Pages below the rounded capacity are already committed (and in use).
+    const auto start = to_page(capacity_);
+    const auto end = to_page(size);
+    if ((end > start) && (::mmap(memory_ + start, end - start,
+        PROT_READ | PROT_WRITE, anonymous_flags | MAP_FIXED, -1, 0) ==
+        MAP_FAILED))
+    {
+        if (errno == ENOMEM)
+            set_disk_space(size - logical_);
+        else
+            set_first_code(error::mmap_failure);
+
+        return false;
+    }
+
+    const auto floor = to_page_floor(capacity_);
+    if (!advise_(floor, size) || !populate_(floor, size))
+        return false;
+
+    capacity_ = size;
+    return true;
+#endif
+}
+
+// Commits memory of the range [start, size) with preallocation, so that
+// memory exhaustion surfaces here rather than upon page fault. Start must be
+// page aligned. Unsupported by platform or kernel is not a fault.
+// memory_full: space is set but no code is set with false return.
+bool anonymous_map::populate_(size_t start, size_t size) NOEXCEPT
+{
+    BC_ASSERT(size >= start);
+
+#if defined(MADV_POPULATE_WRITE)
+    if (!preallocate_ || size == start)
+        return true;
+
+    if (::madvise(memory_ + start, size - start, MADV_POPULATE_WRITE) != fail)
+        return true;
+
+    if (errno == ENOMEM)
+    {
+        set_disk_space(size - start);
+        return false;
+    }
+
+    return true;
+#else
+    return true;
+#endif
+}
+
+// Advice applies to the range [start, size), start must be page aligned. A
+// new mapping does not inherit advice, so this is applied upon each map,
+// remap and extension. Hugepage advice failure is not a fault.
+bool anonymous_map::advise_(size_t start, size_t size) NOEXCEPT
+{
+    BC_ASSERT(size >= start);
+
+    int hint{};
+    switch (advice_)
+    {
+        case advice::normal:
+            hint = MADV_NORMAL;
+            break;
+        case advice::random:
+            hint = MADV_RANDOM;
+            break;
+        case advice::sequential:
+            hint = MADV_SEQUENTIAL;
+            break;
+        case advice::willneed:
+            hint = MADV_WILLNEED;
+            break;
+        case advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+            hint = MADV_HUGEPAGE;
+            break;
+#else
+            return true;
+#endif
+    }
+
+    const auto success = ::madvise(memory_ + start, size - start, hint)
+        != fail;
+
+    if (success || advice_ == advice::hugepage)
+        return true;
+
+    set_first_code(error::madvise_failure);
+    return false;
+}
+
+BC_POP_WARNING()
+
+BC_POP_WARNING()
+
+} // namespace database
+} // namespace libbitcoin
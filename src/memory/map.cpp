@@ -35,6 +35,9 @@
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/error.hpp>
 #include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
+#include <bitcoin/database/memory/utilities.hpp>
 
 namespace libbitcoin {
 namespace database {
@@ -43,8 +46,10 @@ BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 using namespace system;
 
-map::map(const path& filename, size_t minimum, size_t expansion) NOEXCEPT
-  : filename_(filename), minimum_(minimum), expansion_(expansion)
+map::map(const path& filename, size_t minimum, size_t expansion,
+    size_t reserve, advice hint, bool preallocate) NOEXCEPT
+  : filename_(filename), minimum_(minimum), expansion_(expansion),
+    reserve_(reserve), advice_(hint), preallocate_(preallocate)
 {
 }
 
@@ -52,8 +57,9 @@ map::~map() NOEXCEPT
 {
     BC_ASSERT_MSG(!loaded_, "file mapped at destruct");
     BC_ASSERT_MSG(is_null(memory_map_), "map defined at destruct");
-    BC_ASSERT_MSG(is_zero(logical_), "logical nonzero at destruct");
-    BC_ASSERT_MSG(is_zero(capacity_), "capacity nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(logical_.load()), "logical nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(capacity_.load()), "capacity nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(reserved_), "reservation nonzero at destruct");
     BC_ASSERT_MSG(opened_ == file::invalid, "file open at destruct");
 }
 
@@ -72,7 +78,10 @@ code map::open() NOEXCEPT
     if (const auto ec = file::open_ex(opened_, filename_))
         return ec;
 
-    return file::size_ex(logical_, opened_);
+    size_t logical{};
+    const auto ec = file::size_ex(logical, opened_);
+    logical_.store(logical);
+    return ec;
 }
 
 code map::close() NOEXCEPT
@@ -124,6 +133,9 @@ code map::load() NOEXCEPT
             return error::load_failure;
         }
 
+        // Loaded file content is presumed flushed.
+        synced_.store(logical_.load());
+        flushed_.store(logical_.load());
         remap_mutex_.unlock();
         return error::success;
     }
@@ -165,7 +177,37 @@ code map::flush() NOEXCEPT
         return error::flush_unloaded;
 
     // Reads fields and the memory map.
-    return flush_() ? error::success : error::flush_failure;
+    const auto end = logical_.load();
+    if (!flush_())
+        return error::flush_failure;
+
+    synced_.store(end);
+    flushed_.store(end);
+    return error::success;
+}
+
+// Does not suspend writes.
+code map::sync() NOEXCEPT
+{
+    // Prevent unload, resize, remap. The field lock is not held, so that
+    // allocation is not suspended for the call (unless it requires remap).
+    std::shared_lock map_lock(remap_mutex_);
+
+    // loaded_/opened_ update is precluded by remap_mutex_ (atomic reads).
+    if (!loaded_)
+        return error::sync_unloaded;
+
+    // Logical may change during the call, only the range read is synced.
+    const auto end = size();
+    const auto start = std::min(synced_.load(), end);
+    if (start == end)
+        return error::success;
+
+    if (!sync_(start, end))
+        return error::sync_failure;
+
+    synced_.store(end);
+    return error::success;
 }
 
 // Suspend writes before calling.
@@ -206,10 +248,10 @@ bool map::is_loaded() const NOEXCEPT
 // Interface.
 // ----------------------------------------------------------------------------
 
+// Logical size is read without field_mutex_ so that get() does not contend.
 size_t map::size() const NOEXCEPT
 {
-    std::shared_lock field_lock(field_mutex_);
-    return logical_;
+    return logical_.load();
 }
 
 size_t map::capacity() const NOEXCEPT
@@ -218,6 +260,22 @@ size_t map::capacity() const NOEXCEPT
     return capacity_;
 }
 
+size_t map::pending() const NOEXCEPT
+{
+    return floored_subtract(size(), synced_.load());
+}
+
+size_t map::lag() const NOEXCEPT
+{
+    return floored_subtract(size(), flushed_.load());
+}
+
+size_t map::reserved() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return reserved_;
+}
+
 bool map::truncate(size_t size) NOEXCEPT
 {
     std::unique_lock field_lock(field_mutex_);
@@ -225,35 +283,64 @@ bool map::truncate(size_t size) NOEXCEPT
     if (size > logical_)
         return false;
 
+    // Truncated range may be rewritten, so it must be synced again.
     logical_ = size;
+    synced_.store(std::min(synced_.load(), size));
+    flushed_.store(std::min(flushed_.load(), size));
     return true;
 }
 
-// Waits until all access pointers are destructed. Will deadlock if any access
-// pointer is waiting on allocation. Lock safety requires that access pointers
-// are short-lived and do not block on allocation.
+// Allocation within capacity is a lock-free bump of logical size, so that
+// concurrent writers do not contend on field_mutex_. Growth requires the
+// exclusive field lock, and remap additionally waits until all access pointers
+// are destructed. Will deadlock if any access pointer is waiting on
+// allocation. Lock safety requires that access pointers are short-lived and do
+// not block on allocation. Growth within reserved address space does not move
+// the map, so it neither waits nor deadlocks.
 size_t map::allocate(size_t chunk) NOEXCEPT
 {
-    std::unique_lock field_lock(field_mutex_);
+    // Capacity is zero when unloaded and error is set upon fault, and both
+    // are only otherwise reduced with writes suspended.
+    auto logical = logical_.load();
+    while (!is_add_overflow(logical, chunk) &&
+        (logical + chunk <= capacity_.load()) &&
+        (error_.load() == error::success))
+    {
+        if (logical_.compare_exchange_weak(logical, logical + chunk))
+            return logical;
+    }
 
-    if (fault_ || !loaded_ || is_add_overflow(logical_, chunk))
-        return storage::eof;
+    std::unique_lock field_lock(field_mutex_);
 
-    auto end = logical_ + chunk;
-    if (end > capacity_)
+    // Lock-free allocation may advance logical concurrently (retry).
+    logical = logical_.load();
+    while (true)
     {
-        const auto size = to_capacity(end);
+        if (fault_ || !loaded_ || is_add_overflow(logical, chunk))
+            return storage::eof;
 
-        // TODO: Could loop over a try lock here and log deadlock warning.
-        std::unique_lock remap_lock(remap_mutex_);
+        const auto end = logical + chunk;
+        if (end > capacity_ && end <= reserved_)
+        {
+            // Disk full condition leaves store in valid state despite eof.
+            if (!extend_(std::min(to_capacity(end), reserved_)))
+                return storage::eof;
+        }
+        else if (end > capacity_)
+        {
+            const auto size = to_capacity(end);
 
-        // Disk full condition leaves store in valid state despite eof return.
-        if (!remap_(size))
-            return storage::eof;
-    }
+            // TODO: Could loop over a try lock here and log deadlock warning.
+            std::unique_lock remap_lock(remap_mutex_);
+
+            // Disk full condition leaves store in valid state despite eof.
+            if (!remap_(size))
+                return storage::eof;
+        }
 
-    std::swap(logical_, end);
-    return end;
+        if (logical_.compare_exchange_strong(logical, end))
+            return logical;
+    }
 }
 
 memory_ptr map::get(size_t offset) const NOEXCEPT
@@ -267,7 +354,8 @@ memory_ptr map::get(size_t offset) const NOEXCEPT
     const auto logical = size();
 
     // Takes a shared lock on remap_mutex_ until destruct, blocking remap.
-    const auto ptr = std::make_shared<access>(remap_mutex_);
+    // Accessor and control block are recycled per thread (no heap once warm).
+    const auto ptr = std::allocate_shared<access>(allocator{}, remap_mutex_);
 
     // loaded_ update is precluded by remap_mutex_, making this read atomic.
     if (!loaded_ || is_null(ptr))
@@ -280,6 +368,29 @@ memory_ptr map::get(size_t offset) const NOEXCEPT
     return ptr;
 }
 
+memory_ptr map::get_write(size_t offset) const NOEXCEPT
+{
+    // Mapped memory is written back by the kernel (no write detection).
+    return get(offset);
+}
+
+memory_ptr map::get_exclusive(size_t offset) const NOEXCEPT
+{
+    // Takes an exclusive lock on remap_mutex_ until destruct, blocking all
+    // accessors and remap. Logical is lock-free, and may only increase while
+    // held (allocation), with writes to allocation precluded by the lock.
+    const auto ptr = std::make_shared<exclusive>(remap_mutex_);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_ || is_null(ptr))
+        return nullptr;
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    ptr->assign(memory_map_ + offset, memory_map_ + size());
+    BC_POP_WARNING()
+    return ptr;
+}
+
 memory::iterator map::get_raw(size_t offset) const NOEXCEPT
 {
     // Pointer is otherwise unguarded, not remap safe (use for table heads).
@@ -340,6 +451,25 @@ void map::set_disk_space(size_t required) NOEXCEPT
 
 constexpr auto fail = -1;
 
+#if !defined(HAVE_MSC)
+    #if defined(MAP_NORESERVE)
+        constexpr auto reserve_flags = MAP_PRIVATE | MAP_ANONYMOUS |
+            MAP_NORESERVE;
+    #else
+        constexpr auto reserve_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    #endif
+#endif
+
+// Round up to a multiple of page size (unrounded if page size unavailable).
+inline size_t to_page(size_t size) NOEXCEPT
+{
+    const auto page = page_size();
+    if (is_zero(page) || is_add_overflow(size, sub1(page)))
+        return size;
+
+    return ((size + sub1(page)) / page) * page;
+}
+
 // Never results in unmapped.
 bool map::flush_() NOEXCEPT
 {
@@ -371,6 +501,28 @@ bool map::flush_() NOEXCEPT
     return success;
 }
 
+// Never results in unmapped.
+// Initiates writeback of the file range, does not wait or update metadata.
+bool map::sync_(size_t start, size_t end) NOEXCEPT
+{
+    BC_ASSERT(end > start);
+
+#if defined(SYNC_FILE_RANGE_WRITE)
+    // Linux: "Initiate write-out of all dirty pages in the specified range
+    // which are not presently submitted write-out."
+    return ::sync_file_range(opened_, start, end - start,
+        SYNC_FILE_RANGE_WRITE) != fail;
+#else
+    // msync requires a page-aligned address (MS_ASYNC schedules writeback).
+    const auto page = page_size();
+    const auto first = is_zero(page) ? zero : start - (start % page);
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    return ::msync(memory_map_ + first, end - first, MS_ASYNC) != fail;
+    BC_POP_WARNING()
+#endif
+}
+
 // Always results in unmapped.
 // Trims to logical size, can be zero.
 bool map::unmap_() NOEXCEPT
@@ -382,19 +534,26 @@ bool map::unmap_() NOEXCEPT
         && (::ftruncate(opened_, logical_) != fail)
         && (::fsync(opened_) != fail);
 #else
+    // Unmapping the reservation also unmaps the file mapped within it.
     const auto success = (::ftruncate(opened_, logical_) != fail)
     #if defined(F_FULLFSYNC)
         && (::fcntl(opened_, F_FULLFSYNC, 0) != fail)
     #else
         && (::fsync(opened_) != fail)
     #endif
-        && (::munmap(memory_map_, capacity_) != fail);
+        && (::munmap(memory_map_, std::max(capacity_.load(), reserved_)) != fail);
 #endif
     if (!success)
         set_first_code(error::munmap_failure);
+    else
+    {
+        synced_.store(logical_.load());
+        flushed_.store(logical_.load());
+    }
 
     loaded_ = false;
     capacity_ = zero;
+    reserved_ = zero;
     memory_map_ = {};
     return success;
 }
@@ -403,17 +562,41 @@ bool map::unmap_() NOEXCEPT
 // Mapping has no effect on logical size, always maps max(logical, min) size.
 bool map::map_() NOEXCEPT
 {
-    auto size = logical_;
+    auto size = logical_.load();
 
     // Cannot map empty file, and want mininum capacity, so expand as required.
     // disk_full: space is set but no code is set with false return.
     if ((size < minimum_) && !resize_((size = minimum_)))
       return false;
 
+#if !defined(HAVE_MSC)
+    // Reserve address space and map the file at its base. Reservation is
+    // inaccessible (PROT_NONE) and uncommitted, so it costs no memory.
+    if (reserve_ > size)
+    {
+        const auto base = ::mmap(nullptr, reserve_, PROT_NONE, reserve_flags,
+            -1, 0);
+
+        // Reservation failure falls back to an unreserved map.
+        if (base != MAP_FAILED)
+        {
+            memory_map_ = pointer_cast<uint8_t>(::mmap(base, size,
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, opened_, 0));
+
+            if (memory_map_ == MAP_FAILED)
+                ::munmap(base, reserve_);
+            else
+                reserved_ = reserve_;
+
+            return finalize_(size, zero);
+        }
+    }
+#endif
+
     memory_map_ = pointer_cast<uint8_t>(::mmap(nullptr, size,
         PROT_READ | PROT_WRITE, MAP_SHARED, opened_, 0));
 
-    return finalize_(size);
+    return finalize_(size, zero);
 }
 
 // Remap failure results in unmapped.
@@ -440,30 +623,112 @@ bool map::remap_(size_t size) NOEXCEPT
     }
 #else
     // disk_full: space is set but no code is set with false return.
+    // The reservation is retained, as disk full is recoverable.
     if (!resize_(size))
         return false;
 #endif
 
+    // Growth beyond the reservation releases its unmapped tail and may move.
+    // This follows resize, so a disk full failure does not lose the reserve.
+    // macOS: unmap_ has already released the reservation (zero).
+    if (!is_zero(reserved_))
+    {
+        const auto mapped = to_page(capacity_);
+
+        BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+        const auto tail = memory_map_ + mapped;
+        BC_POP_WARNING()
+
+        if ((reserved_ > mapped) && (::munmap(tail, reserved_ - mapped) == fail))
+        {
+            set_first_code(error::munmap_failure);
+            unmap_();
+            return false;
+        }
+
+        reserved_ = zero;
+    }
+
 #if defined(HAVE_MSC)
     // mman-win32 mremap hack (umap/map) requires flags and file descriptor.
     memory_map_ = pointer_cast<uint8_t>(::mremap_(memory_map_, capacity_, size,
         PROT_READ | PROT_WRITE, MAP_SHARED, opened_));
+    return finalize_(size, zero);
 #elif defined(MREMAP_MAYMOVE)
+    // Resized mapping retains its advice, so only the growth is advised.
+    const auto page = page_size();
+    const auto start = is_zero(page) ? zero : capacity_ - (capacity_ % page);
     memory_map_ = pointer_cast<uint8_t>(::mremap(memory_map_, capacity_, size,
         MREMAP_MAYMOVE));
+    return finalize_(size, std::min(start, size));
 #else
     // macOS: does not define mremap or MREMAP_MAYMOVE.
     // TODO: see "MREMAP_MAYMOVE" in sqlite for map extension technique.
     memory_map_ = pointer_cast<uint8_t>(::mmap(nullptr, size,
         PROT_READ | PROT_WRITE, MAP_SHARED, opened_, 0));
+    return finalize_(size, zero);
 #endif
+}
+
+// Extension failure does not unmap, since readers are not excluded.
+// Growth within reservation maps file pages over the reservation in place.
+bool map::extend_(size_t size) NOEXCEPT
+{
+    BC_ASSERT(size > capacity_ && size <= reserved_);
+
+#if defined(HAVE_MSC)
+    return false;
+#else
+    if (!fallocate_(size))
+        return false;
+
+    if (::ftruncate(opened_, size) == fail)
+    {
+        // Disk full is restartable, any other failure is an abort.
+        if (errno == ENOSPC)
+            set_disk_space(size - logical_);
+        else
+            set_first_code(error::ftruncate_failure);
+
+        return false;
+    }
+
+    // The last page of the current map is remapped for the offset alignment.
+    // This replaces the same shared file page, so concurrent access is safe.
+    const auto page = page_size();
+    const auto start = is_zero(page) ? zero : capacity_ - (capacity_ % page);
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    const auto extended = ::mmap(memory_map_ + start, size - start,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, opened_, start);
+    BC_POP_WARNING()
+
+    if (extended == MAP_FAILED)
+    {
+        set_first_code(error::mmap_failure);
+        return false;
+    }
+
+    if (!advise_(start, size))
+        return false;
 
-    return finalize_(size);
+    capacity_ = size;
+    return true;
+#endif
 }
 
 // disk_full: space is set but no code is set with false return.
 bool map::resize_(size_t size) NOEXCEPT
 {
+    // disk_full: space is set but no code is set with false return.
+    if (!fallocate_(size))
+    {
+        if (fault_)
+            unmap_();
+
+        return false;
+    }
+
     // Disk full detection is platform common, any other failure is an abort.
     if (::ftruncate(opened_, size) == fail)
     {
@@ -482,8 +747,41 @@ bool map::resize_(size_t size) NOEXCEPT
     return true;
 }
 
+// Never results in unmapped.
+// Allocates disk space for growth beyond capacity without changing file size
+// (ftruncate then sets the size over allocated extents). This surfaces disk
+// full here, rather than upon page fault, and keeps extents contiguous.
+// disk_full: space is set but no code is set with false return.
+bool map::fallocate_(size_t size) NOEXCEPT
+{
+#if defined(FALLOC_FL_KEEP_SIZE)
+    if (!preallocate_ || size <= capacity_)
+        return true;
+
+    if (::fallocate(opened_, FALLOC_FL_KEEP_SIZE, capacity_,
+        size - capacity_) != fail)
+        return true;
+
+    // Disk full is restartable.
+    if (errno == ENOSPC)
+    {
+        set_disk_space(size - logical_);
+        return false;
+    }
+
+    // Unsupported by file system, fall back to sparse growth.
+    if (errno == EOPNOTSUPP || errno == ENOSYS)
+        return true;
+
+    set_first_code(error::fallocate_failure);
+    return false;
+#else
+    return true;
+#endif
+}
+
 // Finalize failure results in unmapped.
-bool map::finalize_(size_t size) NOEXCEPT
+bool map::finalize_(size_t size, size_t start) NOEXCEPT
 {
     if (memory_map_ == MAP_FAILED)
     {
@@ -496,10 +794,8 @@ bool map::finalize_(size_t size) NOEXCEPT
         return false;
     }
 
-    // TODO: madvise with large length value fails on linux, does 0 imply all?
-    if (::madvise(memory_map_, 0, MADV_RANDOM) == fail)
+    if (!advise_(start, size))
     {
-        set_first_code(error::madvise_failure);
         unmap_();
         return false;
     }
@@ -509,6 +805,50 @@ bool map::finalize_(size_t size) NOEXCEPT
     return true;
 }
 
+// Advice applies to the mapped range [start, size), as a zero length advises
+// nothing. A new mapping does not inherit advice, so this is applied upon each
+// map and extension, and to the growth of a resized map (avoids re-reading). Hugepage advice is not supported for file-backed
+// maps on many platforms, so its failure is not a fault.
+bool map::advise_(size_t start, size_t size) NOEXCEPT
+{
+    BC_ASSERT(size >= start);
+
+    int hint{};
+    switch (advice_)
+    {
+        case advice::normal:
+            hint = MADV_NORMAL;
+            break;
+        case advice::random:
+            hint = MADV_RANDOM;
+            break;
+        case advice::sequential:
+            hint = MADV_SEQUENTIAL;
+            break;
+        case advice::willneed:
+            hint = MADV_WILLNEED;
+            break;
+        case advice::hugepage:
+#if defined(MADV_HUGEPAGE)
+            hint = MADV_HUGEPAGE;
+            break;
+#else
+            return true;
+#endif
+    }
+
+    BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+    const auto success = ::madvise(memory_map_ + start, size - start, hint)
+        != fail;
+    BC_POP_WARNING()
+
+    if (success || advice_ == advice::hugepage)
+        return true;
+
+    set_first_code(error::madvise_failure);
+    return false;
+}
+
 BC_POP_WARNING()
 
 } // namespace database
@@ -0,0 +1,1028 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/database/memory/pool.hpp>
+
+#if defined(HAVE_MSC)
+    #include "mman-win32/mman.hpp"
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/file/file.hpp>
+#include <bitcoin/database/locks/sharded_mutex.hpp>
+#include <bitcoin/database/memory/accessor.hpp>
+#include <bitcoin/database/memory/recycler.hpp>
+#include <bitcoin/database/memory/utilities.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+BC_PUSH_WARNING(NO_POINTER_ARITHMETIC)
+
+using namespace system;
+
+constexpr auto fail = -1;
+
+#if defined(MAP_NORESERVE)
+    constexpr auto reserve_flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#else
+    constexpr auto reserve_flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#endif
+
+// Frames spanning size (rounded up).
+constexpr size_t to_frames(size_t size) NOEXCEPT
+{
+    return is_zero(size) ? zero : add1(sub1(size) / pool::frame);
+}
+
+// Frames of budget (zero is unbounded).
+constexpr size_t to_limit(size_t budget) NOEXCEPT
+{
+    return is_zero(budget) ? max_size_t :
+        std::max(budget / pool::frame, pool::minimum_frames);
+}
+
+// Pinned accessor.
+// ----------------------------------------------------------------------------
+// The accessor spans logical size, and each resolved position pins the window
+// of frames [position, position + extent), limited to logical size, and the
+// two most recent windows are retained until destruct. The end position is
+// not resolved, as no element is read from it. A stream over the accessor is
+// bounded by end() to the window pinned at begin. Frames pinned by a writer
+// are dirty until written back after unpin. Frames cannot be released while
+// the accessor holds remap_mutex_ (no remap or unload). Frames of an unbounded
+// pool are fixed, so are not pinned.
+
+template <typename Lock>
+class pool::pinned
+  : public accessor<sharded_mutex, Lock>
+{
+public:
+    using base = accessor<sharded_mutex, Lock>;
+    DELETE_COPY_MOVE(pinned);
+
+    pinned(sharded_mutex& mutex, const pool& owner, bool write) NOEXCEPT
+      : base(mutex), owner_(owner), write_(write)
+    {
+    }
+
+    ~pinned() NOEXCEPT override
+    {
+        for (const auto& window: windows_)
+            if (window.first != empty)
+                owner_.unpin_(window.first, window.last, write_);
+    }
+
+    uint8_t* offset(size_t bytes) const NOEXCEPT override
+    {
+        const auto address = base::offset(bytes);
+        if (is_null(address) || owner_.unbounded_())
+            return address;
+
+        const auto remaining = to_unsigned(base::size()) - bytes;
+        if (is_zero(remaining))
+            return address;
+
+        return pin(address, remaining) ? address : nullptr;
+    }
+
+    uint8_t* end() NOEXCEPT override
+    {
+        const auto size = base::size();
+        if (owner_.unbounded_() || is_negative(size) || is_zero(size))
+            return base::end();
+
+        // A stream from begin cannot address beyond the window pinned at begin.
+        return base::begin() + std::min(to_unsigned(size), owner_.extent_);
+    }
+
+private:
+    static constexpr auto empty = max_size_t;
+
+    struct window
+    {
+        size_t first{ empty };
+        size_t last{ empty };
+    };
+
+    bool pin(const uint8_t* address, size_t remaining) const NOEXCEPT
+    {
+        const auto position = to_unsigned(address - owner_.memory_.load());
+        const auto bytes = std::min(remaining, owner_.extent_);
+        const auto first = position / frame;
+        auto last = sub1(position + bytes) / frame;
+
+        for (const auto& window: windows_)
+            if (window.first != empty && window.first <= first &&
+                last <= window.last)
+                return true;
+
+        if (!owner_.pin_(first, last, write_))
+            return false;
+
+        auto& oldest = windows_.at(next_);
+        if (oldest.first != empty)
+            owner_.unpin_(oldest.first, oldest.last, write_);
+
+        oldest = { first, last };
+        next_ = is_zero(next_) ? one : zero;
+        return true;
+    }
+
+    const pool& owner_;
+    const bool write_;
+    mutable std::array<window, two> windows_{};
+    mutable size_t next_{};
+};
+
+// pool
+// ----------------------------------------------------------------------------
+
+pool::pool(const path& filename, size_t minimum, size_t expansion,
+    size_t reserve, advice hint, bool preallocate, size_t budget) NOEXCEPT
+  : filename_(filename), minimum_(minimum), expansion_(expansion),
+    reserve_size_(reserve), advice_(hint), preallocate_(preallocate),
+    limit_(to_limit(budget))
+{
+}
+
+pool::~pool() NOEXCEPT
+{
+    BC_ASSERT_MSG(!loaded_, "pool loaded at destruct");
+    BC_ASSERT_MSG(is_null(memory_.load()), "pool reserved at destruct");
+    BC_ASSERT_MSG(is_zero(logical_.load()), "logical nonzero at destruct");
+    BC_ASSERT_MSG(is_zero(capacity_), "capacity nonzero at destruct");
+    BC_ASSERT_MSG(opened_ == file::invalid, "file open at destruct");
+}
+
+const std::filesystem::path& pool::file() const NOEXCEPT
+{
+    return filename_;
+}
+
+code pool::open() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (opened_ != file::invalid)
+        return error::open_open;
+
+    if (const auto ec = file::open_ex(opened_, filename_))
+        return ec;
+
+    size_t logical{};
+    const auto ec = file::size_ex(logical, opened_);
+    logical_.store(logical);
+    return ec;
+}
+
+code pool::close() NOEXCEPT
+{
+    std::unique_lock map_lock(remap_mutex_);
+    std::unique_lock field_lock(field_mutex_);
+
+    if (loaded_)
+        return error::close_loaded;
+
+    if (opened_ == file::invalid)
+        return error::success;
+
+    const auto descriptor = opened_;
+    opened_ = file::invalid;
+    logical_ = zero;
+
+    return file::close_ex(descriptor);
+}
+
+bool pool::is_open() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return opened_ != file::invalid;
+}
+
+// load, flush, unload.
+// ----------------------------------------------------------------------------
+// Each accessor holds a shared lock on remap_mutex_ (read/write access to the
+// reservation) and pins on its frames. Exclusive lock on remap_mutex_ ensures
+// there are no open accessor objects, and therefore no pinned frames, which
+// allows for safely releasing frames and relocating the reservation.
+
+code pool::load() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::load_loaded;
+        }
+
+        // Cannot reserve empty file, and want mininum capacity.
+        auto size = logical_.load();
+        if ((size < minimum_) && (!fallocate_(minimum_) ||
+            !resize_((size = minimum_))))
+        {
+            remap_mutex_.unlock();
+            return error::load_failure;
+        }
+
+        // Updates fields.
+        if (!reserve_(size) || !advise_())
+        {
+            /* bool */ release_();
+            remap_mutex_.unlock();
+            return error::load_failure;
+        }
+
+        // Unbounded frames are read upon load (and growth).
+        if (unbounded_())
+        {
+            std::unique_lock frame_lock(frame_mutex_);
+            if (!commit_(zero))
+            {
+                frame_lock.unlock();
+                /* bool */ release_();
+                remap_mutex_.unlock();
+                return error::load_failure;
+            }
+        }
+
+        // Loaded file content is presumed flushed.
+        flushed_.store(logical_.load());
+        loaded_ = true;
+        remap_mutex_.unlock();
+        return error::success;
+    }
+
+    return error::load_locked;
+}
+
+// Suspend writes before calling.
+code pool::reload() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (!loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::reload_unloaded;
+        }
+
+        // Allow resume from disk full.
+        set_disk_space(zero);
+
+        remap_mutex_.unlock();
+        return error::success;
+    }
+
+    return error::reload_locked;
+}
+
+// Suspend writes before calling.
+code pool::flush() NOEXCEPT
+{
+    // Prevent unload, relocation.
+    std::shared_lock map_lock(remap_mutex_);
+    std::shared_lock field_lock(field_mutex_);
+
+    if (!loaded_)
+        return error::flush_unloaded;
+
+    const auto end = logical_.load();
+    {
+        std::unique_lock frame_lock(frame_mutex_);
+        if (!write_back_())
+            return error::flush_failure;
+    }
+
+    if (::fsync(opened_) == fail)
+    {
+        set_first_code(error::fsync_failure);
+        return error::flush_failure;
+    }
+
+    flushed_.store(end);
+    return error::success;
+}
+
+// Does not suspend writes (pinned frames remain dirty once written back).
+code pool::sync() NOEXCEPT
+{
+    // Prevent unload, relocation.
+    std::shared_lock map_lock(remap_mutex_);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_)
+        return error::sync_unloaded;
+
+    std::unique_lock frame_lock(frame_mutex_);
+    return write_back_() ? error::success : error::sync_failure;
+}
+
+// Suspend writes before calling.
+code pool::unload() NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (remap_mutex_.try_lock())
+    {
+        if (!loaded_)
+        {
+            remap_mutex_.unlock();
+            return error::success;
+        }
+
+        BC_ASSERT_MSG(logical_ <= capacity_, "logical size exceeds capacity");
+
+        bool success{};
+        {
+            std::unique_lock frame_lock(frame_mutex_);
+            success = write_back_();
+        }
+
+        success = success
+            && (::ftruncate(opened_, logical_) != fail)
+            && (::fsync(opened_) != fail);
+
+        if (!success)
+            set_first_code(error::unload_failure);
+
+        // Updates fields.
+        success = release_() && success;
+        if (success)
+            flushed_.store(logical_.load());
+
+        loaded_ = false;
+        remap_mutex_.unlock();
+        return success ? error::success : error::unload_failure;
+    }
+
+    return error::unload_locked;
+}
+
+bool pool::is_loaded() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return loaded_;
+}
+
+// Interface.
+// ----------------------------------------------------------------------------
+
+size_t pool::size() const NOEXCEPT
+{
+    return logical_.load();
+}
+
+size_t pool::capacity() const NOEXCEPT
+{
+    std::shared_lock field_lock(field_mutex_);
+    return capacity_;
+}
+
+size_t pool::pending() const NOEXCEPT
+{
+    std::unique_lock frame_lock(frame_mutex_);
+    return dirty_ * frame;
+}
+
+size_t pool::lag() const NOEXCEPT
+{
+    return floored_subtract(size(), flushed_.load());
+}
+
+size_t pool::resident() const NOEXCEPT
+{
+    std::unique_lock frame_lock(frame_mutex_);
+    return resident_ * frame;
+}
+
+bool pool::set_budget(size_t budget) NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (loaded_)
+        return false;
+
+    limit_ = to_limit(budget);
+    return true;
+}
+
+bool pool::set_extent(size_t extent) NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (loaded_)
+        return false;
+
+    extent_ = std::max(extent, frame);
+    return true;
+}
+
+bool pool::truncate(size_t size) NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    if (size > logical_)
+        return false;
+
+    logical_ = size;
+    flushed_.store(std::min(flushed_.load(), size));
+    return true;
+}
+
+// Growth within the reservation neither moves memory nor waits on accessors.
+// Otherwise waits until all access pointers are destructed (see map).
+size_t pool::allocate(size_t chunk) NOEXCEPT
+{
+    std::unique_lock field_lock(field_mutex_);
+
+    const auto logical = logical_.load();
+    if (fault_.load() || !loaded_ || is_add_overflow(logical, chunk))
+        return storage::eof;
+
+    const auto end = logical + chunk;
+    if (end > capacity_)
+    {
+        const auto size = to_capacity(end);
+
+        if (to_frames(size) * frame <= reserved_.load())
+        {
+            // Disk full condition leaves store in valid state despite eof.
+            if (!grow_(size))
+                return storage::eof;
+        }
+        else
+        {
+            std::unique_lock remap_lock(remap_mutex_);
+
+            // Disk full condition leaves store in valid state despite eof.
+            if (!remap_(size))
+                return storage::eof;
+        }
+    }
+
+    logical_.store(end);
+    return logical;
+}
+
+memory_ptr pool::get(size_t offset) const NOEXCEPT
+{
+    return get_(offset, false);
+}
+
+memory_ptr pool::get_write(size_t offset) const NOEXCEPT
+{
+    return get_(offset, true);
+}
+
+memory_ptr pool::get_exclusive(size_t offset) const NOEXCEPT
+{
+    // See map::get_exclusive().
+    const auto ptr = std::make_shared<exclusive>(remap_mutex_, *this, true);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_ || is_null(ptr))
+        return nullptr;
+
+    const auto logical = size();
+    const auto memory = memory_.load();
+    ptr->assign(memory + offset, memory + logical);
+
+    // Pin the window at offset (nothing is pinned at or beyond end).
+    if ((offset < logical) && is_null(ptr->offset(zero)))
+        return nullptr;
+
+    return ptr;
+}
+
+memory::iterator pool::get_raw(size_t offset) const NOEXCEPT
+{
+    // An unguarded pointer cannot be pinned, so frames must be fixed.
+    // Pointer is otherwise unguarded, not relocation safe (use for heads).
+    if (!unbounded_() || offset > size())
+        return nullptr;
+
+    return memory_.load() + offset;
+}
+
+code pool::get_fault() const NOEXCEPT
+{
+    return error_.load();
+}
+
+size_t pool::get_space() const NOEXCEPT
+{
+    return space_.load();
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+size_t pool::to_capacity(size_t required) const NOEXCEPT
+{
+    BC_PUSH_WARNING(NO_STATIC_CAST)
+    const auto resize = required * ((expansion_ + 100.0) / 100.0);
+    const auto target = std::max(minimum_, static_cast<size_t>(resize));
+    BC_POP_WARNING()
+
+    BC_ASSERT(target >= required);
+    return target;
+}
+
+// Fault may be set by any thread that pins (reads or writes back) a frame.
+void pool::set_first_code(const error::error_t& ec) const NOEXCEPT
+{
+    if (!fault_.exchange(true))
+        error_.store(ec);
+}
+
+void pool::set_disk_space(size_t required) NOEXCEPT
+{
+    space_.store(required);
+}
+
+// private, thread safe
+// ----------------------------------------------------------------------------
+
+memory_ptr pool::get_(size_t offset, bool write) const NOEXCEPT
+{
+    // See map::get().
+    const auto logical = size();
+
+    // Takes a shared lock on remap_mutex_ until destruct, blocking relocation.
+    const auto ptr = std::allocate_shared<access>(allocator{}, remap_mutex_,
+        *this, write);
+
+    // loaded_ update is precluded by remap_mutex_, making this read atomic.
+    if (!loaded_ || is_null(ptr))
+        return nullptr;
+
+    // With offset > size the assignment is negative (stream is exhausted).
+    // Each offset() pins its window, and end() bounds a stream (see pinned).
+    const auto memory = memory_.load();
+    ptr->assign(memory + offset, memory + logical);
+
+    // Pin the extent at offset (nothing is pinned at or beyond end).
+    if ((offset < logical) && is_null(ptr->offset(zero)))
+        return nullptr;
+
+    return ptr;
+}
+
+// Pin frames [first, last], reading any that are absent. Last is limited to
+// the frames of capacity. There is no write detection, so a writer's pin
+// dirties, and the frame remains dirty until written back with no writer.
+bool pool::pin_(size_t first, size_t& last, bool write) const NOEXCEPT
+{
+    std::unique_lock frame_lock(frame_mutex_);
+    BC_ASSERT_MSG(first < frames_.size(), "pinned frame beyond capacity");
+    last = std::min(last, sub1(frames_.size()));
+
+    for (auto index = first; index <= last; ++index)
+    {
+        auto& slot = frames_.at(index);
+        if (!slot.resident)
+        {
+            // Evicts one unpinned frame when the budget is reached.
+            if ((resident_ >= limit_ && !evict_()) || !read_frame_(index))
+            {
+                for (auto pinned = first; pinned < index; ++pinned)
+                {
+                    --frames_.at(pinned).pins;
+                    if (write) --frames_.at(pinned).writers;
+                }
+
+                return false;
+            }
+
+            slot.resident = true;
+            ++resident_;
+        }
+
+        if (write)
+        {
+            if (!slot.dirty)
+            {
+                slot.dirty = true;
+                ++dirty_;
+            }
+
+            ++slot.writers;
+        }
+
+        slot.referenced = true;
+        ++slot.pins;
+    }
+
+    return true;
+}
+
+void pool::unpin_(size_t first, size_t last, bool write) const NOEXCEPT
+{
+    std::unique_lock frame_lock(frame_mutex_);
+    for (auto index = first; index <= last; ++index)
+    {
+        --frames_.at(index).pins;
+        if (write) --frames_.at(index).writers;
+    }
+}
+
+// limit_ (and extent_) is written only while unloaded, so is constant while
+// accessible.
+bool pool::unbounded_() const NOEXCEPT
+{
+    return limit_ == max_size_t;
+}
+
+// private, not thread safe
+// ----------------------------------------------------------------------------
+
+// disk_full: space is set but no code is set with false return.
+bool pool::resize_(size_t size) NOEXCEPT
+{
+    if (::ftruncate(opened_, size) == fail)
+    {
+        // Disk full is the only restartable store failure.
+        if (errno == ENOSPC)
+        {
+            set_disk_space(size - logical_);
+            return false;
+        }
+
+        set_first_code(error::ftruncate_failure);
+        return false;
+    }
+
+    return true;
+}
+
+// Growth within the reservation, frames are added as absent.
+bool pool::grow_(size_t size) NOEXCEPT
+{
+    if (!fallocate_(size) || !resize_(size))
+        return false;
+
+    std::unique_lock frame_lock(frame_mutex_);
+    const auto prior = frames_.size();
+    frames_.resize(to_frames(size));
+    capacity_ = size;
+    return !unbounded_() || commit_(prior);
+}
+
+// Relocation requires all frames written back and released (no accessors).
+bool pool::remap_(size_t size) NOEXCEPT
+{
+    {
+        std::unique_lock frame_lock(frame_mutex_);
+        if (!write_back_())
+            return false;
+    }
+
+    // disk_full: space is set but no code is set with false return.
+    if (!fallocate_(size) || !resize_(size))
+        return false;
+
+    const auto prior = memory_.load();
+    const auto span = reserved_.load();
+    if (!reserve_(size))
+        return false;
+
+    if (::munmap(prior, span) == fail)
+    {
+        set_first_code(error::munmap_failure);
+        return false;
+    }
+
+    std::unique_lock frame_lock(frame_mutex_);
+    return !unbounded_() || commit_(zero);
+}
+
+// See map::fallocate_().
+// disk_full: space is set but no code is set with false return.
+bool pool::fallocate_(size_t size) NOEXCEPT
+{
+#if defined(FALLOC_FL_KEEP_SIZE)
+    if (!preallocate_ || size <= capacity_)
+        return true;
+
+    if (::fallocate(opened_, FALLOC_FL_KEEP_SIZE, capacity_,
+        size - capacity_) != fail)
+        return true;
+
+    // Disk full is restartable.
+    if (errno == ENOSPC)
+    {
+        set_disk_space(size - logical_);
+        return false;
+    }
+
+    // Unsupported by file system, fall back to sparse growth.
+    if (errno == EOPNOTSUPP || errno == ENOSYS)
+        return true;
+
+    set_first_code(error::fallocate_failure);
+    return false;
+#else
+    return true;
+#endif
+}
+
+// Frames are read from the file, so advice applies to the file (not memory).
+// Frames are not huge pages, so hugepage advice is not applicable (normal).
+bool pool::advise_() NOEXCEPT
+{
+#if defined(POSIX_FADV_RANDOM)
+    int hint{};
+    switch (advice_)
+    {
+        case advice::random:
+            hint = POSIX_FADV_RANDOM;
+            break;
+        case advice::sequential:
+            hint = POSIX_FADV_SEQUENTIAL;
+            break;
+        case advice::willneed:
+            hint = POSIX_FADV_WILLNEED;
+            break;
+        case advice::normal:
+        case advice::hugepage:
+            return true;
+    }
+
+    // Zero length advises through end of file (including growth).
+    if (is_zero(::posix_fadvise(opened_, 0, 0, hint)))
+        return true;
+
+    set_first_code(error::madvise_failure);
+    return false;
+#else
+    return true;
+#endif
+}
+
+// Write back all dirty frames, leaving them resident. A frame pinned by a
+// writer may be written during write back (sync), so it remains dirty.
+bool pool::write_back_() const NOEXCEPT
+{
+    for (size_t index{}; index < frames_.size() && !is_zero(dirty_); ++index)
+    {
+        auto& slot = frames_.at(index);
+        if (!slot.dirty)
+            continue;
+
+        if (!write_frame_(index))
+            return false;
+
+        if (is_zero(slot.writers))
+        {
+            slot.dirty = false;
+            --dirty_;
+        }
+    }
+
+    return true;
+}
+
+// CLOCK: the hand clears the reference bit of each unpinned resident frame
+// and evicts the first found unreferenced. Two sweeps suffice. If all
+// resident frames are pinned none is evicted, and the budget is exceeded.
+bool pool::evict_() const NOEXCEPT
+{
+    const auto count = frames_.size();
+    for (size_t step{}; step < two * count; ++step)
+    {
+        const auto index = hand_;
+        hand_ = add1(hand_) % count;
+        auto& slot = frames_.at(index);
+
+        if (!slot.resident || !is_zero(slot.pins))
+            continue;
+
+        if (slot.referenced)
+        {
+            slot.referenced = false;
+            continue;
+        }
+
+        if (slot.dirty)
+        {
+            if (!write_frame_(index))
+                return false;
+
+            slot.dirty = false;
+            --dirty_;
+        }
+
+        if (!drop_frame_(index))
+            return false;
+
+        slot.resident = false;
+        --resident_;
+        return true;
+    }
+
+    return true;
+}
+
+// Unbounded frames are read and fixed (pinned by a writer without unpin),
+// as unguarded access is not detectable, so that all are resident and
+// written back (as with anonymous_map).
+bool pool::commit_(size_t first) NOEXCEPT
+{
+    for (auto index = first; index < frames_.size(); ++index)
+    {
+        if (!read_frame_(index))
+            return false;
+
+        frames_.at(index) = { one, one, true, true, true };
+        ++resident_;
+        ++dirty_;
+    }
+
+    return true;
+}
+
+#if !defined(HAVE_MSC)
+
+// Reservation and frames.
+// ----------------------------------------------------------------------------
+
+// Reserve twice the capacity (or the configured reservation if greater) so
+// that growth does not generally relocate. Reservation is inaccessible
+// (PROT_NONE) and uncommitted, costing no memory.
+bool pool::reserve_(size_t size) NOEXCEPT
+{
+    const auto page = page_size();
+    if (is_zero(page) || !is_zero(frame % page))
+        return false;
+
+    const auto bytes = std::max(reserve_size_, ceilinged_multiply(size, two));
+    const auto span = to_frames(bytes) * frame;
+    const auto memory = ::mmap(nullptr, span, PROT_NONE, reserve_flags, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        set_first_code(error::mmap_failure);
+        return false;
+    }
+
+    std::unique_lock frame_lock(frame_mutex_);
+    memory_.store(static_cast<uint8_t*>(memory));
+    reserved_.store(span);
+    frames_.assign(to_frames(size), {});
+    hand_ = zero;
+    resident_ = zero;
+    dirty_ = zero;
+    capacity_ = size;
+    return true;
+}
+
+// Frames are discarded, so must be written back before calling.
+bool pool::release_() NOEXCEPT
+{
+    std::unique_lock frame_lock(frame_mutex_);
+    const auto memory = memory_.load();
+    const auto success = is_null(memory) ||
+        (::munmap(memory, reserved_.load()) != fail);
+
+    if (!success)
+        set_first_code(error::munmap_failure);
+
+    memory_.store(nullptr);
+    reserved_.store(zero);
+    frames_.clear();
+    hand_ = zero;
+    resident_ = zero;
+    dirty_ = zero;
+    capacity_ = zero;
+    return success;
+}
+
+// The absent frame is not accessible to any thread until pinned, so it is
+// committed in place and read directly. Content beyond end of file is zero.
+bool pool::read_frame_(size_t index) const NOEXCEPT
+{
+    const auto offset = index * frame;
+    const auto bytes = std::min(frame, floored_subtract(capacity_, offset));
+    const auto buffer = memory_.load() + offset;
+
+    if (::mmap(buffer, frame, PROT_READ | PROT_WRITE, MAP_PRIVATE |
+        MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED)
+    {
+        set_first_code(error::mmap_failure);
+        return false;
+    }
+
+    for (size_t read{}; read < bytes;)
+    {
+        const auto result = ::pread(opened_, buffer + read, bytes - read,
+            offset + read);
+
+        if (is_negative(result) && errno == EINTR)
+            continue;
+
+        if (is_negative(result))
+        {
+            /* bool */ drop_frame_(index);
+            set_first_code(error::pread_failure);
+            return false;
+        }
+
+        if (is_zero(result))
+            break;
+
+        read += to_unsigned(result);
+    }
+
+    return true;
+}
+
+// Frame must be resident. Content beyond capacity is not written.
+bool pool::write_frame_(size_t index) const NOEXCEPT
+{
+    const auto offset = index * frame;
+    const auto bytes = std::min(frame, floored_subtract(capacity_, offset));
+    const auto buffer = memory_.load() + offset;
+
+    for (size_t written{}; written < bytes;)
+    {
+        const auto result = ::pwrite(opened_, buffer + written,
+            bytes - written, offset + written);
+
+        if (is_negative(result) && errno == EINTR)
+            continue;
+
+        if (is_negative(result))
+        {
+            set_first_code(error::pwrite_failure);
+            return false;
+        }
+
+        written += to_unsigned(result);
+    }
+
+    return true;
+}
+
+// Replaces frame with inaccessible, uncommitted memory (releasing its pages).
+bool pool::drop_frame_(size_t index) const NOEXCEPT
+{
+    const auto address = memory_.load() + index * frame;
+    if (::mmap(address, frame, PROT_NONE, reserve_flags | MAP_FIXED, -1, 0) ==
+        MAP_FAILED)
+    {
+        set_first_code(error::mmap_failure);
+        return false;
+    }
+
+    return true;
+}
+
+#else
+
+// Requires pread/pwrite and fixed mapping within a reservation, load fails.
+bool pool::reserve_(size_t) NOEXCEPT { return false; }
+bool pool::release_() NOEXCEPT { return true; }
+bool pool::read_frame_(size_t) const NOEXCEPT { return false; }
+bool pool::write_frame_(size_t) const NOEXCEPT { return false; }
+bool pool::drop_frame_(size_t) const NOEXCEPT { return false; }
+
+#endif
+
+BC_POP_WARNING()
+BC_POP_WARNING()
+
+} // namespace database
+} // namespace libbitcoin
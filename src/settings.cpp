@@ -29,69 +29,117 @@ using namespace bc::system;
 settings::settings() NOEXCEPT
   : path{ "bitcoin" },
     minimize(true),
+    flush_interval(0),
+    preallocate(false),
+    pool_budget(0),
+    aligned_heads(false),
+    bucket_load(0),
+    header_lineage(true),
 
     // Archives.
 
     header_buckets{ 100 },
     header_size{ 1 },
     header_rate{ 50 },
+    header_reserve{ 0 },
+    header_advice{ advice::random },
 
     input_size{ 1 },
     input_rate{ 50 },
+    input_reserve{ 0 },
+    input_advice{ advice::normal },
 
     output_size{ 1 },
     output_rate{ 50 },
+    output_reserve{ 0 },
+    output_advice{ advice::normal },
 
     point_buckets{ 100 },
     point_size{ 1 },
     point_rate{ 50 },
+    point_reserve{ 0 },
+    point_advice{ advice::random },
+    point_filter{ 0 },
 
     puts_size{ 1 },
     puts_rate{ 50 },
+    puts_reserve{ 0 },
+    puts_advice{ advice::sequential },
 
     spend_buckets{ 100 },
     spend_size{ 1 },
     spend_rate{ 50 },
+    spend_reserve{ 0 },
+    spend_advice{ advice::random },
 
     tx_buckets{ 100 },
     tx_size{ 1 },
     tx_rate{ 50 },
+    tx_reserve{ 0 },
+    tx_advice{ advice::random },
+    tx_filter{ 0 },
 
     txs_buckets{ 100 },
     txs_size{ 1 },
     txs_rate{ 50 },
+    txs_reserve{ 0 },
+    txs_advice{ advice::sequential },
 
     // Indexes.
 
     candidate_size{ 1 },
     candidate_rate{ 50 },
+    candidate_reserve{ 0 },
+    candidate_advice{ advice::sequential },
 
     confirmed_size{ 1 },
     confirmed_rate{ 50 },
+    confirmed_reserve{ 0 },
+    confirmed_advice{ advice::sequential },
 
     strong_tx_buckets{ 100 },
     strong_tx_size{ 1 },
     strong_tx_rate{ 50 },
+    strong_tx_reserve{ 0 },
+    strong_tx_advice{ advice::random },
+
+    strong_size{ 1 },
+    strong_rate{ 50 },
+    strong_reserve{ 0 },
+    strong_advice{ advice::random },
+
+    lineage_size{ 1 },
+    lineage_rate{ 50 },
+    lineage_reserve{ 0 },
+    lineage_advice{ advice::random },
 
     // Caches.
 
     validated_bk_buckets{ 100 },
     validated_bk_size{ 1 },
     validated_bk_rate{ 50 },
+    validated_bk_reserve{ 0 },
+    validated_bk_advice{ advice::random },
 
     validated_tx_buckets{ 100 },
     validated_tx_size{ 1 },
     validated_tx_rate{ 50 },
+    validated_tx_reserve{ 0 },
+    validated_tx_advice{ advice::random },
 
     // Optionals.
 
     address_buckets{ 100 },
     address_size{ 1 },
     address_rate{ 50 },
+    address_reserve{ 0 },
+    address_advice{ advice::random },
 
     neutrino_buckets{ 100 },
     neutrino_size{ 1 },
-    neutrino_rate{ 50 }
+    neutrino_rate{ 50 },
+    neutrino_reserve{ 0 },
+    neutrino_advice{ advice::random }
 
     // Caches.
 
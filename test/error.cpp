@@ -140,6 +140,24 @@ BOOST_AUTO_TEST_CASE(error_t__code__flush_failure__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "file failed to flush");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__sync_unloaded__true_exected_message)
+{
+    constexpr auto value = error::sync_unloaded;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "syncing unloaded file");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__sync_failure__true_exected_message)
+{
+    constexpr auto value = error::sync_failure;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "file failed to sync");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__unload_locked__true_exected_message)
 {
     constexpr auto value = error::unload_locked;
@@ -212,6 +230,33 @@ BOOST_AUTO_TEST_CASE(error_t__code__ftruncate_failure__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "ftruncate failure");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__fallocate_failure__true_exected_message)
+{
+    constexpr auto value = error::fallocate_failure;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "fallocate failure");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__pread_failure__true_exected_message)
+{
+    constexpr auto value = error::pread_failure;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pread failure");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__pwrite_failure__true_exected_message)
+{
+    constexpr auto value = error::pwrite_failure;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "pwrite failure");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__fsync_failure__true_exected_message)
 {
     constexpr auto value = error::fsync_failure;
@@ -311,6 +356,15 @@ BOOST_AUTO_TEST_CASE(error_t__code__unloaded_file__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "file not loaded");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__store_format__true_exected_message)
+{
+    constexpr auto value = error::store_format;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "store format version not supported");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__create_table__true_exected_message)
 {
     constexpr auto value = error::create_table;
@@ -356,6 +410,33 @@ BOOST_AUTO_TEST_CASE(error_t__code__verify_table__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "failed to verify table");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__maintain_table__true_exected_message)
+{
+    constexpr auto value = error::maintain_table;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "failed to maintain table");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__scan_table__true_exected_message)
+{
+    constexpr auto value = error::scan_table;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "failed to scan table");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__scan_stopped__true_exected_message)
+{
+    constexpr auto value = error::scan_stopped;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "table scan stopped");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__tx_connected__true_exected_message)
 {
     constexpr auto value = error::tx_connected;
@@ -603,6 +684,24 @@ BOOST_AUTO_TEST_CASE(error_t__code__header_put__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "header_put");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__header_lineage_set__true_exected_message)
+{
+    constexpr auto value = error::header_lineage_set;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "header_lineage_set");
+}
+
+BOOST_AUTO_TEST_CASE(error_t__code__header_reserve__true_exected_message)
+{
+    constexpr auto value = error::header_reserve;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "header_reserve");
+}
+
 // txs archive
 
 BOOST_AUTO_TEST_CASE(error_t__code__txs_header__true_exected_message)
@@ -178,6 +178,33 @@ BOOST_AUTO_TEST_CASE(file_utilities__create_file__exists__replaced)
     BOOST_REQUIRE(file::close(descriptor));
 }
 
+// read_file
+
+BOOST_AUTO_TEST_CASE(file_utilities__read_file__missing__false)
+{
+    data_chunk out(42u);
+    BOOST_REQUIRE(!file::read_file(TEST_PATH, out.data(), out.size()));
+}
+
+BOOST_AUTO_TEST_CASE(file_utilities__read_file__size_mismatch__false)
+{
+    const data_chunk source(42u);
+    BOOST_REQUIRE(file::create_file(TEST_PATH, source.data(), source.size()));
+
+    data_chunk out(41u);
+    BOOST_REQUIRE(!file::read_file(TEST_PATH, out.data(), out.size()));
+}
+
+BOOST_AUTO_TEST_CASE(file_utilities__read_file__exists__expected)
+{
+    const data_chunk source{ 0x01, 0x02, 0x03, 0x04 };
+    BOOST_REQUIRE(file::create_file(TEST_PATH, source.data(), source.size()));
+
+    data_chunk out(source.size());
+    BOOST_REQUIRE(file::read_file(TEST_PATH, out.data(), out.size()));
+    BOOST_REQUIRE_EQUAL(out, source);
+}
+
 // remove
 
 BOOST_AUTO_TEST_CASE(file_utilities__remove__missing__true)
@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(sharded_mutex_tests)
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__try_lock__unlocked__true)
+{
+    sharded_mutex instance{};
+    BOOST_REQUIRE(instance.try_lock());
+    instance.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__try_lock__locked__false)
+{
+    sharded_mutex instance{};
+    instance.lock();
+    BOOST_REQUIRE(!instance.try_lock());
+    instance.unlock();
+    BOOST_REQUIRE(instance.try_lock());
+    instance.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__try_lock__shared__false)
+{
+    sharded_mutex instance{};
+    instance.lock_shared();
+    BOOST_REQUIRE(!instance.try_lock());
+    instance.unlock_shared();
+    BOOST_REQUIRE(instance.try_lock());
+    instance.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__try_lock_shared__locked__false)
+{
+    sharded_mutex instance{};
+    instance.lock();
+    BOOST_REQUIRE(!instance.try_lock_shared());
+    instance.unlock();
+    BOOST_REQUIRE(instance.try_lock_shared());
+    instance.unlock_shared();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__lock_shared__recursive__shared)
+{
+    sharded_mutex instance{};
+    std::shared_lock first(instance);
+    std::shared_lock second(instance);
+    BOOST_REQUIRE(!instance.try_lock());
+    first.unlock();
+    BOOST_REQUIRE(!instance.try_lock());
+    second.unlock();
+    BOOST_REQUIRE(instance.try_lock());
+    instance.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__unlock_shared__other_thread__released)
+{
+    sharded_mutex instance{};
+    std::shared_lock lock(instance);
+    std::thread([&]() NOEXCEPT { lock.unlock(); }).join();
+    BOOST_REQUIRE(instance.try_lock());
+    instance.unlock();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__lock__shared_on_other_threads__waits)
+{
+    constexpr auto threads = 8u;
+    sharded_mutex instance{};
+    std::atomic<size_t> readers{};
+    std::atomic_bool release{};
+    std::vector<std::thread> pool{};
+
+    for (auto thread = 0u; thread < threads; ++thread)
+    {
+        pool.emplace_back([&]() NOEXCEPT
+        {
+            std::shared_lock lock(instance);
+            ++readers;
+            while (!release.load())
+                std::this_thread::yield();
+        });
+    }
+
+    while (readers.load() != threads)
+        std::this_thread::yield();
+
+    BOOST_REQUIRE(!instance.try_lock());
+    release.store(true);
+    instance.lock();
+    instance.unlock();
+
+    for (auto& thread: pool)
+        thread.join();
+}
+
+BOOST_AUTO_TEST_CASE(sharded_mutex__lock__concurrent_writers__exclusive)
+{
+    constexpr auto threads = 8u;
+    constexpr auto iterations = 1000u;
+    sharded_mutex instance{};
+    size_t counter{};
+    std::vector<std::thread> pool{};
+
+    for (auto thread = 0u; thread < threads; ++thread)
+    {
+        pool.emplace_back([&]() NOEXCEPT
+        {
+            for (auto iteration = 0u; iteration < iterations; ++iteration)
+            {
+                std::unique_lock lock(instance);
+                ++counter;
+            }
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    BOOST_REQUIRE_EQUAL(counter, threads * iterations);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct anonymous_map_setup_fixture
+{
+    DELETE_COPY_MOVE(anonymous_map_setup_fixture);
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+    anonymous_map_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    ~anonymous_map_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    BC_POP_WARNING()
+};
+
+BOOST_FIXTURE_TEST_SUITE(anonymous_map_tests, anonymous_map_setup_fixture)
+
+BOOST_AUTO_TEST_CASE(anonymous_map__file__always__expected)
+{
+    const std::string file = TEST_PATH;
+    anonymous_map instance(file);
+    BOOST_REQUIRE_EQUAL(instance.file(), file);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__open__no_file__false)
+{
+    const std::string file = TEST_PATH;
+    anonymous_map instance(file);
+    BOOST_REQUIRE(instance.open());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__properties__load_unload__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    anonymous_map instance(file, 42);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(instance.is_loaded());
+    BOOST_REQUIRE_EQUAL(instance.load(), error::load_loaded);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 42u);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.is_loaded());
+    BOOST_REQUIRE_EQUAL(instance.capacity(), zero);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__load__existing_file__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    anonymous_map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.size(), 5u);
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+
+    {
+        const auto memory = instance.get();
+        BOOST_REQUIRE(memory);
+        BOOST_REQUIRE_EQUAL(memory->size(), 5);
+        BOOST_REQUIRE_EQUAL(memory->begin()[0], 'h');
+        BOOST_REQUIRE_EQUAL(memory->begin()[4], 'o');
+    }
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__sync__unflushed__file_unchanged)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    anonymous_map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), 5u);
+    *instance.get_raw() = 'j';
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 42u);
+    BOOST_REQUIRE(!instance.sync());
+    BOOST_REQUIRE_EQUAL(test::size(file), 5u);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__unload__unflushed__written_back)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    {
+        anonymous_map instance(file);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_REQUIRE_EQUAL(instance.allocate(2), 5u);
+        *instance.get_raw() = 'j';
+        *instance.get_raw(6) = '!';
+        BOOST_REQUIRE_EQUAL(instance.lag(), 2u);
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+        BOOST_REQUIRE(!instance.close());
+        BOOST_REQUIRE(!instance.get_fault());
+        BOOST_REQUIRE_EQUAL(test::size(file), 7u);
+    }
+
+    // The file is reopened with map (normal on-disk layout).
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.size(), 7u);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 'j');
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(4), 'o');
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(6), '!');
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__flush__written__persisted)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    anonymous_map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(2), 5u);
+    *instance.get_raw() = 'j';
+    *instance.get_raw(6) = '!';
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+    BOOST_REQUIRE_EQUAL(test::size(file), 7u);
+
+    // Truncation is persisted upon flush.
+    BOOST_REQUIRE(instance.truncate(6));
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE_EQUAL(test::size(file), 6u);
+
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.size(), 6u);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 'j');
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(4), 'o');
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__flush__unloaded__flush_unloaded)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    anonymous_map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE_EQUAL(instance.flush(), error::flush_unloaded);
+    BOOST_REQUIRE_EQUAL(instance.sync(), error::sync_unloaded);
+    BOOST_REQUIRE(!instance.close());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__allocate__within_reservation__unmoved)
+{
+    constexpr auto reserve = 1024u * 1024u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    anonymous_map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), reserve);
+
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), zero);
+    const auto start = instance.get_raw();
+    *start = 0x42;
+
+    // Access is held across growth, which would deadlock a remap.
+    {
+        const auto memory = instance.get();
+        BOOST_REQUIRE_EQUAL(instance.allocate(reserve / 2u), one);
+        BOOST_REQUIRE_EQUAL(instance.get_raw(), start);
+        *instance.get_raw(reserve / 2u) = 0x24;
+        BOOST_REQUIRE_EQUAL(*instance.get_raw(), 0x42);
+        BOOST_REQUIRE_EQUAL(*instance.get_raw(reserve / 2u), 0x24);
+    }
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__allocate__beyond_reservation__data_retained)
+{
+    constexpr auto reserve = 64u * 1024u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    anonymous_map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), zero);
+    *instance.get_raw() = 0x42;
+
+    BOOST_REQUIRE_EQUAL(instance.allocate(2u * reserve), one);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 0x42);
+    *instance.get_raw(2u * reserve) = 0x24;
+    BOOST_REQUIRE_EQUAL(instance.allocate(3u * reserve), add1(2u * reserve));
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 0x42);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(2u * reserve), 0x24);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(anonymous_map__allocate__hugepage_preallocate__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    anonymous_map instance(file, 1, 50, zero, advice::hugepage, true);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(4u * 1024u * 1024u), zero);
+    *instance.get_raw(sub1(4u * 1024u * 1024u)) = 0x42;
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+    BOOST_REQUIRE_EQUAL(test::size(file), 4u * 1024u * 1024u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,6 +17,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../test.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 // TODO: need to fake map_(), unmap_() and flush_() in order to hit
 // error::load_failure, error::flush_failure, error::unload_failure codes, but
@@ -380,6 +383,58 @@ BOOST_AUTO_TEST_CASE(map__get__loaded__success)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+BOOST_AUTO_TEST_CASE(map__get_write__unloaded__false)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.get_write());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__get_write__loaded__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(instance.get_write(instance.allocate(1)));
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__get_exclusive__unloaded__false)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.get_exclusive());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__get_exclusive__loaded__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    const auto offset = instance.allocate(1);
+    BOOST_REQUIRE(instance.get_exclusive(offset));
+
+    // Released exclusive access does not preclude shared access.
+    BOOST_REQUIRE(instance.get(offset));
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(map__flush__unloaded__false)
 {
     const std::string file = TEST_PATH;
@@ -404,6 +459,62 @@ BOOST_AUTO_TEST_CASE(map__flush__loaded__true)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+BOOST_AUTO_TEST_CASE(map__sync__unloaded__sync_unloaded)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE_EQUAL(instance.sync(), error::sync_unloaded);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__sync__allocated__pending_cleared_lag_retained)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), zero);
+    BOOST_REQUIRE_EQUAL(instance.pending(), 42u);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 42u);
+    BOOST_REQUIRE(!instance.sync());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 42u);
+    BOOST_REQUIRE(!instance.sync());
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__truncate__synced__pending_regrowth)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), zero);
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE(instance.truncate(40));
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(2), 40u);
+    BOOST_REQUIRE_EQUAL(instance.pending(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 2u);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(map__write__read__expected)
 {
     constexpr uint64_t expected = 0x0102030405060708_u64;
@@ -442,4 +553,417 @@ BOOST_AUTO_TEST_CASE(map__unload__shared__false)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+// reserve
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(map__reserved__default__zero)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+}
+
+#if !defined(HAVE_MSC)
+BOOST_AUTO_TEST_CASE(map__reserved__loaded_unloaded__expected)
+{
+    constexpr auto reserve = 1024u * 1024u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), reserve);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__allocate__within_reservation__base_unchanged)
+{
+    constexpr auto reserve = 1024u * 1024u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), zero);
+    const auto base = instance.get_raw();
+    *base = 0x42;
+
+    // Crosses many pages, but within the reservation.
+    BOOST_REQUIRE_EQUAL(instance.allocate(to_half(reserve)), one);
+    BOOST_REQUIRE_EQUAL(instance.get_raw(), base);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 0x42);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), add1(to_half(reserve)));
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(test::size(file), add1(to_half(reserve)));
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__allocate__within_reservation_shared__not_blocked)
+{
+    constexpr auto reserve = 1024u * 1024u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    auto memory = instance.get(instance.allocate(1));
+    BOOST_REQUIRE(memory);
+    *memory->begin() = 0x42;
+
+    // Without reservation this would wait on the accessor (deadlock).
+    BOOST_REQUIRE_EQUAL(instance.allocate(100000), one);
+    BOOST_REQUIRE_EQUAL(*memory->begin(), 0x42);
+    memory.reset();
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__allocate__beyond_reservation__unreserved_expected)
+{
+    constexpr auto reserve = 8192u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, reserve);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), zero);
+    *instance.get_raw() = 0x42;
+    BOOST_REQUIRE_EQUAL(instance.reserved(), reserve);
+    BOOST_REQUIRE_EQUAL(instance.allocate(reserve), one);
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), add1(reserve));
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 0x42);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(test::size(file), add1(reserve));
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__load__logical_exceeds_reservation__unreserved)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "0123456789"));
+    map instance(file, 1, 0, 5);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.reserved(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+#endif
+
+// advice
+// ----------------------------------------------------------------------------
+
+static void advise_load_remap_unload(advice hint) NOEXCEPT
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 50, 0, hint);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(100000), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(map__load__advice_normal__success)
+{
+    advise_load_remap_unload(advice::normal);
+}
+
+BOOST_AUTO_TEST_CASE(map__load__advice_random__success)
+{
+    advise_load_remap_unload(advice::random);
+}
+
+BOOST_AUTO_TEST_CASE(map__load__advice_sequential__success)
+{
+    advise_load_remap_unload(advice::sequential);
+}
+
+BOOST_AUTO_TEST_CASE(map__load__advice_willneed__success)
+{
+    advise_load_remap_unload(advice::willneed);
+}
+
+BOOST_AUTO_TEST_CASE(map__load__advice_hugepage__no_fault)
+{
+    advise_load_remap_unload(advice::hugepage);
+}
+
+#if !defined(HAVE_MSC)
+BOOST_AUTO_TEST_CASE(map__allocate__advice_sequential_within_reservation__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, 1024u * 1024u, advice::sequential);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(100000), zero);
+    BOOST_REQUIRE(!is_zero(instance.reserved()));
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+#endif
+
+// preallocate
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(map__allocate__preallocate__expected_size)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 50, 0, advice::random, true);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(100000), zero);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 150000u);
+    BOOST_REQUIRE_EQUAL(test::size(file), 150000u);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(test::size(file), 100000u);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+    BOOST_REQUIRE_EQUAL(instance.get_space(), zero);
+}
+
+#if !defined(HAVE_MSC)
+BOOST_AUTO_TEST_CASE(map__allocate__preallocate_within_reservation__expected_size)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 0, 1024u * 1024u, advice::random, true);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(100000), zero);
+    BOOST_REQUIRE_EQUAL(test::size(file), 100000u);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(map__allocate__concurrent__disjoint_and_exact)
+{
+    constexpr auto threads = 8u;
+    constexpr auto allocations = 10'000u;
+    constexpr auto chunk = 3u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 50);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+
+    // Each allocation writes its thread tag, overlap would overwrite a tag.
+    std::atomic<size_t> failures{};
+    std::vector<std::thread> pool{};
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        pool.emplace_back([&, thread]() NOEXCEPT
+        {
+            for (size_t allocation = 0; allocation < allocations; ++allocation)
+            {
+                const auto offset = instance.allocate(chunk);
+                const auto memory = instance.get(offset);
+                if (offset == storage::eof || !memory)
+                {
+                    ++failures;
+                    continue;
+                }
+
+                std::fill_n(memory->begin(), chunk, add1(thread));
+            }
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    BOOST_REQUIRE_EQUAL(failures.load(), zero);
+    BOOST_REQUIRE_EQUAL(instance.size(), threads * allocations * chunk);
+
+    std::vector<size_t> tags(add1(threads));
+    for (size_t offset = 0; offset < instance.size(); offset += chunk)
+    {
+        const auto tag = *instance.get_raw(offset);
+        BOOST_REQUIRE(!is_zero(tag) && tag <= threads);
+        BOOST_REQUIRE_EQUAL(*instance.get_raw(add1(offset)), tag);
+        BOOST_REQUIRE_EQUAL(*instance.get_raw(offset + two), tag);
+        ++tags[tag];
+    }
+
+    for (size_t tag = 1; tag <= threads; ++tag)
+        BOOST_REQUIRE_EQUAL(tags[tag], allocations);
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+// Compares map::get (sharded_mutex, recycled accessor) with the prior accessor
+// (std::shared_mutex, make_shared) for concurrent guarded lookups.
+// Boost.Test assertions are not thread safe, so workers only count failures.
+template <typename Get>
+double lookups_per_second(size_t threads, size_t lookups,
+    std::atomic<size_t>& failures, Get&& get) NOEXCEPT
+{
+    std::vector<std::thread> pool{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        pool.emplace_back([&]() NOEXCEPT
+        {
+            for (size_t lookup = 0; lookup < lookups; ++lookup)
+            {
+                if (!get())
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return (threads * lookups) / elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(map__get__concurrent__performance)
+{
+    constexpr auto lookups = 1'000'000u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_NE(instance.allocate(4096), storage::eof);
+
+    std::shared_mutex mutex{};
+    uint8_t buffer[4096]{};
+    const auto legacy = [&]() NOEXCEPT
+    {
+        const auto ptr = std::make_shared<accessor<std::shared_mutex>>(mutex);
+        ptr->assign(&buffer[0], &buffer[4096]);
+        return ptr;
+    };
+
+    const auto current = [&]() NOEXCEPT
+    {
+        return instance.get();
+    };
+
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        std::atomic<size_t> failures{};
+        const auto before = lookups_per_second(threads, lookups, failures,
+            legacy);
+        const auto after = lookups_per_second(threads, lookups, failures,
+            current);
+        BOOST_REQUIRE_EQUAL(failures.load(), zero);
+        BOOST_TEST_MESSAGE("map::get threads [" << threads << "] shared_mutex ["
+            << before << "/s] sharded_mutex [" << after << "/s]");
+    }
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+}
+
+// Compares map::allocate (lock-free within capacity) with an allocation that
+// takes an exclusive lock for each call (as before), for concurrent writers.
+template <typename Allocate>
+double allocations_per_second(size_t threads, size_t allocations,
+    std::atomic<size_t>& failures, Allocate&& allocate) NOEXCEPT
+{
+    std::vector<std::thread> pool{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        pool.emplace_back([&]() NOEXCEPT
+        {
+            for (size_t allocation = 0; allocation < allocations; ++allocation)
+            {
+                if (allocate() == storage::eof)
+                    ++failures;
+            }
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return (threads * allocations) / elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(map__allocate__concurrent__performance)
+{
+    constexpr auto allocations = 1'000'000u;
+    constexpr auto chunk = 32u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+
+    std::shared_mutex mutex{};
+    size_t logical{};
+    const auto legacy = [&]() NOEXCEPT
+    {
+        std::unique_lock lock(mutex);
+        const auto start = logical;
+        logical += chunk;
+        return start;
+    };
+
+    const auto current = [&]() NOEXCEPT
+    {
+        return instance.allocate(chunk);
+    };
+
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        // Preallocate capacity so that growth is excluded from the measure.
+        BOOST_REQUIRE(instance.truncate(zero));
+        BOOST_REQUIRE_NE(instance.allocate(threads * allocations * chunk),
+            storage::eof);
+        BOOST_REQUIRE(instance.truncate(zero));
+
+        std::atomic<size_t> failures{};
+        const auto before = allocations_per_second(threads, allocations,
+            failures, legacy);
+        const auto after = allocations_per_second(threads, allocations,
+            failures, current);
+        BOOST_REQUIRE_EQUAL(failures.load(), zero);
+        BOOST_TEST_MESSAGE("map::allocate threads [" << threads << "] locked ["
+            << before << "/s] lock-free [" << after << "/s]");
+    }
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
 BOOST_AUTO_TEST_SUITE_END()
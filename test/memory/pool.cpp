@@ -0,0 +1,614 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <thread>
+
+// pool is not available on Windows.
+#if !defined(HAVE_MSC)
+
+struct pool_setup_fixture
+{
+    DELETE_COPY_MOVE(pool_setup_fixture);
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+    pool_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    ~pool_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    BC_POP_WARNING()
+};
+
+BOOST_FIXTURE_TEST_SUITE(pool_tests, pool_setup_fixture)
+
+constexpr auto budget = pool::minimum_frames * pool::frame;
+
+// Deterministic byte for a file offset.
+constexpr uint8_t pattern(size_t offset) NOEXCEPT
+{
+    return system::possible_narrow_cast<uint8_t>((offset * 7u) ^ (offset >> 16));
+}
+
+BOOST_AUTO_TEST_CASE(pool__file__always__expected)
+{
+    const std::string file = TEST_PATH;
+    pool instance(file);
+    BOOST_REQUIRE_EQUAL(instance.file(), file);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__load__unloaded__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.is_loaded());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(instance.is_loaded());
+    BOOST_REQUIRE_EQUAL(instance.load(), error::load_loaded);
+    BOOST_REQUIRE_EQUAL(instance.resident(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.is_loaded());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__sync__unloaded__sync_unloaded)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE_EQUAL(instance.sync(), error::sync_unloaded);
+    BOOST_REQUIRE_EQUAL(instance.flush(), error::flush_unloaded);
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__existing_file__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    pool instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.size(), 5u);
+
+    {
+        const auto memory = instance.get();
+        BOOST_REQUIRE(memory);
+        BOOST_REQUIRE_EQUAL(memory->size(), 5);
+        BOOST_REQUIRE_EQUAL(memory->begin()[0], 'h');
+        BOOST_REQUIRE_EQUAL(memory->begin()[4], 'o');
+    }
+
+    // Unbounded frames are fixed and presumed written (no write detection).
+    BOOST_REQUIRE_EQUAL(instance.resident(), pool::frame);
+    BOOST_REQUIRE_EQUAL(instance.pending(), pool::frame);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__write__flush__pending_cleared)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 42u);
+
+    *instance.get_write(41)->begin() = 0x42;
+    BOOST_REQUIRE_EQUAL(instance.pending(), pool::frame);
+    BOOST_REQUIRE(!instance.sync());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), 42u);
+
+    *instance.get_write(40)->begin() = 0x24;
+    BOOST_REQUIRE_EQUAL(instance.pending(), pool::frame);
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE_EQUAL(instance.lag(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+    BOOST_REQUIRE_EQUAL(test::size(file), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(pool__write__exceeds_budget__bounded_and_persisted)
+{
+    constexpr auto size = 4u * budget + 42u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    {
+        pool instance(file, 1, 50, 0, advice::random, false, budget);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+        {
+            const auto memory = instance.get_write();
+            BOOST_REQUIRE(memory);
+            for (size_t offset = 0; offset < size; ++offset)
+                *memory->offset(offset) = pattern(offset);
+
+            BOOST_REQUIRE(instance.resident() <= budget);
+
+            for (size_t offset = 0; offset < size; ++offset)
+                BOOST_REQUIRE_EQUAL(*memory->offset(offset), pattern(offset));
+        }
+
+        BOOST_REQUIRE(instance.resident() <= budget);
+        BOOST_REQUIRE(instance.pending() <= budget);
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+    {
+        pool instance(file, 1, 50, 0, advice::random, false, budget);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_REQUIRE_EQUAL(instance.size(), size);
+
+        {
+            const auto memory = instance.get();
+            BOOST_REQUIRE(memory);
+            for (size_t offset = 0; offset < size; offset += 997u)
+                BOOST_REQUIRE_EQUAL(*memory->offset(offset), pattern(offset));
+        }
+
+        BOOST_REQUIRE(instance.resident() <= budget);
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pool__allocate__beyond_reservation__data_retained)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), zero);
+    *instance.get_write()->begin() = 0x42;
+
+    // Reservation is twice the initial (minimum) capacity.
+    BOOST_REQUIRE_EQUAL(instance.allocate(4u * pool::frame), one);
+    BOOST_REQUIRE_EQUAL(*instance.get()->begin(), 0x42);
+    *instance.get_write(4u * pool::frame)->begin() = 0x24;
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE_EQUAL(test::size(file), add1(4u * pool::frame));
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(*instance.get()->begin(), 0x42);
+    BOOST_REQUIRE_EQUAL(*instance.get(4u * pool::frame)->begin(), 0x24);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get_raw__bounded__null)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(is_null(instance.get_raw()));
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get_raw__unbounded__fixed_and_persisted)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file, "hello"));
+    pool instance(file);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(instance.set_budget(budget));
+    BOOST_REQUIRE(instance.set_budget(zero));
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(!instance.set_budget(budget));
+    BOOST_REQUIRE_EQUAL(instance.resident(), pool::frame);
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 'h');
+
+    // All frames are resident and fixed upon growth.
+    BOOST_REQUIRE_EQUAL(instance.allocate(4u * pool::frame), 5u);
+    BOOST_REQUIRE_EQUAL(instance.resident(), 5u * pool::frame);
+    *instance.get_raw(4u * pool::frame) = 0x42;
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(), 'h');
+    BOOST_REQUIRE_EQUAL(*instance.get_raw(4u * pool::frame), 0x42);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__load__preallocate_sequential__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 50, 8u * pool::frame, advice::sequential, true,
+        budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(2u * pool::frame), zero);
+    *instance.get_write(add1(pool::frame))->begin() = 0x42;
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(*instance.get(add1(pool::frame))->begin(), 0x42);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__pinned_over_budget__retained)
+{
+    constexpr auto size = 4u * budget;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+    // Pinned frames are not evicted by access to all other frames.
+    const auto pinned = instance.get_write(sub1(pool::frame));
+    BOOST_REQUIRE(pinned);
+    pinned->begin()[0] = 0x42;
+    pinned->begin()[1] = 0x24;
+
+    {
+        const auto memory = instance.get_write();
+        BOOST_REQUIRE(memory);
+        for (auto offset = two * pool::frame; offset < size;
+            offset += pool::frame)
+            *memory->offset(offset) = pattern(offset);
+    }
+
+    BOOST_REQUIRE(instance.resident() <= budget);
+    BOOST_REQUIRE_EQUAL(pinned->begin()[0], 0x42);
+    BOOST_REQUIRE_EQUAL(pinned->begin()[1], 0x24);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__pinned_window__kernel_accessible)
+{
+    constexpr auto size = 4u * budget;
+    const std::string file = TEST_PATH;
+    const std::string copy = TEST_PATH + "_copy";
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+    {
+        const auto memory = instance.get_write();
+        BOOST_REQUIRE(memory);
+        for (size_t offset = 0; offset < size; ++offset)
+            *memory->offset(offset) = pattern(offset);
+    }
+
+    // The window of a resolved offset is committed, so the kernel may read it.
+    constexpr auto start = 3u * budget + 42u;
+    {
+        const auto memory = instance.get(start);
+        BOOST_REQUIRE(memory);
+        BOOST_REQUIRE(!file::create_file_ex(copy, memory->begin(),
+            pool::frame));
+    }
+
+    std::ifstream stream{ copy, std::ios::binary };
+    data_chunk buffer(pool::frame);
+    BOOST_REQUIRE(stream.read(system::pointer_cast<char>(buffer.data()),
+        pool::frame));
+
+    for (size_t index = 0; index < pool::frame; ++index)
+        BOOST_REQUIRE_EQUAL(buffer.at(index), pattern(start + index));
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__read__not_pending)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), zero);
+    *instance.get_write(41)->begin() = 0x42;
+    BOOST_REQUIRE_EQUAL(instance.pending(), pool::frame);
+    BOOST_REQUIRE(!instance.flush());
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+
+    // A read pin does not dirty its frame.
+    BOOST_REQUIRE_EQUAL(*instance.get(41)->begin(), 0x42);
+    BOOST_REQUIRE_EQUAL(instance.pending(), zero);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__extent_over_frames__pinned_and_bounded)
+{
+    constexpr auto size = 4u * budget;
+    constexpr auto extent = 4u * pool::frame;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(instance.set_extent(extent));
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE(!instance.set_extent(pool::frame));
+    BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+    {
+        const auto memory = instance.get_write();
+        BOOST_REQUIRE(memory);
+        for (size_t offset = 0; offset < size; ++offset)
+            *memory->offset(offset) = pattern(offset);
+    }
+
+    // The memory of get() spans logical size, its stream is bounded to the
+    // extent pinned at its offset.
+    constexpr auto start = budget + 42u;
+    {
+        const auto pinned = instance.get(start);
+        BOOST_REQUIRE(pinned);
+        BOOST_REQUIRE_EQUAL(pinned->size(),
+            system::possible_narrow_and_sign_cast<ptrdiff_t>(size - start));
+        BOOST_REQUIRE_EQUAL(std::distance(pinned->begin(), pinned->end()),
+            system::possible_narrow_and_sign_cast<ptrdiff_t>(extent));
+
+        // Pinned frames are not evicted by access to all other frames.
+        {
+            const auto memory = instance.get();
+            BOOST_REQUIRE(memory);
+            for (size_t offset = 0; offset < size; offset += pool::frame)
+                BOOST_REQUIRE_EQUAL(*memory->offset(offset), pattern(offset));
+        }
+
+        for (size_t index = 0; index < extent; ++index)
+            BOOST_REQUIRE_EQUAL(pinned->begin()[index], pattern(start + index));
+    }
+
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__offset_beyond_extent__pinned_and_expected)
+{
+    constexpr auto size = 4u * budget;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+    // Each offset of one memory object pins its own window (as primitives).
+    {
+        const auto memory = instance.get_write(42);
+        BOOST_REQUIRE(memory);
+        for (auto offset = sub1(pool::frame); offset < size - 42u;
+            offset += 3u * pool::frame)
+        {
+            const auto address = memory->offset(offset);
+            BOOST_REQUIRE(!is_null(address));
+            address[0] = pattern(offset);
+            address[1] = pattern(add1(offset));
+        }
+    }
+
+    {
+        const auto memory = instance.get(42);
+        BOOST_REQUIRE(memory);
+        for (auto offset = sub1(pool::frame); offset < size - 42u;
+            offset += 3u * pool::frame)
+        {
+            const auto address = memory->offset(offset);
+            BOOST_REQUIRE(!is_null(address));
+            BOOST_REQUIRE_EQUAL(address[0], pattern(offset));
+            BOOST_REQUIRE_EQUAL(address[1], pattern(add1(offset)));
+        }
+    }
+
+    BOOST_REQUIRE(instance.resident() <= budget);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__concurrent_over_budget__expected)
+{
+    constexpr auto size = 4u * budget;
+    constexpr auto threads = 8u;
+    constexpr auto reads = 10'000u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    pool instance(file, 1, 0, 0, advice::random, false, budget);
+    BOOST_REQUIRE(!instance.open());
+    BOOST_REQUIRE(!instance.load());
+    BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+
+    {
+        const auto memory = instance.get_write();
+        for (size_t offset = 0; offset < size; ++offset)
+            *memory->offset(offset) = pattern(offset);
+    }
+
+    std::atomic<size_t> errors{};
+    std::vector<std::thread> readers{};
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        readers.emplace_back([&, thread]() NOEXCEPT
+        {
+            std::minstd_rand random{ static_cast<uint32_t>(add1(thread)) };
+            for (size_t read = 0; read < reads; ++read)
+            {
+                const auto offset = random() % size;
+                const auto memory = instance.get_write(offset);
+                if (!memory || *memory->begin() != pattern(offset))
+                {
+                    ++errors;
+                    continue;
+                }
+
+                // Writes interleave with eviction of other frames.
+                *memory->begin() = pattern(offset);
+            }
+        });
+    }
+
+    for (auto& reader: readers)
+        reader.join();
+
+    BOOST_REQUIRE_EQUAL(errors.load(), zero);
+    BOOST_REQUIRE(instance.resident() <= budget);
+    BOOST_REQUIRE(!instance.unload());
+    BOOST_REQUIRE(!instance.close());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+// Random page-aligned reads over a file, each verified against its pattern.
+template <typename Storage>
+double reads_per_second(Storage& instance, size_t size, size_t reads) NOEXCEPT
+{
+    constexpr auto page = 4096u;
+    std::minstd_rand random{ 42 };
+    size_t errors{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t read = 0; read < reads; ++read)
+    {
+        const auto offset = (random() % (size / page)) * page;
+        const auto memory = instance.get(offset);
+        errors += (*memory->begin() != pattern(offset)) ? one : zero;
+    }
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    BOOST_REQUIRE_EQUAL(errors, zero);
+    return reads / elapsed.count();
+}
+
+template <typename Storage>
+double appends_per_second(Storage& instance, size_t appends) NOEXCEPT
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t append = 0; append < appends; ++append)
+    {
+        const auto offset = instance.allocate(64);
+        const auto memory = instance.get_write(offset);
+        std::fill_n(memory->begin(), 64u, pattern(offset));
+    }
+
+    BOOST_REQUIRE(!instance.flush());
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return appends / elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(pool__get__random_versus_map__performance)
+{
+    constexpr auto size = 256u * 1024u * 1024u;
+    constexpr auto reads = 1'000'000u;
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    {
+        map instance(file);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_REQUIRE_EQUAL(instance.allocate(size), zero);
+        for (size_t offset = 0; offset < size; offset += 4096u)
+            *instance.get_raw(offset) = pattern(offset);
+
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_TEST_MESSAGE("map random reads [" <<
+            reads_per_second(instance, size, reads) << "/s]");
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+    {
+        pool instance(file, 1, 0, 0, advice::random, false, size / 4u);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        const auto rate = reads_per_second(instance, size, reads);
+        BOOST_TEST_MESSAGE("pool random reads (quarter budget) [" << rate <<
+            "/s] resident [" << instance.resident() << "]");
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(pool__allocate__appends_versus_map__performance)
+{
+    constexpr auto appends = 1'000'000u;
+    const std::string map_file = TEST_PATH + "_map";
+    const std::string pool_file = TEST_PATH + "_pool";
+    BOOST_REQUIRE(test::create(map_file));
+    BOOST_REQUIRE(test::create(pool_file));
+    {
+        map instance(map_file, 1, 50);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_TEST_MESSAGE("map appends [" <<
+            appends_per_second(instance, appends) << "/s]");
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+    {
+        pool instance(pool_file, 1, 50, 0, advice::random, false, budget);
+        BOOST_REQUIRE(!instance.open());
+        BOOST_REQUIRE(!instance.load());
+        BOOST_TEST_MESSAGE("pool appends (minimum budget) [" <<
+            appends_per_second(instance, appends) << "/s]");
+        BOOST_REQUIRE(!instance.unload());
+        BOOST_REQUIRE(!instance.close());
+    }
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // HAVE_MSC
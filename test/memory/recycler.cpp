@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(recycler_tests)
+
+struct element
+{
+    uint64_t first;
+    uint64_t second;
+};
+
+using pool = recycler<element, 2>;
+
+BOOST_AUTO_TEST_CASE(recycler__deallocate__single__cached)
+{
+    pool instance{};
+    const auto ptr = instance.allocate(1);
+    BOOST_REQUIRE(!system::is_null(ptr));
+    const auto start = pool::cached();
+    instance.deallocate(ptr, 1);
+    BOOST_REQUIRE_EQUAL(pool::cached(), add1(start));
+}
+
+BOOST_AUTO_TEST_CASE(recycler__allocate__cached__reused)
+{
+    pool instance{};
+    const auto first = instance.allocate(1);
+    instance.deallocate(first, 1);
+    const auto start = pool::cached();
+    const auto second = instance.allocate(1);
+    BOOST_REQUIRE_EQUAL(second, first);
+    BOOST_REQUIRE_EQUAL(pool::cached(), sub1(start));
+    instance.deallocate(second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deallocate__array__not_cached)
+{
+    pool instance{};
+    const auto start = pool::cached();
+    const auto ptr = instance.allocate(3);
+    BOOST_REQUIRE(!system::is_null(ptr));
+    instance.deallocate(ptr, 3);
+    BOOST_REQUIRE_EQUAL(pool::cached(), start);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deallocate__over_limit__bounded)
+{
+    pool instance{};
+    const auto first = instance.allocate(1);
+    const auto second = instance.allocate(1);
+    const auto third = instance.allocate(1);
+    instance.deallocate(first, 1);
+    instance.deallocate(second, 1);
+    instance.deallocate(third, 1);
+    BOOST_REQUIRE_EQUAL(pool::cached(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(recycler__deallocate__other_thread__cached_by_other_thread)
+{
+    pool instance{};
+    const auto start = pool::cached();
+    const auto ptr = instance.allocate(1);
+
+    size_t cached{};
+    std::thread([&]() NOEXCEPT
+    {
+        instance.deallocate(ptr, 1);
+        cached = pool::cached();
+    }).join();
+
+    BOOST_REQUIRE_EQUAL(cached, 1u);
+    BOOST_REQUIRE_EQUAL(pool::cached(), floored_subtract(start, one));
+}
+
+BOOST_AUTO_TEST_CASE(recycler__allocate_shared__reset__cached)
+{
+    using access = accessor<sharded_mutex>;
+    using allocator = recycler<access>;
+
+    sharded_mutex mutex{};
+    auto ptr = std::allocate_shared<access>(allocator{}, mutex);
+    BOOST_REQUIRE(!mutex.try_lock());
+    ptr.reset();
+    BOOST_REQUIRE(mutex.try_lock());
+    mutex.unlock();
+
+    const auto again = std::allocate_shared<access>(allocator{}, mutex);
+    BOOST_REQUIRE(!mutex.try_lock());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -39,7 +39,7 @@ chunk_storage::chunk_storage(system::data_chunk& reference) NOEXCEPT
 }
 
 chunk_storage::chunk_storage(const std::filesystem::path& filename,
-    size_t, size_t) NOEXCEPT
+    size_t, size_t, size_t, database::advice, bool) NOEXCEPT
   : buffer_{ local_ }, path_{ filename }
 {
 }
@@ -74,6 +74,11 @@ code chunk_storage::flush() NOEXCEPT
     return error::success;
 }
 
+code chunk_storage::sync() NOEXCEPT
+{
+    return error::success;
+}
+
 code chunk_storage::unload() NOEXCEPT
 {
     return error::success;
@@ -96,6 +101,16 @@ size_t chunk_storage::size() const NOEXCEPT
     return buffer_.size();
 }
 
+size_t chunk_storage::pending() const NOEXCEPT
+{
+    return zero;
+}
+
+size_t chunk_storage::lag() const NOEXCEPT
+{
+    return zero;
+}
+
 bool chunk_storage::truncate(size_t size) NOEXCEPT
 {
     std::unique_lock field_lock(field_mutex_);
@@ -130,6 +145,22 @@ memory_ptr chunk_storage::get(size_t offset) const NOEXCEPT
     return ptr;
 }
 
+memory_ptr chunk_storage::get_write(size_t offset) const NOEXCEPT
+{
+    return get(offset);
+}
+
+memory_ptr chunk_storage::get_exclusive(size_t offset) const NOEXCEPT
+{
+    // Obtain logical before exclusive lock, allocate holds both (see get).
+    const auto end = get_raw(size());
+    const auto ptr = std::make_shared<accessor<std::shared_mutex,
+        std::unique_lock<std::shared_mutex>>>(map_mutex_);
+
+    ptr->assign(get_raw(offset), end);
+    return ptr;
+}
+
 memory::iterator chunk_storage::get_raw(size_t offset) const NOEXCEPT
 {
     return std::next(buffer_.data(), offset);
@@ -32,7 +32,9 @@ public:
     chunk_storage() NOEXCEPT;
     chunk_storage(system::data_chunk& reference) NOEXCEPT;
     chunk_storage(const std::filesystem::path& filename, size_t minimum=1,
-        size_t expansion=0) NOEXCEPT;
+        size_t expansion=0, size_t reserve=0,
+        database::advice hint=database::advice::random,
+        bool preallocate=false) NOEXCEPT;
 
     // test side door.
     system::data_chunk& buffer() NOEXCEPT;
@@ -43,13 +45,18 @@ public:
     code load() NOEXCEPT override;
     code reload() NOEXCEPT override;
     code flush() NOEXCEPT override;
+    code sync() NOEXCEPT override;
     code unload() NOEXCEPT override;
     const std::filesystem::path& file() const NOEXCEPT override;
     size_t capacity() const NOEXCEPT override;
     size_t size() const NOEXCEPT override;
+    size_t pending() const NOEXCEPT override;
+    size_t lag() const NOEXCEPT override;
     bool truncate(size_t size) NOEXCEPT override;
     size_t allocate(size_t chunk) NOEXCEPT override;
     memory_ptr get(size_t offset=zero) const NOEXCEPT override;
+    memory_ptr get_write(size_t offset=zero) const NOEXCEPT override;
+    memory_ptr get_exclusive(size_t offset=zero) const NOEXCEPT override;
     memory::iterator get_raw(size_t offset=zero) const NOEXCEPT override;
     code get_fault() const NOEXCEPT override;
     size_t get_space() const NOEXCEPT override;
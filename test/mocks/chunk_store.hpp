@@ -156,6 +156,26 @@ public:
         return strong_tx_body_.buffer();
     }
 
+    system::data_chunk& strong_head() NOEXCEPT
+    {
+        return strong_head_.buffer();
+    }
+
+    system::data_chunk& lineage_head() NOEXCEPT
+    {
+        return lineage_head_.buffer();
+    }
+
+    system::data_chunk& strong_body() NOEXCEPT
+    {
+        return strong_body_.buffer();
+    }
+
+    system::data_chunk& lineage_body() NOEXCEPT
+    {
+        return lineage_body_.buffer();
+    }
+
     // Caches.
 
     system::data_chunk& validated_bk_head() NOEXCEPT
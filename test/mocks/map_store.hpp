@@ -78,6 +78,11 @@ public:
         return point_body_.file();
     }
 
+    inline const path& point_filter_file() const NOEXCEPT
+    {
+        return point_filter_.file();
+    }
+
     inline const path& input_head_file() const NOEXCEPT
     {
         return input_head_.file();
@@ -118,6 +123,11 @@ public:
         return tx_body_.file();
     }
 
+    inline const path& tx_filter_file() const NOEXCEPT
+    {
+        return tx_filter_.file();
+    }
+
     inline const path& txs_head_file() const NOEXCEPT
     {
         return txs_head_.file();
@@ -180,6 +190,26 @@ public:
         return strong_tx_body_.file();
     }
 
+    inline const path& strong_head_file() const NOEXCEPT
+    {
+        return strong_head_.file();
+    }
+
+    inline const path& lineage_head_file() const NOEXCEPT
+    {
+        return lineage_head_.file();
+    }
+
+    inline const path& strong_body_file() const NOEXCEPT
+    {
+        return strong_body_.file();
+    }
+
+    inline const path& lineage_body_file() const NOEXCEPT
+    {
+        return lineage_body_.file();
+    }
+
     // Caches.
 
     inline const path& validated_bk_head_file() const NOEXCEPT
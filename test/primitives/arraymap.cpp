@@ -316,6 +316,36 @@ BOOST_AUTO_TEST_CASE(arraymap__record_get__populated__valid)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+class view_record
+{
+public:
+    static constexpr size_t size = sizeof(uint32_t);
+    static constexpr link5 count() NOEXCEPT { return 1; }
+
+    bool from_memory(const uint8_t* data) NOEXCEPT
+    {
+        value = field<zero, sizeof(uint32_t)>::get(data);
+        return true;
+    }
+
+    uint32_t value{ 0 };
+};
+
+BOOST_AUTO_TEST_CASE(arraymap__record_get__view_populated__valid)
+{
+    data_chunk head_file;
+    data_chunk body_file{ 0x01, 0x02, 0x03, 0x04 };
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    const arraymap<link5, view_record::size> instance{ head_store, body_store };
+
+    view_record record{};
+    BOOST_REQUIRE(instance.get(0, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x04030201_u32);
+    BOOST_REQUIRE(!instance.get(1, record));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(arraymap__record_put__get__expected)
 {
     data_chunk head_file;
@@ -334,6 +364,48 @@ BOOST_AUTO_TEST_CASE(arraymap__record_put__get__expected)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+BOOST_AUTO_TEST_CASE(arraymap__record_get_many__populated__expected)
+{
+    constexpr auto count = 40u;
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, little_record::size> instance{ head_store, body_store };
+
+    std_vector<link5> links{};
+    for (uint32_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE(instance.put(little_record{ value }));
+        links.emplace_back(sub1(count) - value);
+    }
+
+    std_vector<little_record> records{};
+    BOOST_REQUIRE(instance.get_many(links, records));
+    BOOST_REQUIRE_EQUAL(records.size(), count);
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(records.at(index).value, sub1(count) - index);
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_get_many__terminal__false)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, little_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE(instance.put(little_record{ 42 }));
+
+    const std_vector<link5> links{ 0, link5::terminal };
+    std_vector<little_record> records{};
+    BOOST_REQUIRE(!instance.get_many(links, records));
+    BOOST_REQUIRE_EQUAL(records.size(), two);
+    BOOST_REQUIRE_EQUAL(records.front().value, 42u);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(arraymap__record_count__truncate__expected)
 {
     data_chunk head_file;
@@ -387,6 +459,65 @@ BOOST_AUTO_TEST_CASE(arraymap__record_put_link__multiple__expected)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+BOOST_AUTO_TEST_CASE(arraymap__record_set__past_end__expanded_zero_filled)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, big_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE(instance.put(big_record{ 0xa1b2c3d4_u32 }));
+    BOOST_REQUIRE(instance.set(2, big_record{ 0x01020304_u32 }));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    big_record record{};
+    BOOST_REQUIRE(instance.get(1, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x00000000_u32);
+    BOOST_REQUIRE(instance.get(2, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x01020304_u32);
+
+    // Set within body overwrites and does not expand.
+    BOOST_REQUIRE(instance.set(0, big_record{ 0x0a0b0c0d_u32 }));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    const data_chunk expected_file
+    {
+        0x0a, 0x0b, 0x0c, 0x0d,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x02, 0x03, 0x04
+    };
+    BOOST_REQUIRE_EQUAL(body_file, expected_file);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_set_many__unordered__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, little_record::size> instance{ head_store, body_store };
+
+    const std_vector<link5> links{ 3, 1 };
+    BOOST_REQUIRE(instance.set_many(links, little_record{ 0x01020304_u32 }));
+    BOOST_REQUIRE(instance.set_many({}, little_record{ 0x05060708_u32 }));
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+
+    const data_chunk expected_file
+    {
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x03, 0x02, 0x01,
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x03, 0x02, 0x01
+    };
+    BOOST_REQUIRE_EQUAL(body_file, expected_file);
+
+    // Terminal link is not settable.
+    BOOST_REQUIRE(!instance.set(link5{}, little_record{}));
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 class little_slab
 {
 public:
@@ -631,6 +762,113 @@ BOOST_AUTO_TEST_CASE(arraymap__slab_put_link__excess__false)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+// scan
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(arraymap__record_scan__empty__true)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    const arraymap<link5, little_record::size> instance{ head_store, body_store };
+
+    size_t visits{};
+    BOOST_REQUIRE(!instance.scan<little_record>([&](const link5&,
+        const little_record&) NOEXCEPT
+    {
+        ++visits;
+        return true;
+    }, 4));
+
+    BOOST_REQUIRE_EQUAL(visits, zero);
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_scan__threads__all_visited_once)
+{
+    constexpr auto count = 10'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    arraymap<link5, little_record::size> instance{ head_store, body_store };
+    for (uint32_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(little_record{ value }));
+
+    std::vector<std::atomic<size_t>> visits(count);
+    std::atomic_bool matched{ true };
+    BOOST_REQUIRE(!instance.scan<little_record>([&](const link5& link,
+        const little_record& record) NOEXCEPT
+    {
+        matched = matched && (record.value == link.value);
+        ++visits.at(link.value);
+        return true;
+    }, 4));
+
+    BOOST_REQUIRE(matched);
+    for (const auto& visit: visits)
+        BOOST_REQUIRE_EQUAL(visit.load(), one);
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_scan__stopped__scan_stopped)
+{
+    constexpr auto count = 10u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    arraymap<link5, little_record::size> instance{ head_store, body_store };
+    for (uint32_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(little_record{ value }));
+
+    size_t visits{};
+    BOOST_REQUIRE_EQUAL(instance.scan<little_record>([&](const link5&,
+        const little_record& record) NOEXCEPT
+    {
+        ++visits;
+        return record.value != 4u;
+    }), error::scan_stopped);
+
+    BOOST_REQUIRE_EQUAL(visits, 5u);
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__slab_scan__populated__body_order)
+{
+    constexpr auto count = 1'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    arraymap<link5, little_slab::size> instance{ head_store, body_store };
+    for (uint32_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(little_slab{ value }));
+
+    uint32_t expected{};
+    BOOST_REQUIRE(!instance.scan<little_slab>([&](const link5& link,
+        const little_slab& slab) NOEXCEPT
+    {
+        const auto ordered = (slab.value == expected) &&
+            (link.value == expected * sizeof(uint32_t));
+
+        ++expected;
+        return ordered;
+    }, 4));
+
+    BOOST_REQUIRE_EQUAL(expected, count);
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__slab_scan__truncated__scan_table)
+{
+    data_chunk head_file;
+    data_chunk body_file{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    const arraymap<link5, little_slab::size> instance{ head_store, body_store };
+
+    // A read failure is distinct from a stop by the visitor.
+    size_t visits{};
+    BOOST_REQUIRE_EQUAL(instance.scan<little_slab>([&](const link5&,
+        const little_slab&) NOEXCEPT
+    {
+        ++visits;
+        return true;
+    }), error::scan_table);
+
+    BOOST_REQUIRE_EQUAL(visits, one);
+}
+
 // record create/close/backup/restore/verify
 // ----------------------------------------------------------------------------
 
@@ -759,6 +997,24 @@ BOOST_AUTO_TEST_CASE(arraymap__record_body_count__non_empty_restore__truncates)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+BOOST_AUTO_TEST_CASE(arraymap__record_body_count__restore_expand__zero_filled)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store };
+    BOOST_REQUIRE(instance.create());
+    head_file = base16_chunk("0100000000");
+    body_file = base16_chunk("123456781234567812345678");
+    BOOST_REQUIRE(instance.restore());
+
+    // Records truncated by restore are not set when expanded over.
+    BOOST_REQUIRE(instance.set(2, little_record{ 0x01020304_u32 }));
+    BOOST_REQUIRE_EQUAL(body_file, base16_chunk("123456780000000004030201"));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 // slab create/close/backup/restore/verify
 // ----------------------------------------------------------------------------
 
@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include "../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(filter_tests)
+
+using namespace system;
+using key = data_array<32>;
+using key_filter = filter<key, unique_hasher>;
+
+// Filter bytes are rounded down to 64 byte blocks.
+constexpr auto filter_bytes = 4096_size;
+
+static key to_key(size_t value) NOEXCEPT
+{
+    key out{};
+    const auto mixed = mix_hasher::mix(value);
+    for (size_t byte = 0; byte < sizeof(mixed); ++byte)
+        out.at(byte) = narrow_cast<uint8_t>(mixed >> to_bits(byte));
+
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(filter__create__zero_bytes__disabled)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    key_filter instance{ store, zero };
+    BOOST_REQUIRE(!instance.enabled());
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(data.empty());
+    BOOST_REQUIRE(instance.verify());
+
+    // Disabled filter contains every key.
+    BOOST_REQUIRE(instance.contains(to_key(42)));
+    BOOST_REQUIRE_EQUAL(instance.rate(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(filter__create__bytes__expected_size)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    key_filter instance{ store, add1(filter_bytes) };
+    BOOST_REQUIRE(instance.enabled());
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE_EQUAL(data.size(), filter_bytes);
+    BOOST_REQUIRE(instance.verify());
+    BOOST_REQUIRE_EQUAL(instance.rate(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(filter__create__non_empty__false)
+{
+    data_chunk data(filter_bytes, 0xff);
+    test::chunk_storage store{ data };
+    key_filter instance{ store, filter_bytes };
+    BOOST_REQUIRE(!instance.create());
+}
+
+BOOST_AUTO_TEST_CASE(filter__verify__size_mismatch__false)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    key_filter instance{ store, filter_bytes };
+    BOOST_REQUIRE(instance.create());
+
+    key_filter resized{ store, two * filter_bytes };
+    BOOST_REQUIRE(!resized.verify());
+    BOOST_REQUIRE(resized.reset());
+    BOOST_REQUIRE(resized.verify());
+    BOOST_REQUIRE_EQUAL(data.size(), two * filter_bytes);
+}
+
+BOOST_AUTO_TEST_CASE(filter__add__key__contained)
+{
+    test::chunk_storage store;
+    key_filter instance{ store, filter_bytes };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.contains(to_key(42)));
+
+    instance.add(to_key(42));
+    BOOST_REQUIRE(instance.contains(to_key(42)));
+    BOOST_REQUIRE_GT(instance.rate(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(filter__reset__added__cleared)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    key_filter instance{ store, filter_bytes };
+    BOOST_REQUIRE(instance.create());
+    instance.add(to_key(42));
+    BOOST_REQUIRE(instance.reset());
+    BOOST_REQUIRE_EQUAL(data.size(), filter_bytes);
+    BOOST_REQUIRE(!instance.contains(to_key(42)));
+    BOOST_REQUIRE_EQUAL(instance.rate(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(filter__contains__many__no_false_negatives_expected_rate)
+{
+    // 16 bits per key.
+    constexpr auto count = to_bits(filter_bytes) / 16u;
+    constexpr auto absent = 100'000u;
+    test::chunk_storage store;
+    key_filter instance{ store, filter_bytes };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        instance.add(to_key(value));
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.contains(to_key(value)));
+
+    size_t positives{};
+    for (size_t value = count; value < count + absent; ++value)
+        positives += instance.contains(to_key(value)) ? 1u : 0u;
+
+    // Measured rate is within a factor of two of the estimated rate.
+    const auto measured = static_cast<double>(positives) / absent;
+    const auto estimated = instance.rate();
+    BOOST_REQUIRE_LT(estimated, 0.01);
+    BOOST_REQUIRE_LT(measured, estimated * 2.0);
+    BOOST_REQUIRE_GT(measured, estimated / 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -18,16 +18,17 @@
  */
 #include "../test.hpp"
 #include "../mocks/chunk_storage.hpp"
+#include <chrono>
 
 BOOST_AUTO_TEST_SUITE(hashmap_tests)
 
 template <typename Link, typename Key, size_t Size>
 class hashmap_
-  : public hashmap<Link, Key, Size, true>
+  : public hashmap<Link, Key, Size, djb2_hasher>
 {
 public:
-    using base = hashmap<Link, Key, Size, true>;
-    using hashmap<Link, Key, Size, true>::hashmap;
+    using base = hashmap<Link, Key, Size, djb2_hasher>;
+    using hashmap<Link, Key, Size, djb2_hasher>::hashmap;
     ////using reader_ptr = std::shared_ptr<reader>;
     ////using finalizer_ptr = std::shared_ptr<finalizer>;
     ////
@@ -466,7 +467,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get__terminal__invalid)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    const hashmap<link5, key10, little_record::size, true> instance{ head_store, body_store, buckets };
+    const hashmap<link5, key10, little_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
 
     little_record record{};
     BOOST_REQUIRE(!instance.get(link5::terminal, record));
@@ -477,7 +478,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get__empty__invalid)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    const hashmap<link5, key10, little_record::size, true> instance{ head_store, body_store, buckets };
+    const hashmap<link5, key10, little_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
 
     little_record record{};
     BOOST_REQUIRE(!instance.get(0, record));
@@ -495,7 +496,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get__populated__valid)
     };
     test::chunk_storage head_store{ head_file };
     test::chunk_storage body_store{ body_file };
-    const hashmap<link5, key10, little_record::size, true> instance{ head_store, body_store, buckets };
+    const hashmap<link5, key10, little_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
 
     little_record record{};
     BOOST_REQUIRE(instance.get(0, record));
@@ -503,11 +504,50 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get__populated__valid)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+class view_record
+{
+public:
+    static constexpr size_t size = sizeof(uint32_t);
+    static constexpr link5 count() NOEXCEPT { return 1; }
+
+    // View fields are positioned from the search key.
+    bool from_memory(const uint8_t* data) NOEXCEPT
+    {
+        key = field<zero, one>::get(data);
+        value = field<array_count<key10>, sizeof(uint32_t)>::get(data);
+        return true;
+    }
+
+    uint8_t key{ 0 };
+    uint32_t value{ 0 };
+};
+
+BOOST_AUTO_TEST_CASE(hashmap__record_get__view_populated__valid)
+{
+    data_chunk head_file;
+    data_chunk body_file
+    {
+        0xa1, 0xa2, 0xa3, 0xa4, 0xa5,
+        0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+        0x01, 0x02, 0x03, 0x04
+    };
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    const hashmap<link5, key10, view_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
+
+    view_record record{};
+    BOOST_REQUIRE(instance.get(0, record));
+    BOOST_REQUIRE_EQUAL(record.key, 0xb1u);
+    BOOST_REQUIRE_EQUAL(record.value, 0x04030201_u32);
+    BOOST_REQUIRE(!instance.get(1, record));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(hashmap__record_put__multiple__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key1_big{ 0x41 };
@@ -598,7 +638,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_put__multiple__expected)
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
 
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key_big{ 0x41 };
@@ -662,7 +702,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get__excess__false)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -677,7 +717,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get_key__excess__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -690,7 +730,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_put__excess__false)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -747,7 +787,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_get__excess__true)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -764,7 +804,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_get_key__excess__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -779,7 +819,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_get__file_excess__false)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -795,7 +835,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_put__excess__false)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -806,7 +846,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_top__default__terminal)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
     BOOST_REQUIRE(instance.top(0).is_terminal());
     BOOST_REQUIRE(instance.top(19).is_terminal());
@@ -817,7 +857,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_top__past_end__terminal)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
     BOOST_REQUIRE(instance.top(20).is_terminal());
     BOOST_REQUIRE(instance.top(21).is_terminal());
@@ -827,7 +867,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_top__existing__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     BOOST_REQUIRE(!instance.put_link({ 0x41 }, big_record{ 0xa1b2c3d4_u32 }).is_terminal());
@@ -860,7 +900,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_exists__exists__true)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -874,7 +914,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_exists__exists__true)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -888,7 +928,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_first__exists__true)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -903,7 +943,7 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_first__exists__true)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_slab::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_slab::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -918,7 +958,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_it__exists__non_terminal)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key{ 0x41 };
@@ -935,7 +975,7 @@ BOOST_AUTO_TEST_CASE(hashmap__record_it__multiple__iterated)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key1, big_record::size, true> instance{ head_store, body_store, buckets };
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
     BOOST_REQUIRE(instance.create());
 
     constexpr key1 key_a{ 0xaa };
@@ -1055,6 +1095,58 @@ BOOST_AUTO_TEST_CASE(hashmap__record_it__multiple__iterated)
 // mutiphase commit.
 // ----------------------------------------------------------------------------
 
+BOOST_AUTO_TEST_CASE(hashmap__record_it__guard_borrowed__iterated)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key_a{ 0xaa };
+    constexpr key1 key_b{ 0xbb };
+    constexpr key1 key_c{ 0xcc };
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a2_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_b, big_record{ 0x000000b1_u32 }).is_terminal());
+
+    // Borrowed iterators cannot be obtained from a temporary guard.
+    using table = hashmap<link5, key1, big_record::size, djb2_hasher>;
+    static_assert(!std::is_constructible_v<table::borrowed_iterator,
+        guard&&, const link5&, const key1&>);
+    static_assert(!std::is_copy_constructible_v<guard>);
+    static_assert(!std::is_move_constructible_v<guard>);
+
+    // Borrowed iterators cannot be carried out of the scope of their guard.
+    static_assert(!std::is_copy_constructible_v<table::borrowed_iterator>);
+    static_assert(!std::is_move_constructible_v<table::borrowed_iterator>);
+    static_assert(std::is_move_constructible_v<table::iterator>);
+
+    // Any number of iterations and reads share one guard.
+    const auto memory = instance.get_guard();
+    BOOST_REQUIRE(memory.get());
+
+    big_record record{};
+    auto it_a = instance.it(memory, key_a);
+    BOOST_REQUIRE(it_a);
+    BOOST_REQUIRE_EQUAL(it_a.get(), memory.get());
+    BOOST_REQUIRE(table::get(it_a, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a2_u32);
+    BOOST_REQUIRE(it_a.advance());
+    BOOST_REQUIRE(table::get(it_a, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a1_u32);
+    BOOST_REQUIRE(!it_a.advance());
+
+    auto it_b = instance.it(memory, key_b);
+    BOOST_REQUIRE(it_b);
+    BOOST_REQUIRE(table::get(memory, it_b.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000b1_u32);
+    BOOST_REQUIRE(!it_b.advance());
+
+    const auto it_c = instance.it(memory, key_c);
+    BOOST_REQUIRE(!it_c);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
 BOOST_AUTO_TEST_CASE(hashmap__allocate__terminal__expected)
 {
     test::chunk_storage head_store{};
@@ -1142,7 +1234,7 @@ BOOST_AUTO_TEST_CASE(hashmap__set_commit__record__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_record::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_record::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr auto size = link5::size + array_count<key10> + flex_record::size;
@@ -1165,7 +1257,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_set_commit__record__expected)
     data_chunk head_file;
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_record::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_record::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr auto size = link5::size + array_count<key10> + flex_record::size;
@@ -1188,7 +1280,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_put1__record__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_record::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_record::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
     
     constexpr auto size = link5::size + array_count<key10> + sizeof(uint32_t);
@@ -1207,7 +1299,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_put2__record__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_record::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_record::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr key10 key1{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a };
@@ -1221,7 +1313,7 @@ BOOST_AUTO_TEST_CASE(hashmap__set_commit_link__slab__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_slab::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_slab::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr auto size = link5::size + array_count<key10> + sizeof(uint32_t);
@@ -1244,7 +1336,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_set_commit__slab__expected)
 {
     test::chunk_storage head_store{};
     test::chunk_storage body_store{};
-    hashmap<link5, key10, flex_slab::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_slab::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr auto size = link5::size + array_count<key10> + sizeof(uint32_t);
@@ -1269,7 +1361,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_put1__slab__expected)
     data_chunk body_file;
     test::chunk_storage head_store{ head_file };
     test::chunk_storage body_store{ body_file };
-    hashmap<link5, key10, flex_slab::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_slab::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr auto size = link5::size + array_count<key10> + sizeof(uint32_t);
@@ -1290,7 +1382,7 @@ BOOST_AUTO_TEST_CASE(hashmap__allocate_put2__slab__expected)
     data_chunk body_file;
     test::chunk_storage head_store{ head_file };
     test::chunk_storage body_store{ body_file };
-    hashmap<link5, key10, flex_slab::size, true> instance{ head_store, body_store, 2 };
+    hashmap<link5, key10, flex_slab::size, djb2_hasher> instance{ head_store, body_store, 2 };
     BOOST_REQUIRE(instance.create());
 
     constexpr key10 key1{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a };
@@ -1531,6 +1623,898 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_body_count__non_empty_restore__truncates)
     BOOST_REQUIRE(!instance.get_fault());
 }
 
+// growth
+// ----------------------------------------------------------------------------
+
+static key10 to_key(size_t value) NOEXCEPT
+{
+    key10 key{};
+    key.at(0) = narrow_cast<uint8_t>(value);
+    key.at(1) = narrow_cast<uint8_t>(value >> byte_bits);
+    return key;
+}
+
+template <typename Table>
+static bool all_found(const Table& instance, size_t count) NOEXCEPT
+{
+    for (size_t value = 0; value < count; ++value)
+    {
+        little_record record{};
+        if (!instance.get(instance.first(to_key(value)), record) ||
+            record.value != value)
+            return false;
+    }
+
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__grow__rehash__all_found)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.grow());
+    BOOST_REQUIRE(instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), two * buckets + buckets);
+    BOOST_REQUIRE(all_found(instance, count));
+
+    BOOST_REQUIRE(instance.rehash(5));
+    BOOST_REQUIRE(instance.is_migrating());
+    BOOST_REQUIRE(all_found(instance, count));
+
+    BOOST_REQUIRE(instance.rehash(buckets));
+    BOOST_REQUIRE(!instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), two * buckets);
+    BOOST_REQUIRE(all_found(instance, count));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__rehash__duplicates__order_retained)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key{ 0xaa };
+    BOOST_REQUIRE(!instance.put_link(key, big_record{ 0x000000a1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key, big_record{ 0x000000a2_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key, big_record{ 0x000000a3_u32 }).is_terminal());
+    BOOST_REQUIRE(instance.grow());
+    BOOST_REQUIRE(instance.rehash(buckets));
+    BOOST_REQUIRE(!instance.is_migrating());
+
+    auto it = instance.it(key);
+    big_record record{};
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a3_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a2_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a1_u32);
+    BOOST_REQUIRE(!it.advance());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__verify__grown__all_found)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.grow());
+    BOOST_REQUIRE(instance.rehash(7));
+    BOOST_REQUIRE(instance.close());
+
+    record_table reopened{ head_store, body_store, buckets };
+    BOOST_REQUIRE(reopened.verify());
+    BOOST_REQUIRE(reopened.is_migrating());
+    BOOST_REQUIRE_EQUAL(reopened.buckets(), instance.buckets());
+    BOOST_REQUIRE(all_found(reopened, count));
+    BOOST_REQUIRE(!reopened.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put__load_exceeded__not_grown)
+{
+    constexpr auto count = 10'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets, false, 1 };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(!instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), buckets);
+    BOOST_REQUIRE(all_found(instance, count));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__maintain__load_exceeded__grows_and_migrates)
+{
+    // Migration completes at the second step (fewer than 4096 prior buckets).
+    constexpr auto count = 10'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets, false, 1 };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.maintain());
+    BOOST_REQUIRE(instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), two * buckets);
+    BOOST_REQUIRE(instance.maintain());
+    BOOST_REQUIRE(!instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), two * buckets);
+    BOOST_REQUIRE(all_found(instance, count));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__maintain__no_load__not_grown)
+{
+    constexpr auto count = 10'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.maintain());
+    BOOST_REQUIRE(!instance.is_migrating());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), buckets);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+// first_many/find_many
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(hashmap__first_many__empty__empty)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.first_many({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__first_many__mixed__expected)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<key10> keys{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+        // Each present key is followed by an absent key.
+        keys.push_back(to_key(value));
+        keys.push_back(to_key(value + count));
+    }
+
+    const auto links = instance.first_many(keys);
+    BOOST_REQUIRE_EQUAL(links.size(), keys.size());
+    for (size_t index = 0; index < keys.size(); ++index)
+        BOOST_REQUIRE_EQUAL(links.at(index), instance.first(keys.at(index)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__first_many__filter__expected)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, 4096, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<key10> keys{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+        keys.push_back(to_key(value + count));
+        keys.push_back(to_key(value));
+    }
+
+    const auto links = instance.first_many(keys);
+    for (size_t index = 0; index < keys.size(); ++index)
+        BOOST_REQUIRE_EQUAL(links.at(index), instance.first(keys.at(index)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__find_many__present__expected)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<key10> keys{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+        keys.push_back(to_key(sub1(count) - value));
+    }
+
+    std_vector<little_record> records{};
+    BOOST_REQUIRE(instance.find_many(keys, records));
+    BOOST_REQUIRE_EQUAL(records.size(), count);
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(records.at(index).value, sub1(count) - index);
+
+    // Any absent key fails.
+    keys.push_back(to_key(count));
+    BOOST_REQUIRE(!instance.find_many(keys, records));
+    BOOST_REQUIRE_EQUAL(records.size(), add1(count));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+// put_many
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__empty__true)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<link5> links{};
+    BOOST_REQUIRE(instance.put_many<little_record>({}, {}, links));
+    BOOST_REQUIRE(links.empty());
+    BOOST_REQUIRE_EQUAL(instance.body_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__size_mismatch__false)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    const std_vector<key10> keys{ to_key(1), to_key(2) };
+    const std_vector<little_record> records{ { 1 } };
+    BOOST_REQUIRE(!instance.put_many<little_record>(keys, records));
+    BOOST_REQUIRE_EQUAL(instance.body_size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__mixed__expected)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<key10> keys{};
+    std_vector<little_record> records{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        keys.push_back(to_key(value));
+        records.push_back({ narrow_cast<uint32_t>(value) });
+    }
+
+    std_vector<link5> links{};
+    BOOST_REQUIRE(instance.put_many<little_record>(keys, records, links));
+    BOOST_REQUIRE_EQUAL(links.size(), count);
+    BOOST_REQUIRE_EQUAL(instance.body_size(), count * element_size);
+    BOOST_REQUIRE(all_found(instance, count));
+
+    // Links are returned in key order.
+    for (size_t index = 0; index < count; ++index)
+        BOOST_REQUIRE_EQUAL(links.at(index), instance.first(keys.at(index)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__duplicates__order_retained)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size, djb2_hasher> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key{ 0xaa };
+    constexpr key1 other{ 0xbb };
+    BOOST_REQUIRE(!instance.put_link(key, big_record{ 0x000000a0_u32 }).is_terminal());
+
+    const std_vector<key1> keys{ key, other, key, key };
+    const std_vector<big_record> records
+    {
+        { 0x000000a1_u32 }, { 0x000000b1_u32 }, { 0x000000a2_u32 }, { 0x000000a3_u32 }
+    };
+
+    BOOST_REQUIRE(instance.put_many<big_record>(keys, records));
+
+    // Conflicts are iterated from most recent (in key order) to prior puts.
+    auto it = instance.it(key);
+    big_record record{};
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a3_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a2_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a1_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a0_u32);
+    BOOST_REQUIRE(!it.advance());
+
+    BOOST_REQUIRE(instance.get(instance.first(other), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000b1_u32);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__filter__expected)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, 4096, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    std_vector<key10> keys{};
+    std_vector<little_record> records{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        keys.push_back(to_key(value));
+        records.push_back({ narrow_cast<uint32_t>(value) });
+    }
+
+    BOOST_REQUIRE(instance.put_many<little_record>(keys, records));
+    BOOST_REQUIRE(all_found(instance, count));
+    for (const auto& key: keys)
+        BOOST_REQUIRE(instance.exists(key));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+// scan
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(hashmap__scan__empty__true)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    size_t visits{};
+    BOOST_REQUIRE(!instance.scan<little_record>([&](const link5&, const key10&,
+        const little_record&) NOEXCEPT
+    {
+        ++visits;
+        return true;
+    }, 4));
+
+    BOOST_REQUIRE_EQUAL(visits, zero);
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__scan__threads__all_visited_once)
+{
+    constexpr auto count = 10'000u;
+    constexpr link5 many{ 5'000u };
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, many };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    std::vector<std::atomic<size_t>> visits(count);
+    std::atomic_bool matched{ true };
+    BOOST_REQUIRE(!instance.scan<little_record>([&](const link5& link,
+        const key10& key, const little_record& record) NOEXCEPT
+    {
+        matched = matched && (key == to_key(record.value)) &&
+            (record.value == link.value);
+
+        ++visits.at(record.value);
+        return true;
+    }, 4));
+
+    BOOST_REQUIRE(matched);
+    for (const auto& visit: visits)
+        BOOST_REQUIRE_EQUAL(visit.load(), one);
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__scan__stopped__scan_stopped)
+{
+    constexpr auto count = 10u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    size_t visits{};
+    BOOST_REQUIRE_EQUAL(instance.scan<little_record>([&](const link5&,
+        const key10&, const little_record&) NOEXCEPT
+    {
+        return ++visits != 3u;
+    }), error::scan_stopped);
+
+    BOOST_REQUIRE_EQUAL(visits, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__scan__maintain__deferred)
+{
+    constexpr auto count = 10'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets, false, 1 };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    // Maintenance on another thread is deferred for the duration of the scan.
+    size_t visits{};
+    std::atomic_bool deferred{ true };
+    BOOST_REQUIRE(!instance.scan<little_record>([&](const link5&, const key10&,
+        const little_record&) NOEXCEPT
+    {
+        if (is_zero(visits++))
+        {
+            std::thread maintainer([&]() NOEXCEPT
+            {
+                deferred = instance.maintain() && !instance.is_migrating() &&
+                    (instance.buckets() == buckets);
+            });
+
+            maintainer.join();
+        }
+
+        return true;
+    }));
+
+    BOOST_REQUIRE(deferred);
+    BOOST_REQUIRE_EQUAL(visits, count);
+    BOOST_REQUIRE(instance.maintain());
+    BOOST_REQUIRE(instance.is_migrating());
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+// filter
+// ----------------------------------------------------------------------------
+
+constexpr auto filter_bytes = 4096_size;
+
+BOOST_AUTO_TEST_CASE(hashmap__create__filter__expected_size)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, filter_bytes, buckets };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE_EQUAL(filter_store.buffer().size(), filter_bytes);
+    BOOST_REQUIRE_EQUAL(instance.filter_rate(), 0.0);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__filter_rate__no_filter__one)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    record_table instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE_EQUAL(instance.filter_rate(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__exists__filter__expected)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, filter_bytes, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(all_found(instance, count));
+    for (size_t value = count; value < two * count; ++value)
+    {
+        BOOST_REQUIRE(!instance.exists(to_key(value)));
+        BOOST_REQUIRE(instance.it(to_key(value)).self().is_terminal());
+    }
+
+    BOOST_REQUIRE_GT(instance.filter_rate(), 0.0);
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__restore__cleared_filter__rebuilt)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, filter_bytes, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.backup());
+
+    // Filter is not archived (restored empty).
+    filter_store.buffer().clear();
+    BOOST_REQUIRE(instance.restore());
+    BOOST_REQUIRE_EQUAL(filter_store.buffer().size(), filter_bytes);
+    BOOST_REQUIRE(all_found(instance, count));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__verify__resized_filter__rebuilt)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    test::chunk_storage filter_store{};
+    record_table instance{ head_store, body_store, filter_store, filter_bytes, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.close());
+
+    record_table resized{ head_store, body_store, filter_store, two * filter_bytes, buckets };
+    BOOST_REQUIRE(resized.verify());
+    BOOST_REQUIRE_EQUAL(filter_store.buffer().size(), two * filter_bytes);
+    BOOST_REQUIRE(all_found(resized, count));
+    BOOST_REQUIRE(!resized.get_fault());
+}
+
+// fingerprint
+// ----------------------------------------------------------------------------
+
+using fingerprint_table = hashmap<link5, key10, record4::size,
+    fingerprinted<unique_hasher>>;
+
+BOOST_AUTO_TEST_CASE(hashmap__exists__fingerprint_aligned__expected)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    fingerprint_table instance{ head_store, body_store, buckets, true };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(all_found(instance, count));
+    for (size_t value = count; value < two * count; ++value)
+        BOOST_REQUIRE(!instance.exists(to_key(value)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__rehash__fingerprint_aligned__all_found)
+{
+    constexpr auto count = 200u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    fingerprint_table instance{ head_store, body_store, buckets, true };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        }));
+
+    BOOST_REQUIRE(instance.grow());
+    BOOST_REQUIRE(instance.rehash(7));
+    BOOST_REQUIRE(all_found(instance, count));
+    BOOST_REQUIRE(instance.rehash(buckets));
+    BOOST_REQUIRE(!instance.is_migrating());
+    BOOST_REQUIRE(all_found(instance, count));
+
+    for (size_t value = count; value < two * count; ++value)
+        BOOST_REQUIRE(!instance.exists(to_key(value)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+// Keys are scattered (mixed) so that list elements are not adjacent.
+static key10 to_scattered(size_t value) NOEXCEPT
+{
+    key10 key{};
+    const auto mixed = mix_hasher::mix(value);
+    std::copy_n(pointer_cast<const uint8_t>(&mixed), sizeof(mixed),
+        key.begin());
+    return key;
+}
+
+template <typename Hash>
+static void exists_then_put(const std::string& name) NOEXCEPT
+{
+    // Models IBD unique key writes (exists miss, then put), with a long
+    // average conflict list so that misses would otherwise walk the body.
+    constexpr auto count = 1'000'000u;
+    constexpr link5 heads{ count / 4u };
+    using table = hashmap<link5, key10, record4::size, Hash>;
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table instance{ head_store, body_store, heads, true };
+    BOOST_REQUIRE(instance.create());
+
+    size_t hits{};
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+    {
+        const auto key = to_scattered(value);
+        if (instance.exists(key))
+        {
+            ++hits;
+            continue;
+        }
+
+        instance.put(key, little_record{ narrow_cast<uint32_t>(value) });
+    }
+
+    const auto span = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    BOOST_TEST_MESSAGE(name << " exists/put " << count << " keys : "
+        << span.count() << " ms (" << hits << " hits)");
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__exists_then_put__fingerprint__performance)
+{
+    exists_then_put<unique_hasher>("unfiltered");
+    exists_then_put<fingerprinted<unique_hasher>>("fingerprinted");
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__first_many__batched__performance)
+{
+    // Models block-wide prevout searches, with a table exceeding cache.
+    constexpr auto count = 4'000'000u;
+    constexpr auto batch = 4'000u;
+    constexpr link5 heads{ count };
+    using table = hashmap<link5, key10, record4::size, unique_hasher>;
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table instance{ head_store, body_store, heads, true };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        instance.put(to_scattered(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        });
+
+    // Searched keys are in an order unrelated to their insertion.
+    std_vector<key10> keys(batch);
+    const auto to_keys = [&](size_t round) NOEXCEPT
+    {
+        for (size_t index = 0; index < batch; ++index)
+            keys.at(index) = to_scattered(mix_hasher::mix(round * batch +
+                index) % count);
+    };
+
+    const auto measure = [&](const std::string& name, auto&& search) NOEXCEPT
+    {
+        size_t found{};
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < count / batch; ++round)
+        {
+            to_keys(round);
+            found += search();
+        }
+
+        const auto span = std::chrono::duration_cast<
+            std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                start);
+
+        BOOST_TEST_MESSAGE(name << " " << count << " keys : " << span.count()
+            << " ms (" << found << " found)");
+    };
+
+    measure("serial", [&]() NOEXCEPT
+    {
+        size_t found{};
+        for (const auto& key: keys)
+            found += instance.first(key).is_terminal() ? 0u : 1u;
+
+        return found;
+    });
+
+    measure("batched", [&]() NOEXCEPT
+    {
+        size_t found{};
+        for (const auto& link: instance.first_many(keys))
+            found += link.is_terminal() ? 0u : 1u;
+
+        return found;
+    });
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__put_many__bucket_sorted__performance)
+{
+    // Models initial build of a table exceeding cache, in block-sized batches.
+    constexpr auto count = 4'000'000u;
+    constexpr auto batch = 4'000u;
+    constexpr link5 heads{ count };
+    using table = hashmap<link5, key10, record4::size, unique_hasher>;
+
+    std_vector<key10> keys(batch);
+    std_vector<little_record> records(batch);
+    const auto measure = [&](const std::string& name, auto&& put) NOEXCEPT
+    {
+        test::chunk_storage head_store{};
+        test::chunk_storage body_store{};
+        table instance{ head_store, body_store, heads, true };
+        BOOST_REQUIRE(instance.create());
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t round = 0; round < count / batch; ++round)
+        {
+            for (size_t index = 0; index < batch; ++index)
+            {
+                const auto value = round * batch + index;
+                keys.at(index) = to_scattered(value);
+                records.at(index).value = narrow_cast<uint32_t>(value);
+            }
+
+            BOOST_REQUIRE(put(instance));
+        }
+
+        const auto span = std::chrono::duration_cast<
+            std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                start);
+
+        BOOST_TEST_MESSAGE(name << " " << count << " keys : " << span.count()
+            << " ms");
+    };
+
+    measure("serial", [&](table& instance) NOEXCEPT
+    {
+        auto success = true;
+        for (size_t index = 0; index < batch; ++index)
+            success &= instance.put(keys.at(index), records.at(index));
+
+        return success;
+    });
+
+    measure("bulk", [&](table& instance) NOEXCEPT
+    {
+        return instance.put_many<little_record>(keys, records);
+    });
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__first__long_lists__performance)
+{
+    // Models searches of hash keyed tables with an average conflict list of
+    // eight elements, walked to the last (or first inserted) match.
+    constexpr auto count = 2'000'000u;
+    constexpr link5 heads{ count / 8u };
+    using key32 = data_array<32>;
+    using table = hashmap<link5, key32, record4::size, unique_hasher>;
+
+    const auto to_hash = [](size_t value) NOEXCEPT
+    {
+        key32 key{};
+        for (size_t word = 0; word < 4u; ++word)
+        {
+            const auto mixed = mix_hasher::mix(value + word);
+            std::copy_n(pointer_cast<const uint8_t>(&mixed), sizeof(mixed),
+                std::next(key.begin(), word * sizeof(mixed)));
+        }
+
+        return key;
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table instance{ head_store, body_store, heads, true };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+        instance.put(to_hash(value), little_record
+        {
+            narrow_cast<uint32_t>(value)
+        });
+
+    size_t found{};
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+        found += instance.first(to_hash(value)).is_terminal() ? 0u : 1u;
+
+    const auto span = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    BOOST_TEST_MESSAGE("first " << count << " keys : " << span.count()
+        << " ms (" << found << " found)");
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
 ////std::cout << head_file << std::endl << std::endl;
 ////std::cout << body_file << std::endl << std::endl;
 
@@ -18,6 +18,9 @@
  */
 #include "../test.hpp"
 #include "../mocks/chunk_storage.hpp"
+#include <chrono>
+#include <random>
+#include <thread>
 
 BOOST_AUTO_TEST_SUITE(head_tests)
 
@@ -37,8 +40,10 @@ static_assert(buckets == 20u);
 
 using link = linkage<link_size>;
 using key = data_array<key_size>;
-using djb2_header = head<link, key, true>;
-using unique_header = head<link, key, false>;
+using djb2_header = head<link, key, djb2_hasher>;
+using unique_header = head<link, key, unique_hasher>;
+using mix_header = head<link, key, mix_hasher>;
+using fingerprint_header = head<link, key, fingerprinted<unique_hasher>>;
 
 class nullptr_storage
   : public test::chunk_storage
@@ -136,6 +141,51 @@ BOOST_AUTO_TEST_CASE(head__djb2_hash__null_key__expected)
     BOOST_REQUIRE_EQUAL(head.index(null_key), expected);
 }
 
+BOOST_AUTO_TEST_CASE(head__mix_hasher__mix__expected)
+{
+    BOOST_REQUIRE_EQUAL(mix_hasher::mix(0), 0u);
+    BOOST_REQUIRE_EQUAL(mix_hasher::mix(1), 0xb456bcfc34c2cb2c_u64);
+}
+
+BOOST_AUTO_TEST_CASE(head__mix_hash__key__expected)
+{
+    constexpr key value{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+
+    test::chunk_storage store;
+    mix_header head{ store, buckets };
+
+    if constexpr (build_x64)
+    {
+        BOOST_REQUIRE_EQUAL(head.index(value), 12u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(head__index__power_of_two__modulo)
+{
+    constexpr auto power = 16u;
+    test::chunk_storage store;
+    unique_header head{ store, power };
+
+    for (uint8_t byte = 0; byte < 64u; ++byte)
+    {
+        const key value{ byte, 0xff, 0x42 };
+        BOOST_REQUIRE_EQUAL(head.index(value),
+            system::unique_hash(value) % power);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(head__index__mix_hasher__within_buckets)
+{
+    test::chunk_storage store;
+
+    for (const auto count: { 1u, 7u, 16u, 1000u })
+    {
+        mix_header head{ store, count };
+        for (uint8_t byte = 0; byte < 64u; ++byte)
+            BOOST_REQUIRE_LT(head.index(key{ byte, 0x42 }), count);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(head__top__link__terminal)
 {
     test::chunk_storage store;
@@ -202,4 +252,511 @@ BOOST_AUTO_TEST_CASE(head__push__key__terminal)
     BOOST_REQUIRE_EQUAL(head.top(null_key), expected);
 }
 
+// aligned
+// ----------------------------------------------------------------------------
+
+// Aligned buckets (and body count) occupy 8 byte slots.
+constexpr auto aligned_head_size = add1(buckets) * sizeof(uint64_t);
+
+BOOST_AUTO_TEST_CASE(head__create__aligned__expected_size)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets, true };
+    BOOST_REQUIRE_EQUAL(head.size(), aligned_head_size);
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE_EQUAL(data.size(), aligned_head_size);
+    BOOST_REQUIRE(head.verify());
+}
+
+BOOST_AUTO_TEST_CASE(head__verify__aligned_mismatch__false)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header unaligned{ store, buckets };
+    BOOST_REQUIRE(unaligned.create());
+    djb2_header aligned{ store, buckets, true };
+    BOOST_REQUIRE(!aligned.verify());
+}
+
+BOOST_AUTO_TEST_CASE(head__set_body_count__aligned__expected)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    constexpr auto expected = 42u;
+    BOOST_REQUIRE(head.set_body_count(expected));
+
+    link count{};
+    BOOST_REQUIRE(head.get_body_count(count));
+    BOOST_REQUIRE_EQUAL(count, expected);
+}
+
+BOOST_AUTO_TEST_CASE(head__push__aligned__expected)
+{
+    test::chunk_storage store;
+    djb2_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    constexpr link link_key{ 9u };
+    BOOST_REQUIRE(head.top(link_key).is_terminal());
+
+    typename link::bytes next{ 42u };
+    BOOST_REQUIRE(head.push(link{ 2u }, next, link_key));
+    BOOST_REQUIRE(link{ next }.is_terminal());
+    BOOST_REQUIRE_EQUAL(head.top(link_key), 2u);
+
+    BOOST_REQUIRE(head.push(link{ 3u }, next, link_key));
+    BOOST_REQUIRE_EQUAL(link{ next }, 2u);
+    BOOST_REQUIRE_EQUAL(head.top(link_key), 3u);
+
+    // Neighboring buckets are unaffected.
+    BOOST_REQUIRE(head.top(sub1(link_key)).is_terminal());
+    BOOST_REQUIRE(head.top(add1(link_key)).is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(head__push__aligned_concurrent__all_linked)
+{
+    constexpr auto threads = 8u;
+    constexpr auto pushes = 10'000u;
+    constexpr auto elements = threads * pushes;
+    test::chunk_storage store;
+    djb2_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    // Element n is pushed into bucket n % buckets, next links are retained.
+    std::vector<typename link::bytes> nexts(elements);
+    std::vector<std::thread> pool{};
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        pool.emplace_back([&, thread]() NOEXCEPT
+        {
+            for (auto element = thread; element < elements; element += threads)
+                head.push(link{ element }, nexts[element],
+                    link{ element % buckets });
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    // Every element is reachable exactly once from its bucket.
+    std::vector<bool> found(elements);
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+        for (auto next = head.top(bucket); !next.is_terminal();
+            next = nexts[next])
+        {
+            BOOST_REQUIRE_EQUAL(next % buckets, bucket);
+            BOOST_REQUIRE(!found[next]);
+            found[next] = true;
+        }
+    }
+
+    BOOST_REQUIRE(std::all_of(found.begin(), found.end(), [](bool value)
+    {
+        return value;
+    }));
+}
+
+// growth
+// ----------------------------------------------------------------------------
+
+// Trailer of grown head is five 64 bit fields.
+constexpr auto trailer_size = 5u * sizeof(uint64_t);
+
+BOOST_AUTO_TEST_CASE(head__open__created__initial_layout)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+
+    djb2_header reopened{ store, buckets };
+    BOOST_REQUIRE(reopened.open());
+    BOOST_REQUIRE(!reopened.is_migrating());
+    BOOST_REQUIRE_EQUAL(reopened.buckets(), buckets);
+    BOOST_REQUIRE_EQUAL(reopened.size(), head_size);
+}
+
+BOOST_AUTO_TEST_CASE(head__grow__unaligned__expected_layout)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+
+    constexpr auto expected = head_size + two * buckets * link_size +
+        trailer_size;
+    BOOST_REQUIRE_EQUAL(data.size(), expected);
+    BOOST_REQUIRE_EQUAL(head.size(), expected);
+    BOOST_REQUIRE_EQUAL(head.buckets(), two * buckets + buckets);
+    BOOST_REQUIRE_EQUAL(head.cursor(), two * buckets);
+    BOOST_REQUIRE(head.is_migrating());
+    BOOST_REQUIRE(head.verify());
+}
+
+BOOST_AUTO_TEST_CASE(head__grow__aligned__expected_layout)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+
+    constexpr auto expected = aligned_head_size +
+        two * buckets * sizeof(uint64_t) + trailer_size;
+    BOOST_REQUIRE_EQUAL(data.size(), expected);
+    BOOST_REQUIRE(head.verify());
+}
+
+BOOST_AUTO_TEST_CASE(head__grow__migrating__false)
+{
+    test::chunk_storage store;
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+    BOOST_REQUIRE(!head.grow());
+}
+
+BOOST_AUTO_TEST_CASE(head__advance__all__migration_complete)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+    const auto size = data.size();
+
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+        BOOST_REQUIRE_EQUAL(head.cursor(), two * buckets + bucket);
+        BOOST_REQUIRE(head.advance());
+    }
+
+    BOOST_REQUIRE(!head.is_migrating());
+    BOOST_REQUIRE(!head.advance());
+    BOOST_REQUIRE(head.cursor().is_terminal());
+    BOOST_REQUIRE_EQUAL(head.buckets(), two * buckets);
+    BOOST_REQUIRE_EQUAL(data.size(), size);
+    BOOST_REQUIRE(head.verify());
+}
+
+BOOST_AUTO_TEST_CASE(head__advance__migrated_bucket__terminal)
+{
+    test::chunk_storage store;
+    unique_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+
+    constexpr key key25{ 25u };
+    typename link::bytes next{};
+    BOOST_REQUIRE(head.push(link{ 7u }, next, key25));
+    BOOST_REQUIRE(head.grow());
+
+    // Unmigrated prior bucket follows current buckets.
+    constexpr auto prior = two * buckets + (25u % buckets);
+    BOOST_REQUIRE_EQUAL(head.index(key25), prior);
+    BOOST_REQUIRE_EQUAL(head.top(key25), 7u);
+
+    for (size_t bucket = 0; bucket <= (25u % buckets); ++bucket)
+        BOOST_REQUIRE(head.advance());
+
+    // Migrated key is indexed into current, prior bucket is terminated.
+    BOOST_REQUIRE_EQUAL(head.index(key25), 25u);
+    BOOST_REQUIRE_EQUAL(head.rehash(key25), 25u);
+    BOOST_REQUIRE(head.top(key25).is_terminal());
+    BOOST_REQUIRE(head.top(link{ prior }).is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(head__open__migrating__expected_layout)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    unique_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+    BOOST_REQUIRE(head.advance());
+    BOOST_REQUIRE(head.advance());
+    BOOST_REQUIRE(head.advance());
+
+    unique_header reopened{ store, buckets };
+    BOOST_REQUIRE(reopened.open());
+    BOOST_REQUIRE(reopened.is_migrating());
+    BOOST_REQUIRE_EQUAL(reopened.size(), data.size());
+    BOOST_REQUIRE_EQUAL(reopened.buckets(), head.buckets());
+    BOOST_REQUIRE_EQUAL(reopened.cursor(), head.cursor());
+    BOOST_REQUIRE_EQUAL(reopened.index(key{ 25u }), head.index(key{ 25u }));
+    BOOST_REQUIRE_EQUAL(reopened.index(key{ 1u }), head.index(key{ 1u }));
+}
+
+BOOST_AUTO_TEST_CASE(head__grow__grown__appends_region)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+        BOOST_REQUIRE(head.advance());
+
+    BOOST_REQUIRE(head.grow());
+    constexpr auto expected = head_size + two * buckets * link_size +
+        4u * buckets * link_size + trailer_size;
+    BOOST_REQUIRE_EQUAL(data.size(), expected);
+    BOOST_REQUIRE_EQUAL(head.buckets(), 4u * buckets + two * buckets);
+
+    djb2_header reopened{ store, buckets };
+    BOOST_REQUIRE(reopened.open());
+    BOOST_REQUIRE_EQUAL(reopened.buckets(), head.buckets());
+    BOOST_REQUIRE_EQUAL(reopened.cursor(), 4u * buckets);
+}
+
+BOOST_AUTO_TEST_CASE(head__open__truncated_trailer__false)
+{
+    data_chunk data;
+    test::chunk_storage store{ data };
+    djb2_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+    BOOST_REQUIRE(head.grow());
+    data.resize(sub1(data.size()));
+
+    djb2_header reopened{ store, buckets };
+    BOOST_REQUIRE(!reopened.open());
+}
+
+// fingerprint
+// ----------------------------------------------------------------------------
+
+static key to_key(size_t value) NOEXCEPT
+{
+    key out{};
+    out.at(0) = narrow_cast<uint8_t>(value);
+    out.at(1) = narrow_cast<uint8_t>(value >> byte_bits);
+    return out;
+}
+
+BOOST_AUTO_TEST_CASE(head__top__fingerprint_pushed__found)
+{
+    constexpr auto count = 1'000u;
+    test::chunk_storage store;
+    fingerprint_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    // No false negatives, regardless of conflict list length.
+    typename link::bytes next{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE(head.push(link{ value }, next, to_key(value)));
+        BOOST_REQUIRE(!head.top(to_key(value)).is_terminal());
+    }
+
+    for (size_t value = 0; value < count; ++value)
+        BOOST_REQUIRE(!head.top(to_key(value)).is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(head__top__fingerprint_excluded__terminal)
+{
+    constexpr auto count = 100u;
+    test::chunk_storage store;
+    fingerprint_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    typename link::bytes next{};
+    BOOST_REQUIRE(head.push(link{ 42u }, next, key{ 5u }));
+    BOOST_REQUIRE_EQUAL(head.top(key{ 5u }), 42u);
+
+    // Keys of the same bucket are mostly excluded by fingerprint.
+    size_t excluded{};
+    for (size_t value = 1; value <= count; ++value)
+    {
+        const auto other = to_key(5u + value * buckets);
+        BOOST_REQUIRE_EQUAL(head.index(other), 5u);
+        excluded += head.top(other).is_terminal() ? 1u : 0u;
+    }
+
+    BOOST_REQUIRE_GT(excluded, 90u);
+    BOOST_REQUIRE_EQUAL(head.top(link{ 5u }), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(head__top__fingerprint_unaligned__not_excluded)
+{
+    test::chunk_storage store;
+    fingerprint_header head{ store, buckets };
+    BOOST_REQUIRE(head.create());
+
+    typename link::bytes next{};
+    BOOST_REQUIRE(head.push(link{ 42u }, next, key{ 5u }));
+
+    for (size_t value = 1; value <= 100u; ++value)
+        BOOST_REQUIRE_EQUAL(head.top(to_key(5u + value * buckets)), 42u);
+}
+
+BOOST_AUTO_TEST_CASE(head__push__fingerprint_index__not_excluded)
+{
+    test::chunk_storage store;
+    fingerprint_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    // Push without key saturates the bucket filter.
+    typename link::bytes next{};
+    BOOST_REQUIRE(head.push(link{ 42u }, next, link{ 5u }));
+    BOOST_REQUIRE(head.push(link{ 43u }, next, key{ 25u }));
+    BOOST_REQUIRE_EQUAL(link{ next }, 42u);
+
+    for (size_t value = 0; value <= 100u; ++value)
+        BOOST_REQUIRE_EQUAL(head.top(to_key(5u + value * buckets)), 43u);
+}
+
+BOOST_AUTO_TEST_CASE(head__push__fingerprint_emptied__filter_reset)
+{
+    test::chunk_storage store;
+    fingerprint_header head{ store, buckets, true };
+    BOOST_REQUIRE(head.create());
+
+    // Filter of an empty (terminal) bucket is not accumulated.
+    typename link::bytes next{};
+    BOOST_REQUIRE(head.push(link{ 42u }, next, link{ 5u }));
+    BOOST_REQUIRE(head.push(link{ link::terminal }, next, link{ 5u }));
+    BOOST_REQUIRE(head.push(link{ 43u }, next, key{ 5u }));
+    BOOST_REQUIRE(link{ next }.is_terminal());
+
+    size_t excluded{};
+    for (size_t value = 1; value <= 100u; ++value)
+        excluded += head.top(to_key(5u + value * buckets)).is_terminal() ?
+            1u : 0u;
+
+    BOOST_REQUIRE_GT(excluded, 90u);
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+// Compares concurrent pushes to mutex guarded and aligned (lock-free) buckets.
+template <typename Head>
+double pushes_per_second(Head& head, size_t threads, size_t pushes) NOEXCEPT
+{
+    std::vector<std::thread> pool{};
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        pool.emplace_back([&, thread]() NOEXCEPT
+        {
+            typename link::bytes next{};
+            for (size_t push = 0; push < pushes; ++push)
+                head.push(link{ push }, next, link{ (push * threads + thread) %
+                    head.buckets() });
+        });
+    }
+
+    for (auto& thread: pool)
+        thread.join();
+
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    return (threads * pushes) / elapsed.count();
+}
+
+BOOST_AUTO_TEST_CASE(head__push__concurrent__performance)
+{
+    constexpr auto pushes = 1'000'000u;
+    constexpr auto table = 1'000'000u;
+    test::chunk_storage locked_store;
+    test::chunk_storage aligned_store;
+    djb2_header locked{ locked_store, table };
+    djb2_header aligned{ aligned_store, table, true };
+    BOOST_REQUIRE(locked.create());
+    BOOST_REQUIRE(aligned.create());
+
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        const auto before = pushes_per_second(locked, threads, pushes);
+        const auto after = pushes_per_second(aligned, threads, pushes);
+        BOOST_TEST_MESSAGE("head::push threads [" << threads << "] mutex ["
+            << before << "/s] aligned [" << after << "/s]");
+    }
+}
+
+// Bucket distribution and index throughput of each hasher for the key shapes
+// of tables: hash keys (header/transaction/point), sequential surrogate keys
+// (strong_tx/txs) and surrogate keys with ordinal (spend).
+template <typename Hasher, size_t Size>
+void report_index(const std::string& table,
+    const std::vector<data_array<Size>>& keys, size_t count) NOEXCEPT
+{
+    test::chunk_storage store;
+    const head<link, data_array<Size>, Hasher> head{ store, count };
+
+    size_t sum{};
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& key: keys)
+        sum += head.index(key);
+
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::vector<size_t> chains(count);
+    for (const auto& key: keys)
+        ++chains.at(head.index(key));
+
+    const auto empty = std::count(chains.begin(), chains.end(), zero);
+    const auto longest = *std::max_element(chains.begin(), chains.end());
+    BOOST_TEST_MESSAGE(table << " buckets [" << count << "] empty ["
+        << (100.0 * empty) / count << "%] longest [" << longest << "] index ["
+        << elapsed.count() / keys.size() << "ns] (" << sum % 2u << ")");
+}
+
+template <size_t Size>
+void report_hashers(const std::string& table,
+    const std::vector<data_array<Size>>& keys) NOEXCEPT
+{
+    // Modulo (not power of two) and mask (power of two) reductions.
+    for (const auto count: { 1'000'003_size, 1'048'576_size })
+    {
+        report_index<unique_hasher>(table + " unique", keys, count);
+        report_index<djb2_hasher>(table + " djb2", keys, count);
+        report_index<mix_hasher>(table + " mix", keys, count);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(head__index__distribution__performance)
+{
+    constexpr auto count = 1'000'000u;
+    std::mt19937_64 random{ 42 };
+
+    std::vector<data_array<32>> hashes(count);
+    for (auto& hash: hashes)
+        for (auto& byte: hash)
+            byte = possible_narrow_cast<uint8_t>(random());
+
+    // Sequential links, little endian (as serialized).
+    std::vector<data_array<4>> links(count);
+    for (size_t link = 0; link < count; ++link)
+        for (size_t byte = 0; byte < 4u; ++byte)
+            links.at(link).at(byte) = possible_narrow_cast<uint8_t>(
+                link >> to_bits(byte));
+
+    // Three outputs spent per transaction, key is tx link and output index.
+    std::vector<data_array<7>> spends(count);
+    for (size_t spend = 0; spend < count; ++spend)
+    {
+        const auto tx = possible_narrow_cast<uint32_t>(spend / 3u);
+        const auto index = possible_narrow_cast<uint8_t>(spend % 3u);
+        auto& key = spends.at(spend);
+        for (size_t byte = 0; byte < sizeof(tx); ++byte)
+            key.at(byte) = possible_narrow_cast<uint8_t>(tx >> to_bits(byte));
+
+        key.at(sizeof(tx)) = index;
+    }
+
+    report_hashers("hash", hashes);
+    report_hashers("link", links);
+    report_hashers("spend", spends);
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
 BOOST_AUTO_TEST_SUITE_END()
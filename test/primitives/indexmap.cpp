@@ -0,0 +1,378 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include "../mocks/chunk_storage.hpp"
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(indexmap_tests)
+
+using namespace system;
+using link3 = linkage<3>;
+using key3 = data_array<3>;
+
+constexpr link3 slots{ 2 };
+
+class little_record
+{
+public:
+    static constexpr size_t size = sizeof(uint32_t);
+    static constexpr link3 count() NOEXCEPT { return 1; }
+
+    bool from_data(database::reader& source) NOEXCEPT
+    {
+        value = source.read_little_endian<uint32_t>();
+        return source;
+    }
+
+    bool to_data(database::finalizer& sink) const NOEXCEPT
+    {
+        sink.write_little_endian(value);
+        return sink;
+    }
+
+    uint32_t value{ 0 };
+};
+
+class little_slab
+{
+public:
+    static constexpr size_t size = max_size_t;
+    link3 count() const NOEXCEPT
+    {
+        return possible_narrow_cast<link3::integer>(3u + 3u + 1u +
+            value.size());
+    }
+
+    bool from_data(database::reader& source) NOEXCEPT
+    {
+        value = source.read_bytes(source.read_byte());
+        return source;
+    }
+
+    bool to_data(database::finalizer& sink) const NOEXCEPT
+    {
+        sink.write_byte(narrow_cast<uint8_t>(value.size()));
+        sink.write_bytes(value);
+        return sink;
+    }
+
+    data_chunk value{};
+};
+
+using record_table = indexmap<link3, key3, little_record::size>;
+using slab_table = indexmap<link3, key3, little_slab::size>;
+
+// setup
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(indexmap__create__unaligned__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.enabled());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 2u);
+    BOOST_REQUIRE_EQUAL(head_file, base16_chunk(
+        "000000" "feffff" "ffffff" "ffffff"));
+    BOOST_REQUIRE(body_file.empty());
+    BOOST_REQUIRE(instance.verify());
+    BOOST_REQUIRE(!instance.create());
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__create__aligned__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots, true };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE_EQUAL(head_file.size(), 4u * sizeof(uint64_t));
+    BOOST_REQUIRE(instance.verify());
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__verify__hashmap_head__false)
+{
+    // A hashmap head of the same size (body count and three buckets).
+    auto head_file = base16_chunk("000000" "ffffff" "ffffff" "ffffff");
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(!instance.verify());
+    BOOST_REQUIRE(!instance.restore());
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__enabled__one_slot__false)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, 1 };
+    BOOST_REQUIRE(!instance.enabled());
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__restore__closed__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key3{ 0x01 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(!instance.verify());
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE(instance.verify());
+
+    // Body beyond closed count is truncated by restore.
+    BOOST_REQUIRE(!instance.set_link(little_record{ 0x0b }).is_terminal());
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    BOOST_REQUIRE(instance.restore());
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key3{ 0x01 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0au);
+}
+
+// query
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(indexmap__put__record__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.exists(key3{ 0x01 }));
+    BOOST_REQUIRE_EQUAL(instance.put_link(key3{ 0x01 },
+        little_record{ 0x0403020a }), 0u);
+    BOOST_REQUIRE(instance.exists(key3{ 0x01 }));
+    BOOST_REQUIRE(!instance.exists(key3{ 0x00 }));
+    BOOST_REQUIRE_EQUAL(instance.first(key3{ 0x01 }), 0u);
+    BOOST_REQUIRE_EQUAL(instance.get_key(0), (key3{ 0x01 }));
+    BOOST_REQUIRE_EQUAL(instance.top(1), 0u);
+    BOOST_REQUIRE(instance.top(2).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_file, base16_chunk("ffffff" "010000" "0a020304"));
+    BOOST_REQUIRE_EQUAL(head_file, base16_chunk(
+        "000000" "feffff" "ffffff" "000000"));
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key3{ 0x01 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0403020au);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__put__duplicate__most_recent_with_prior)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key3{ 0x00 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key3{ 0x00 }, little_record{ 0x0b }));
+
+    // Next of the most recent element is the prior element of the key.
+    BOOST_REQUIRE_EQUAL(body_file, base16_chunk(
+        "ffffff" "000000" "0a000000"
+        "000000" "000000" "0b000000"));
+    BOOST_REQUIRE_EQUAL(instance.first(key3{ 0x00 }), 1u);
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key3{ 0x00 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__put__beyond_slots__false)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    // Writes do not grow the head.
+    BOOST_REQUIRE(!instance.put(key3{ 0x02 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(!instance.exists(key3{ 0x02 }));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__reserve__beyond_slots__grown_terminal_filled)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    // Reserved within slots is unchanged.
+    BOOST_REQUIRE(instance.reserve(2));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 2u);
+
+    // Head grows to the count (more than double).
+    BOOST_REQUIRE(instance.reserve(6));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 6u);
+    BOOST_REQUIRE(instance.put(key3{ 0x05 }, little_record{ 0x0a }));
+    BOOST_REQUIRE_EQUAL(head_file, base16_chunk(
+        "000000" "feffff"
+        "ffffff" "ffffff" "ffffff" "ffffff" "ffffff" "000000"));
+
+    // Head doubles where the count is within double.
+    BOOST_REQUIRE(instance.reserve(7));
+    BOOST_REQUIRE(instance.put(key3{ 0x06 }, little_record{ 0x0b }));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 12u);
+    BOOST_REQUIRE_EQUAL(instance.head_size(), 14u * 3u);
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE(instance.verify());
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 12u);
+
+    little_record record{};
+    BOOST_REQUIRE(!instance.find(key3{ 0x04 }, record));
+    BOOST_REQUIRE(!instance.find(key3{ 0x0c }, record));
+    BOOST_REQUIRE(instance.find(key3{ 0x05 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0au);
+    BOOST_REQUIRE(instance.find(key3{ 0x06 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__put__terminal_key__false)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put(key3{ 0xff, 0xff, 0xff }, little_record{}));
+    BOOST_REQUIRE(!instance.exists(key3{ 0xff, 0xff, 0xff }));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__put__aligned__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    record_table instance{ head_store, body_store, slots, true };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.reserve(3));
+    BOOST_REQUIRE(instance.put(key3{ 0x01 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key3{ 0x01 }, little_record{ 0x0b }));
+    BOOST_REQUIRE(instance.put(key3{ 0x02 }, little_record{ 0x0c }));
+    BOOST_REQUIRE_EQUAL(instance.buckets(), 4u);
+    BOOST_REQUIRE_EQUAL(head_file, base16_chunk(
+        "000000ffffffffff" "feffffffffffffff" "ffffffffffffffff"
+        "010000ffffffffff" "020000ffffffffff" "ffffffffffffffff"));
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE_EQUAL(head_file, base16_chunk(
+        "030000ffffffffff" "feffffffffffffff" "ffffffffffffffff"
+        "010000ffffffffff" "020000ffffffffff" "ffffffffffffffff"));
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key3{ 0x01 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+    BOOST_REQUIRE(instance.find(key3{ 0x02 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0cu);
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__set_commit__slab__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    slab_table instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    const little_slab slab{ { 0x42, 0x43 } };
+    const auto link = instance.set_link(slab);
+    BOOST_REQUIRE_EQUAL(link, 0u);
+    BOOST_REQUIRE(!instance.exists(key3{ 0x01 }));
+    BOOST_REQUIRE_EQUAL(instance.commit_link(link, key3{ 0x01 }), 0u);
+    BOOST_REQUIRE(instance.put(key3{ 0x00 }, little_slab{ { 0x44 } }));
+    BOOST_REQUIRE_EQUAL(body_file, base16_chunk(
+        "ffffff" "010000" "024243"
+        "ffffff" "000000" "0144"));
+
+    little_slab out{};
+    BOOST_REQUIRE(instance.find(key3{ 0x01 }, out));
+    BOOST_REQUIRE_EQUAL(out.value, slab.value);
+    BOOST_REQUIRE(instance.find(key3{ 0x00 }, out));
+    BOOST_REQUIRE_EQUAL(out.value, (data_chunk{ 0x44 }));
+    BOOST_REQUIRE_EQUAL(instance.first(key3{ 0x00 }), 9u);
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+template <typename Table>
+static void put_then_find(const std::string& name, const link3& heads) NOEXCEPT
+{
+    // Models per block tables, keyed by header link (dense, ascending).
+    // Index map slots are presized from the header count (as by store).
+    constexpr auto count = 1'000'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    Table instance{ head_store, body_store, heads };
+    BOOST_REQUIRE(instance.create());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+        instance.put(link3{ narrow_cast<uint32_t>(value) },
+            little_record{ narrow_cast<uint32_t>(value) });
+
+    const auto put = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    size_t found{};
+    little_record record{};
+    start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+        found += instance.find(link3{ narrow_cast<uint32_t>(
+            (value * 7919u) % count) }, record) ? 1u : 0u;
+
+    const auto find = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    BOOST_REQUIRE_EQUAL(found, count);
+    BOOST_TEST_MESSAGE(name << " put " << count << " keys : " << put.count()
+        << " ms, find : " << find.count() << " ms");
+}
+
+BOOST_AUTO_TEST_CASE(indexmap__put_then_find__versus_hashmap__performance)
+{
+    using chained = hashmap<link3, key3, little_record::size, unique_hasher>;
+    put_then_find<chained>("hashmap (1:1)", link3{ 1'000'000u });
+    put_then_find<chained>("hashmap (4:1)", link3{ 250'000u });
+    put_then_find<record_table>("indexmap", link3{ 1'000'000u });
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -106,4 +106,29 @@ BOOST_AUTO_TEST_CASE(iterator__advance__slab__expected)
     BOOST_REQUIRE_EQUAL(iterator.self(), link::terminal);
 }
 
+BOOST_AUTO_TEST_CASE(iterator__advance__borrowed_record__expected)
+{
+    using link = linkage<1>;
+    using key = data_array<2>;
+    using record_iterate = iterator<link, key, 1, true>;
+    constexpr auto start = 0;
+    constexpr key key2{ 0x1a, 0x2a };
+    data_chunk data
+    {
+        0x01, 0x1a, 0x2a, 0xee,
+        0x02, 0x1a, 0x2a, 0xee,
+        0xff, 0xcc, 0xcc, 0xee
+    };
+    test::chunk_storage file{ data };
+    const guard memory{ file.get() };
+    record_iterate iterator{ memory, start, key2 };
+    BOOST_REQUIRE_EQUAL(iterator.get(), memory.get());
+    BOOST_REQUIRE(iterator);
+    BOOST_REQUIRE_EQUAL(iterator.self(), 0x00u);
+    BOOST_REQUIRE(iterator.advance());
+    BOOST_REQUIRE_EQUAL(iterator.self(), 0x01u);
+    BOOST_REQUIRE(!iterator.advance());
+    BOOST_REQUIRE_EQUAL(iterator.self(), link::terminal);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
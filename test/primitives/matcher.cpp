@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(matcher_tests)
+
+using namespace system;
+
+template <size_t Bytes>
+using key = data_array<Bytes>;
+
+template <size_t Bytes>
+static void require_equality() NOEXCEPT
+{
+    using match = matcher<linkage<4>, key<Bytes>>;
+    key<Bytes> left{};
+    for (size_t index = 0; index < Bytes; ++index)
+        left.at(index) = narrow_cast<uint8_t>(add1(index));
+
+    auto right = left;
+    BOOST_REQUIRE(match::is_equal(left.data(), right.data()));
+
+    // Each differing byte position is unequal.
+    for (size_t index = 0; index < Bytes; ++index)
+    {
+        right = left;
+        right.at(index) ^= 0x80u;
+        BOOST_REQUIRE(!match::is_equal(left.data(), right.data()));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(matcher__is_equal__surrogate_keys__expected)
+{
+    require_equality<3>();
+    require_equality<4>();
+    require_equality<7>();
+}
+
+BOOST_AUTO_TEST_CASE(matcher__is_equal__hash_keys__expected)
+{
+    require_equality<32>();
+}
+
+BOOST_AUTO_TEST_CASE(matcher__is_equal__other_keys__expected)
+{
+    require_equality<10>();
+    require_equality<36>();
+}
+
+BOOST_AUTO_TEST_CASE(matcher__next__wide__masked_link)
+{
+    using match = matcher<linkage<5>, key<3>>;
+    constexpr std_array<uint8_t, 8> element
+    {
+        0x01, 0x02, 0x03, 0x04, 0x05,
+        0xff, 0xff, 0xff
+    };
+
+    BOOST_REQUIRE_EQUAL(match::next(element.data()), 0x0504030201_u64);
+}
+
+BOOST_AUTO_TEST_CASE(matcher__next__narrow__expected_link)
+{
+    using match = matcher<linkage<2>, key<3>>;
+    constexpr std_array<uint8_t, 5> element
+    {
+        0x01, 0x02,
+        0xff, 0xff, 0xff
+    };
+
+    BOOST_REQUIRE_EQUAL(match::next(element.data()), 0x0201u);
+}
+
+BOOST_AUTO_TEST_CASE(matcher__next__terminal__terminal)
+{
+    using match = matcher<linkage<4>, key<32>>;
+    std_array<uint8_t, 36> element{};
+    std::fill_n(element.begin(), 4u, 0xffu);
+    BOOST_REQUIRE(match::next(element.data()).is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(matcher__is_match__element_key__expected)
+{
+    using match = matcher<linkage<4>, key<32>>;
+    std_array<uint8_t, 36> element{};
+    key<32> value{};
+    value.at(31) = 0x42u;
+    BOOST_REQUIRE(!match::is_match(value, element.data()));
+
+    element.at(35) = 0x42u;
+    BOOST_REQUIRE(match::is_match(value, element.data()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,393 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include "../mocks/chunk_storage.hpp"
+#include <chrono>
+
+BOOST_AUTO_TEST_SUITE(probemap_tests)
+
+using namespace system;
+using link5 = linkage<5>;
+using key1 = data_array<1>;
+using key10 = data_array<10>;
+
+// Slots are rounded up to a power of two.
+constexpr link5 slots{ 5 };
+constexpr auto rounded = 8_size;
+constexpr auto slot_size = sizeof(uint64_t);
+constexpr auto head_size = add1(rounded) * slot_size;
+
+class little_record
+{
+public:
+    static constexpr size_t size = sizeof(uint32_t);
+    static constexpr link5 count() NOEXCEPT { return 1; }
+
+    bool from_data(database::reader& source) NOEXCEPT
+    {
+        value = source.read_little_endian<uint32_t>();
+        return source;
+    }
+
+    bool to_data(database::finalizer& sink) const NOEXCEPT
+    {
+        sink.write_little_endian(value);
+        return sink;
+    }
+
+    uint32_t value{ 0 };
+};
+
+class view_record
+{
+public:
+    static constexpr size_t size = sizeof(uint32_t);
+    static constexpr link5 count() NOEXCEPT { return 1; }
+
+    // View fields are positioned from the search key.
+    bool from_memory(const uint8_t* data) NOEXCEPT
+    {
+        key = field<zero, one>::get(data);
+        value = field<one, sizeof(uint32_t)>::get(data);
+        return true;
+    }
+
+    uint8_t key{ 0 };
+    uint32_t value{ 0 };
+};
+
+using table1 = probemap<link5, key1, little_record::size, unique_hasher>;
+using table10 = probemap<link5, key10, little_record::size, mix_hasher>;
+
+// Keys are scattered (mixed) so that sequential values are not adjacent.
+static key10 to_key(size_t value) NOEXCEPT
+{
+    key10 key{};
+    const auto mixed = mix_hasher::mix(value);
+    for (size_t byte = 0; byte < sizeof(mixed); ++byte)
+        key.at(byte) = narrow_cast<uint8_t>(mixed >> to_bits(byte));
+
+    return key;
+}
+
+// setup
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(probemap__create__empty__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE_EQUAL(instance.slots(), rounded);
+    BOOST_REQUIRE_EQUAL(instance.head_size(), head_size);
+    BOOST_REQUIRE_EQUAL(head_file.size(), head_size);
+    BOOST_REQUIRE(body_file.empty());
+    BOOST_REQUIRE_EQUAL(instance.count(), 0u);
+    BOOST_REQUIRE(instance.verify());
+    BOOST_REQUIRE(!instance.create());
+}
+
+BOOST_AUTO_TEST_CASE(probemap__verify__invalid_head__false)
+{
+    data_chunk head_file(add1(rounded) * slot_size + one, 0xff);
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(!instance.verify());
+
+    // Slot count must be a power of two.
+    head_file.resize(add1(6_size) * slot_size, 0xff);
+    BOOST_REQUIRE(!instance.verify());
+}
+
+BOOST_AUTO_TEST_CASE(probemap__restore__closed__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key1{ 0x01 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key1{ 0x02 }, little_record{ 0x0b }));
+    BOOST_REQUIRE(!instance.verify());
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE(instance.verify());
+
+    // Body beyond closed count is truncated by restore.
+    BOOST_REQUIRE(!instance.set_link(little_record{ 0x0c }).is_terminal());
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    table1 restored{ head_store, body_store, slots };
+    BOOST_REQUIRE(restored.restore());
+    BOOST_REQUIRE_EQUAL(restored.count(), 2u);
+    BOOST_REQUIRE(restored.verify());
+
+    little_record record{};
+    BOOST_REQUIRE(restored.find(key1{ 0x02 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+}
+
+// query
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(probemap__put__get__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.exists(key1{ 0x42 }));
+    BOOST_REQUIRE(instance.first(key1{ 0x42 }).is_terminal());
+
+    const auto link = instance.put_link(key1{ 0x42 }, little_record{ 0xa1b2c3d4_u32 });
+    BOOST_REQUIRE_EQUAL(link, 0u);
+    BOOST_REQUIRE(instance.exists(key1{ 0x42 }));
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x42 }), link);
+    BOOST_REQUIRE_EQUAL(instance.get_key(link), key1{ 0x42 });
+
+    // Element is [key][record], with no next link.
+    const data_chunk expected_body{ 0x42, 0xd4, 0xc3, 0xb2, 0xa1 };
+    BOOST_REQUIRE_EQUAL(body_file, expected_body);
+
+    little_record record{};
+    BOOST_REQUIRE(instance.get(link, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0xa1b2c3d4_u32);
+    BOOST_REQUIRE(instance.find(key1{ 0x42 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0xa1b2c3d4_u32);
+    BOOST_REQUIRE(!instance.find(key1{ 0x43 }, record));
+
+    view_record view{};
+    BOOST_REQUIRE(instance.get(link, view));
+    BOOST_REQUIRE_EQUAL(view.key, 0x42u);
+    BOOST_REQUIRE_EQUAL(view.value, 0xa1b2c3d4_u32);
+    BOOST_REQUIRE(!instance.get(link5{ 1 }, view));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(probemap__put__colliding__linear_probed)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    // Identity hash of 0x01 and 0x09 is slot 1 (of 8), so 0x09 probes to 2.
+    BOOST_REQUIRE(instance.put(key1{ 0x01 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key1{ 0x09 }, little_record{ 0x0b }));
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x01 }), 0u);
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x09 }), 1u);
+    BOOST_REQUIRE(instance.first(key1{ 0x11 }).is_terminal());
+
+    // Slot 2 holds link 1 (followed by tag).
+    const auto slot2 = std::next(head_file.begin(), 3 * slot_size);
+    BOOST_REQUIRE_EQUAL(*slot2, 0x01u);
+    BOOST_REQUIRE_EQUAL(head_file.at(2 * slot_size), 0x00u);
+    BOOST_REQUIRE_EQUAL(head_file.at(4 * slot_size), 0xffu);
+}
+
+BOOST_AUTO_TEST_CASE(probemap__put__duplicate__most_recent)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key1{ 0x07 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key1{ 0x07 }, little_record{ 0x0b }));
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key1{ 0x07 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x07 }), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(probemap__commit__allocated__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    const auto link = instance.set_link(little_record{ 0x0a });
+    BOOST_REQUIRE(!link.is_terminal());
+    BOOST_REQUIRE(!instance.exists(key1{ 0x03 }));
+    BOOST_REQUIRE_EQUAL(instance.commit_link(link, key1{ 0x03 }), link);
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x03 }), link);
+
+    const auto allocated = instance.allocate(1);
+    BOOST_REQUIRE(instance.put(allocated, key1{ 0x04 }, little_record{ 0x0b }));
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key1{ 0x04 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+}
+
+// growth
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(probemap__grow__duplicates__most_recent_retained)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    table1 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key1{ 0x07 }, little_record{ 0x0a }));
+    BOOST_REQUIRE(instance.put(key1{ 0x07 }, little_record{ 0x0b }));
+    BOOST_REQUIRE(instance.grow());
+    BOOST_REQUIRE_EQUAL(instance.slots(), two * rounded);
+    BOOST_REQUIRE_EQUAL(head_file.size(), add1(two * rounded) * slot_size);
+    BOOST_REQUIRE(!instance.verify());
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE(instance.verify());
+    BOOST_REQUIRE_EQUAL(instance.slots(), two * rounded);
+
+    little_record record{};
+    BOOST_REQUIRE(instance.find(key1{ 0x07 }, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x0bu);
+}
+
+BOOST_AUTO_TEST_CASE(probemap__put__exceeds_load__not_grown)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table10 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < rounded; ++value)
+        BOOST_REQUIRE(instance.put(to_key(value),
+            little_record{ narrow_cast<uint32_t>(value) }));
+
+    // Writes fail once slots are exhausted.
+    BOOST_REQUIRE_EQUAL(instance.slots(), rounded);
+    BOOST_REQUIRE(!instance.put(to_key(rounded), little_record{}));
+
+    BOOST_REQUIRE(instance.maintain());
+    BOOST_REQUIRE_EQUAL(instance.slots(), 32u);
+    BOOST_REQUIRE(instance.put(to_key(rounded), little_record{}));
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+BOOST_AUTO_TEST_CASE(probemap__maintain__exceeds_load__grown_links_stable)
+{
+    constexpr auto count = 1000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table10 instance{ head_store, body_store, slots };
+    BOOST_REQUIRE(instance.create());
+
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE_EQUAL(instance.put_link(to_key(value),
+            little_record{ narrow_cast<uint32_t>(value) }), value);
+        BOOST_REQUIRE(instance.maintain());
+    }
+
+    // Elements never exceed half of slots.
+    BOOST_REQUIRE_EQUAL(instance.slots(), 2048u);
+
+    little_record record{};
+    for (size_t value = 0; value < count; ++value)
+    {
+        BOOST_REQUIRE_EQUAL(instance.first(to_key(value)), value);
+        BOOST_REQUIRE(instance.find(to_key(value), record));
+        BOOST_REQUIRE_EQUAL(record.value, value);
+    }
+
+    for (size_t value = count; value < two * count; ++value)
+        BOOST_REQUIRE(!instance.exists(to_key(value)));
+
+    BOOST_REQUIRE(!instance.get_fault());
+}
+
+#if defined(HAVE_PERFORMANCE_TESTS)
+
+template <typename Table>
+static void put_then_find(const std::string& name, const link5& heads) NOEXCEPT
+{
+    // Models unique key writes (exists miss, then put) and hits, with a table
+    // exceeding cache.
+    constexpr auto count = 4'000'000u;
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    Table instance{ head_store, body_store, heads };
+    BOOST_REQUIRE(instance.create());
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+    {
+        const auto key = to_key(value);
+        if (!instance.exists(key))
+            instance.put(key, little_record{ narrow_cast<uint32_t>(value) });
+    }
+
+    const auto put = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    size_t found{};
+    little_record record{};
+    start = std::chrono::steady_clock::now();
+    for (size_t value = 0; value < count; ++value)
+        found += instance.find(to_key((value * 7919u) % count), record) ?
+            1u : 0u;
+
+    const auto find = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    BOOST_REQUIRE_EQUAL(found, count);
+    BOOST_TEST_MESSAGE(name << " exists/put " << count << " keys : "
+        << put.count() << " ms, find : " << find.count() << " ms");
+}
+
+BOOST_AUTO_TEST_CASE(probemap__put_then_find__versus_hashmap__performance)
+{
+    // Hashmap with one key per bucket (aligned, fingerprinted).
+    using chained = hashmap<link5, key10, little_record::size,
+        fingerprinted<mix_hasher>>;
+
+    struct chained_table
+      : public chained
+    {
+        chained_table(storage& head, storage& body, const link5& buckets)
+          : chained(head, body, buckets, true)
+        {
+        }
+    };
+
+    put_then_find<chained_table>("hashmap (1:1)", link5{ 4'000'000u });
+    put_then_find<chained_table>("hashmap (4:1)", link5{ 1'000'000u });
+    put_then_find<table10>("probemap", link5{ 8'000'000u });
+}
+
+#endif // HAVE_PERFORMANCE_TESTS
+
+BOOST_AUTO_TEST_SUITE_END()
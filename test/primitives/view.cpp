@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+BOOST_AUTO_TEST_SUITE(view_tests)
+
+using namespace system;
+
+using field0 = field<zero, 3>;
+using field1 = field<field0::end, 5>;
+using field2 = field<field1::end, 1>;
+static_assert(field0::end == 3u);
+static_assert(field1::end == 8u);
+static_assert(field2::end == 9u);
+static_assert(std::is_same_v<field0::integer, uint32_t>);
+static_assert(std::is_same_v<field1::integer, uint64_t>);
+static_assert(std::is_same_v<field2::integer, uint8_t>);
+
+struct element
+{
+    bool from_memory(const uint8_t*) NOEXCEPT { return true; }
+};
+
+struct stream_element
+{
+    bool from_data(database::reader&) NOEXCEPT { return true; }
+};
+
+static_assert(is_view<element>);
+static_assert(!is_view<stream_element>);
+
+BOOST_AUTO_TEST_CASE(view__field_get__unaligned__little_endian)
+{
+    constexpr std_array<uint8_t, 10> data
+    {
+        0x01, 0x02, 0x03,
+        0x04, 0x05, 0x06, 0x07, 0x08,
+        0x09,
+        0xff
+    };
+
+    BOOST_REQUIRE_EQUAL(field0::get(data.data()), 0x00030201_u32);
+    BOOST_REQUIRE_EQUAL(field1::get(data.data()), 0x0000000807060504_u64);
+    BOOST_REQUIRE_EQUAL(field2::get(data.data()), 0x09u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
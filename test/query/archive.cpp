@@ -537,6 +537,7 @@ BOOST_AUTO_TEST_CASE(query_archive__set_block__get_block__expected)
         "00");         // witness
     const auto genesis_txs_head = system::base16_chunk(
         "1200000000"   // slabs size
+        "feffffffff"   // marker
         "0000000000"   // pk->
         "ffffffffff"
         "ffffffffff"
@@ -687,6 +688,7 @@ BOOST_AUTO_TEST_CASE(query_archive__set_block_txs__get_block__expected)
         "00");         // witness
     const auto genesis_txs_head = system::base16_chunk(
         "1200000000"   // slabs size
+        "feffffffff"   // marker
         "0000000000"   // pk->
         "ffffffffff"
         "ffffffffff"
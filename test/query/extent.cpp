@@ -78,6 +78,8 @@ BOOST_AUTO_TEST_CASE(query_extent__body_sizes__genesis__expected)
     BOOST_REQUIRE_EQUAL(query.candidate_body_size(), schema::height::minrow);
     BOOST_REQUIRE_EQUAL(query.confirmed_body_size(), schema::height::minrow);
     BOOST_REQUIRE_EQUAL(query.strong_tx_body_size(), schema::strong_tx::minrow);
+    BOOST_REQUIRE_EQUAL(query.strong_body_size(), schema::strong::minrow);
+    BOOST_REQUIRE_EQUAL(query.lineage_body_size(), schema::lineage::minrow);
     BOOST_REQUIRE_EQUAL(query.validated_tx_body_size(), 0u);
     BOOST_REQUIRE_EQUAL(query.validated_bk_body_size(), 0u);
 
@@ -126,6 +128,8 @@ BOOST_AUTO_TEST_CASE(query_extent__records__genesis__expected)
     BOOST_REQUIRE_EQUAL(query.candidate_records(), 1u);
     BOOST_REQUIRE_EQUAL(query.confirmed_records(), 1u);
     BOOST_REQUIRE_EQUAL(query.strong_tx_records(), 1u);
+    BOOST_REQUIRE_EQUAL(query.strong_records(), 1u);
+    BOOST_REQUIRE_EQUAL(query.lineage_records(), 1u);
 
     BOOST_REQUIRE_EQUAL(query.address_records(), 1u);
 }
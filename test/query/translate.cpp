@@ -789,6 +789,45 @@ BOOST_AUTO_TEST_CASE(query_translate__to_block__set_strong__expected)
     BOOST_REQUIRE(query.to_strong_txs_(hash3).empty());
 }
 
+BOOST_AUTO_TEST_CASE(query_translate__to_block__unindexed_strong_tx__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(events_handler), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, test::context, false, false));
+    BOOST_REQUIRE(query.set(test::block2, test::context, false, false));
+
+    // Associations written only to strong_tx (strong records are not set).
+    BOOST_REQUIRE(store.strong_tx.put(tx_link{ 1 }, table::strong_tx::record
+    {
+        {},
+        1,
+        true
+    }));
+    BOOST_REQUIRE(store.strong_tx.put(tx_link{ 2 }, table::strong_tx::record
+    {
+        {},
+        2,
+        false
+    }));
+
+    BOOST_REQUIRE_EQUAL(query.to_block(1), 1u);
+    BOOST_REQUIRE_EQUAL(query.to_block(2), header_link::terminal);
+    BOOST_REQUIRE(query.is_strong_tx(1));
+    BOOST_REQUIRE(!query.is_strong_tx(2));
+
+    // Set strong records supersede strong_tx.
+    BOOST_REQUIRE(query.set_unstrong(1));
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE_EQUAL(query.to_block(1), header_link::terminal);
+    BOOST_REQUIRE_EQUAL(query.to_block(2), 2u);
+    BOOST_REQUIRE(!query.is_strong_tx(1));
+    BOOST_REQUIRE(query.is_strong_tx(2));
+}
+
 // _to_parent
 
 BOOST_AUTO_TEST_CASE(query_translate__to_parent__always__expected)
@@ -25,52 +25,98 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
     database::settings configuration;
     BOOST_REQUIRE_EQUAL(configuration.path, "bitcoin");
     BOOST_REQUIRE(configuration.minimize);
+    BOOST_REQUIRE_EQUAL(configuration.flush_interval, 0u);
+    BOOST_REQUIRE(!configuration.preallocate);
+    BOOST_REQUIRE_EQUAL(configuration.pool_budget, 0u);
+    BOOST_REQUIRE(!configuration.aligned_heads);
+    BOOST_REQUIRE_EQUAL(configuration.bucket_load, 0u);
+    BOOST_REQUIRE(configuration.header_lineage);
 
     // Archives.
     BOOST_REQUIRE_EQUAL(configuration.header_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.header_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.header_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.header_reserve, 0u);
+    BOOST_REQUIRE(configuration.header_advice == advice::random);
     BOOST_REQUIRE_EQUAL(configuration.point_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.point_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.point_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.point_reserve, 0u);
+    BOOST_REQUIRE(configuration.point_advice == advice::random);
+    BOOST_REQUIRE_EQUAL(configuration.point_filter, 0u);
     BOOST_REQUIRE_EQUAL(configuration.input_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.input_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.input_reserve, 0u);
+    BOOST_REQUIRE(configuration.input_advice == advice::normal);
     BOOST_REQUIRE_EQUAL(configuration.output_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.output_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.output_reserve, 0u);
+    BOOST_REQUIRE(configuration.output_advice == advice::normal);
     BOOST_REQUIRE_EQUAL(configuration.puts_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.puts_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.puts_reserve, 0u);
+    BOOST_REQUIRE(configuration.puts_advice == advice::sequential);
     BOOST_REQUIRE_EQUAL(configuration.tx_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.tx_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.tx_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.tx_reserve, 0u);
+    BOOST_REQUIRE(configuration.tx_advice == advice::random);
+    BOOST_REQUIRE_EQUAL(configuration.tx_filter, 0u);
     BOOST_REQUIRE_EQUAL(configuration.txs_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.txs_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.txs_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.txs_reserve, 0u);
+    BOOST_REQUIRE(configuration.txs_advice == advice::sequential);
 
     // Indexes.
     BOOST_REQUIRE_EQUAL(configuration.address_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.address_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.address_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.address_reserve, 0u);
+    BOOST_REQUIRE(configuration.address_advice == advice::random);
     BOOST_REQUIRE_EQUAL(configuration.candidate_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.candidate_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.candidate_reserve, 0u);
+    BOOST_REQUIRE(configuration.candidate_advice == advice::sequential);
     BOOST_REQUIRE_EQUAL(configuration.confirmed_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.confirmed_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.confirmed_reserve, 0u);
+    BOOST_REQUIRE(configuration.confirmed_advice == advice::sequential);
     BOOST_REQUIRE_EQUAL(configuration.spend_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.spend_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.spend_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.spend_reserve, 0u);
+    BOOST_REQUIRE(configuration.spend_advice == advice::random);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.strong_tx_reserve, 0u);
+    BOOST_REQUIRE(configuration.strong_tx_advice == advice::random);
+    BOOST_REQUIRE_EQUAL(configuration.strong_size, 1u);
+    BOOST_REQUIRE_EQUAL(configuration.strong_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.strong_reserve, 0u);
+    BOOST_REQUIRE(configuration.strong_advice == advice::random);
+    BOOST_REQUIRE_EQUAL(configuration.lineage_size, 1u);
+    BOOST_REQUIRE_EQUAL(configuration.lineage_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.lineage_reserve, 0u);
+    BOOST_REQUIRE(configuration.lineage_advice == advice::random);
 
     // Caches.
     BOOST_REQUIRE_EQUAL(configuration.validated_bk_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.validated_bk_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.validated_bk_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.validated_bk_reserve, 0u);
+    BOOST_REQUIRE(configuration.validated_bk_advice == advice::random);
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.validated_tx_reserve, 0u);
+    BOOST_REQUIRE(configuration.validated_tx_advice == advice::random);
     BOOST_REQUIRE_EQUAL(configuration.neutrino_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.neutrino_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.neutrino_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.neutrino_reserve, 0u);
+    BOOST_REQUIRE(configuration.neutrino_advice == advice::random);
     ////BOOST_REQUIRE_EQUAL(configuration.bootstrap_size, 1u);
     ////BOOST_REQUIRE_EQUAL(configuration.bootstrap_rate, 50u);
     ////BOOST_REQUIRE_EQUAL(configuration.buffer_buckets, 100u);
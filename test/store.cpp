@@ -17,7 +17,10 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "test.hpp"
+#include "mocks/blocks.hpp"
 #include "mocks/map_store.hpp"
+#include <chrono>
+#include <thread>
 
  // these are the slow tests (mmap)
 
@@ -72,6 +75,7 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.header_body_file(), "bitcoin/archive_header.data");
     BOOST_REQUIRE_EQUAL(instance.point_head_file(), "bitcoin/heads/archive_point.head");
     BOOST_REQUIRE_EQUAL(instance.point_body_file(), "bitcoin/archive_point.data");
+    BOOST_REQUIRE_EQUAL(instance.point_filter_file(), "bitcoin/heads/archive_point.filter");
     BOOST_REQUIRE_EQUAL(instance.input_head_file(), "bitcoin/heads/archive_input.head");
     BOOST_REQUIRE_EQUAL(instance.input_body_file(), "bitcoin/archive_input.data");
     BOOST_REQUIRE_EQUAL(instance.output_head_file(), "bitcoin/heads/archive_output.head");
@@ -80,6 +84,7 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.puts_body_file(), "bitcoin/archive_puts.data");
     BOOST_REQUIRE_EQUAL(instance.tx_head_file(), "bitcoin/heads/archive_tx.head");
     BOOST_REQUIRE_EQUAL(instance.tx_body_file(), "bitcoin/archive_tx.data");
+    BOOST_REQUIRE_EQUAL(instance.tx_filter_file(), "bitcoin/heads/archive_tx.filter");
     BOOST_REQUIRE_EQUAL(instance.txs_head_file(), "bitcoin/heads/archive_txs.head");
     BOOST_REQUIRE_EQUAL(instance.txs_body_file(), "bitcoin/archive_txs.data");
 
@@ -94,6 +99,10 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.spend_body_file(), "bitcoin/archive_spend.data");
     BOOST_REQUIRE_EQUAL(instance.strong_tx_head_file(), "bitcoin/heads/strong_tx.head");
     BOOST_REQUIRE_EQUAL(instance.strong_tx_body_file(), "bitcoin/strong_tx.data");
+    BOOST_REQUIRE_EQUAL(instance.strong_head_file(), "bitcoin/heads/strong.head");
+    BOOST_REQUIRE_EQUAL(instance.strong_body_file(), "bitcoin/strong.data");
+    BOOST_REQUIRE_EQUAL(instance.lineage_head_file(), "bitcoin/heads/lineage.head");
+    BOOST_REQUIRE_EQUAL(instance.lineage_body_file(), "bitcoin/lineage.data");
 
     /// Caches.
     BOOST_REQUIRE_EQUAL(instance.validated_bk_head_file(), "bitcoin/heads/validated_bk.head");
@@ -275,6 +284,32 @@ BOOST_AUTO_TEST_CASE(store__open__created__success)
     BOOST_REQUIRE(!instance.close(events));
 }
 
+BOOST_AUTO_TEST_CASE(store__open__missing_format__store_format)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.close(events));
+    BOOST_REQUIRE(test::exists(configuration.path / schema::format::name));
+    BOOST_REQUIRE(file::remove(configuration.path / schema::format::name));
+    BOOST_REQUIRE_EQUAL(instance.open(events), error::store_format);
+}
+
+BOOST_AUTO_TEST_CASE(store__open__other_format__store_format)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.close(events));
+
+    const auto other = system::to_little_endian(add1(schema::format::version));
+    BOOST_REQUIRE(file::create_file(configuration.path / schema::format::name,
+        other.data(), other.size()));
+    BOOST_REQUIRE_EQUAL(instance.open(events), error::store_format);
+}
+
 // snapshot
 // ----------------------------------------------------------------------------
 
@@ -296,6 +331,116 @@ BOOST_AUTO_TEST_CASE(store__snapshot__opened__success)
     BOOST_REQUIRE(!instance.close(events));
 }
 
+// sync
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(store__sync__uncreated__sync_unloaded)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.sync(), error::sync_unloaded);
+}
+
+BOOST_AUTO_TEST_CASE(store__sync__opened__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.sync());
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+// maintain
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(store__maintain__opened__success_unlocked)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.bucket_load = 1;
+    test::map_store instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.maintain(events));
+    BOOST_REQUIRE(instance.transactor_mutex().try_lock());
+    instance.transactor_mutex().unlock();
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+BOOST_AUTO_TEST_CASE(store__maintain__flush_interval__grown_by_flusher)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.bucket_load = 1;
+    configuration.flush_interval = 1;
+    configuration.strong_tx_buckets = 2;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE_EQUAL(instance.strong_tx.buckets(), 2u);
+
+    for (auto value = 0_u32; value < 100_u32; ++value)
+    {
+        const auto transactor = instance.get_transactor();
+        BOOST_REQUIRE(instance.strong_tx.put(system::to_little_endian(value),
+            table::strong_tx::record{ {}, value, true }));
+    }
+
+    // Heads are stepped by the flusher while no transactor is held.
+    for (auto wait = 0; wait < 1000 && instance.strong_tx.buckets() < 64u; ++wait)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    BOOST_REQUIRE_GE(instance.strong_tx.buckets(), 64u);
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+BOOST_AUTO_TEST_CASE(store__pending__opened__all_bodies_zero)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+
+    size_t count{};
+    size_t total{};
+    instance.pending([&](size_t pending, size_t lag, table_t) NOEXCEPT
+    {
+        ++count;
+        total += pending + lag;
+    });
+
+    BOOST_REQUIRE_EQUAL(count, 15u);
+    BOOST_REQUIRE_EQUAL(total, zero);
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+BOOST_AUTO_TEST_CASE(store__close__flush_interval__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.flush_interval = 1;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_REQUIRE(!instance.snapshot(events));
+    BOOST_REQUIRE(!instance.close(events));
+    BOOST_REQUIRE(!instance.open(events));
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+BOOST_AUTO_TEST_CASE(store__reload__flush_interval__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.flush_interval = 1;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_REQUIRE(!instance.reload(events));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    BOOST_REQUIRE(!instance.close(events));
+}
+
 // close
 // ----------------------------------------------------------------------------
 
@@ -317,6 +462,135 @@ BOOST_AUTO_TEST_CASE(store__close__opened__success)
     BOOST_REQUIRE(!instance.close(events));
 }
 
+BOOST_AUTO_TEST_CASE(store__close__anonymous_map_storage__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<anonymous_map> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.snapshot(events));
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+// Heads and bodies are written back upon close, so map reopens the store.
+BOOST_AUTO_TEST_CASE(store__close__anonymous_map_storage__map_reopens)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    {
+        store<anonymous_map> instance{ configuration };
+        query<store<anonymous_map>> query{ instance };
+        BOOST_REQUIRE(!instance.create(events));
+        BOOST_REQUIRE(query.initialize(test::genesis));
+        BOOST_REQUIRE(!instance.close(events));
+    }
+
+    store<map> instance{ configuration };
+    query<store<map>> query{ instance };
+    BOOST_REQUIRE(!instance.open(events));
+    BOOST_REQUIRE(query.is_initialized());
+    BOOST_REQUIRE_EQUAL(query.get_top_confirmed(), zero);
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+// Headers stored while lineage was disabled are copied to lineage upon open.
+BOOST_AUTO_TEST_CASE(store__open__lineage_disabled_headers__backfilled)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.header_lineage = false;
+    {
+        store<map> instance{ configuration };
+        query<store<map>> query{ instance };
+        BOOST_REQUIRE(!instance.create(events));
+        BOOST_REQUIRE(query.initialize(test::genesis));
+        BOOST_REQUIRE_EQUAL(instance.lineage.count(), 0u);
+        BOOST_REQUIRE(!instance.close(events));
+    }
+
+    configuration.header_lineage = true;
+    store<map> instance{ configuration };
+    query<store<map>> query{ instance };
+    BOOST_REQUIRE(!instance.open(events));
+    BOOST_REQUIRE_EQUAL(instance.lineage.count(), 1u);
+
+    table::lineage::record lineage{};
+    BOOST_REQUIRE(instance.lineage.get(0, lineage));
+    BOOST_REQUIRE(lineage.is_set());
+    BOOST_REQUIRE_EQUAL(lineage.parent_fk, table::lineage::block::terminal);
+    BOOST_REQUIRE_EQUAL(lineage.version, test::genesis.header().version());
+    BOOST_REQUIRE_EQUAL(lineage.timestamp, test::genesis.header().timestamp());
+    BOOST_REQUIRE_EQUAL(lineage.bits, test::genesis.header().bits());
+    BOOST_REQUIRE_EQUAL(lineage.height, 0u);
+    BOOST_REQUIRE_EQUAL(query.to_parent(0), header_link::terminal);
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+#if !defined(HAVE_MSC)
+BOOST_AUTO_TEST_CASE(store__close__pool_storage__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.pool_budget = pool::minimum_frames * pool::frame;
+    store<pool> instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.snapshot(events));
+    BOOST_REQUIRE(!instance.close(events));
+    BOOST_REQUIRE(!instance.open(events));
+    BOOST_REQUIRE(!instance.close(events));
+}
+
+// Records span many frames of a bounded pool, and are read from one memory.
+BOOST_AUTO_TEST_CASE(store__pool_storage__records_beyond_frame__expected)
+{
+    constexpr auto count = 100'000_u32;
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.pool_budget = pool::minimum_frames * pool::frame;
+    {
+        store<pool> instance{ configuration };
+        BOOST_REQUIRE(!instance.create(events));
+
+        for (auto value = 0_u32; value < count; ++value)
+        {
+            BOOST_REQUIRE(instance.confirmed.put(table::height::record
+            {
+                {},
+                value
+            }));
+
+            BOOST_REQUIRE(instance.strong_tx.put(
+                system::to_little_endian(value), table::strong_tx::record
+                {
+                    {},
+                    value,
+                    true
+                }));
+        }
+
+        BOOST_REQUIRE_GT(instance.confirmed.body_size(), pool::frame);
+        BOOST_REQUIRE_GT(instance.strong_tx.body_size(), pool::frame);
+        BOOST_REQUIRE(!instance.close(events));
+    }
+
+    store<pool> instance{ configuration };
+    BOOST_REQUIRE(!instance.open(events));
+
+    table::height::record height{};
+    table::strong_tx::record strong{};
+    for (auto value = 0_u32; value < count; value += 997_u32)
+    {
+        BOOST_REQUIRE(instance.confirmed.get(value, height));
+        BOOST_REQUIRE_EQUAL(height.header_fk, value);
+        BOOST_REQUIRE(instance.strong_tx.find(system::to_little_endian(value),
+            strong));
+        BOOST_REQUIRE_EQUAL(strong.header_fk, value);
+    }
+
+    BOOST_REQUIRE(!instance.close(events));
+}
+#endif
+
 // get_transactor
 // ----------------------------------------------------------------------------
 
@@ -595,4 +869,24 @@ BOOST_AUTO_TEST_CASE(store__restore__snapshot__success_unlocks)
     BOOST_REQUIRE(!test::exists(instance.process_lock_file()));
 }
 
+BOOST_AUTO_TEST_CASE(store__restore__filters__recreated)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.point_filter = 4096;
+    configuration.tx_filter = 4096;
+
+    test::map_store instance{ configuration };
+    BOOST_REQUIRE(!instance.create(events));
+    BOOST_REQUIRE(!instance.snapshot(events));
+    BOOST_REQUIRE(!instance.close(events));
+    BOOST_REQUIRE(test::create(flush_lock_file(configuration.path)));
+
+    // Filters are not archived, so are recreated by restore.
+    BOOST_REQUIRE(!instance.restore(events));
+    BOOST_REQUIRE(test::exists(instance.point_filter_file()));
+    BOOST_REQUIRE(test::exists(instance.tx_filter_file()));
+    BOOST_REQUIRE(!instance.close(events));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
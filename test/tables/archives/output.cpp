@@ -62,4 +62,114 @@ BOOST_AUTO_TEST_CASE(output__put__get__expected)
     BOOST_REQUIRE(element == expected);
 }
 
+BOOST_AUTO_TEST_CASE(output__put__pay_key_hash__compressed)
+{
+    const chain::script script
+    {
+        base16_chunk("76a914000102030405060708090a0b0c0d0e0f1011121388ac"),
+        false
+    };
+    const table::output::slab slab{ {}, 0x56341201_u32, 0x2a_u64, script };
+    const data_chunk expected_body
+    {
+        0x01, 0x12, 0x34, 0x56,
+        0x2a,
+        table::output::escape,
+        table::output::pay_key_hash,
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+        0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(slab.count(), expected_body.size());
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE(element == slab);
+
+    table::output::only out{};
+    BOOST_REQUIRE(instance.get<table::output::only>(0, out));
+    BOOST_REQUIRE_EQUAL(out.output->value(), 0x2a_u64);
+    BOOST_REQUIRE(out.output->script() == script);
+}
+
+BOOST_AUTO_TEST_CASE(output__put__pay_taproot__compressed)
+{
+    const auto program = base16_chunk(
+        "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const chain::script script
+    {
+        splice(data_chunk{ 0x51, 0x20 }, program),
+        false
+    };
+    const table::output::slab slab{ {}, 0x56341201_u32, 0x2a_u64, script };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer().size(), 4u + 1u + 2u + 32u);
+    BOOST_REQUIRE_EQUAL(body_store.buffer().at(5), table::output::escape);
+    BOOST_REQUIRE_EQUAL(body_store.buffer().at(6), table::output::pay_taproot);
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE(element == slab);
+}
+
+BOOST_AUTO_TEST_CASE(output__put__nonstandard_script__size_prefixed)
+{
+    // Scripts of all single byte sizes retain the minimal size prefix.
+    const chain::script script{ data_chunk(0xfc, 0x61), false };
+    const table::output::slab slab{ {}, 0x56341201_u32, 0x2a_u64, script };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer().size(), 4u + 1u + 1u + 0xfcu);
+    BOOST_REQUIRE_EQUAL(body_store.buffer().at(5), uint8_t{ 0xfc });
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE(element == slab);
+}
+
+BOOST_AUTO_TEST_CASE(output__get__untagged_pay_key_hash__expected)
+{
+    // Template scripts stored in size prefixed form (without tag) are read.
+    const auto bytes = base16_chunk(
+        "76a914000102030405060708090a0b0c0d0e0f1011121388ac");
+    const chain::script script{ bytes, false };
+    auto body_file = splice(data_chunk{ 0x01, 0x12, 0x34, 0x56, 0x2a,
+        narrow_cast<uint8_t>(bytes.size()) }, bytes);
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{ body_file };
+    const table::output instance{ head_store, body_store };
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE_EQUAL(element.parent_fk, 0x56341201_u32);
+    BOOST_REQUIRE_EQUAL(element.value, 0x2a_u64);
+    BOOST_REQUIRE(element.script == script);
+}
+
+BOOST_AUTO_TEST_CASE(output__get__invalid_tag__false)
+{
+    data_chunk body_file{ 0x01, 0x12, 0x34, 0x56, 0x2a,
+        table::output::escape, 0x06, 0x00 };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{ body_file };
+    const table::output instance{ head_store, body_store };
+
+    table::output::slab element{};
+    BOOST_REQUIRE(!instance.get<table::output::slab>(0, element));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
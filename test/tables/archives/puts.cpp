@@ -110,4 +110,53 @@ BOOST_AUTO_TEST_CASE(puts__put__get__expected)
     BOOST_REQUIRE(slab3.out_fks == expected3.out_fks);
 }
 
+BOOST_AUTO_TEST_CASE(puts__put__contiguous_spends__first_spend_only)
+{
+    const table::puts::slab expected
+    {
+        {}, // schema::puts [all const static members]
+        std_vector<uint32_t>
+        {
+            0x56341241_u32,
+            0x56341242_u32,
+            0x56341243_u32
+        },
+        std_vector<uint64_t>
+        {
+            0x0000007856341244_u64
+        }
+    };
+    const data_chunk expected_body
+    {
+        0x41, 0x12, 0x34, 0x56,
+        0x44, 0x12, 0x34, 0x56, 0x78
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::puts instance{ head_store, body_store };
+    BOOST_REQUIRE(expected.contiguous());
+    BOOST_REQUIRE(!instance.put_link(expected).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::puts::slab slab{};
+    slab.spend_fks.resize(3);
+    slab.out_fks.resize(1);
+    BOOST_REQUIRE(instance.get(0, slab));
+    BOOST_REQUIRE(slab == expected);
+
+    table::puts::get_spends spends{};
+    spends.spend_fks.resize(3);
+    BOOST_REQUIRE(instance.get(0, spends));
+    BOOST_REQUIRE(spends.spend_fks == expected.spend_fks);
+
+    table::puts::get_spend_at spend{ {}, 2 };
+    BOOST_REQUIRE(instance.get(0, spend));
+    BOOST_REQUIRE_EQUAL(spend.spend_fk, 0x56341243_u32);
+
+    table::puts::get_output_at output{};
+    BOOST_REQUIRE(instance.get(4, output));
+    BOOST_REQUIRE_EQUAL(output.out_fk, 0x0000007856341244_u64);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -90,7 +90,7 @@ BOOST_AUTO_TEST_CASE(transaction__put__get__expected)
 
     BOOST_REQUIRE(instance.get(1, element));
     BOOST_REQUIRE(element == expected);
-    BOOST_REQUIRE_EQUAL(element.outs_fk(), element.puts_fk + (element.ins_count * 4));
+    BOOST_REQUIRE_EQUAL(element.outs_fk(), element.puts_fk + 4u);
 }
 
 BOOST_AUTO_TEST_CASE(transaction__put__get_key__expected)
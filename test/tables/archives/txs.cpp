@@ -22,7 +22,7 @@
 BOOST_AUTO_TEST_SUITE(txs_tests)
 
 using namespace system;
-constexpr search<schema::txs::sk> key = base16_array("112233");
+constexpr search<schema::txs::sk> key = base16_array("010000");
 const table::txs::slab expected0{};
 const table::txs::slab expected1
 {
@@ -60,7 +60,7 @@ const data_chunk expected_file
     0xff, 0xff, 0xff, 0xff, 0xff,
 
     // key
-    0x11, 0x22, 0x33,
+    0x01, 0x00, 0x00,
 
     // slab0 (count) [0]
     0x00, 0x00, 0x00,
@@ -76,7 +76,7 @@ const data_chunk expected_file
     0x00, 0x00, 0x00, 0x00, 0x00,
 
     // key
-    0x11, 0x22, 0x33,
+    0x01, 0x00, 0x00,
 
     // slab1 (count) [1]
     0x01, 0x00, 0x00,
@@ -93,7 +93,7 @@ const data_chunk expected_file
     0x0e, 0x00, 0x00, 0x00, 0x00,
 
     // key
-    0x11, 0x22, 0x33,
+    0x01, 0x00, 0x00,
 
     // slab2 (count) [2]
     0x02, 0x00, 0x00,
@@ -111,7 +111,7 @@ const data_chunk expected_file
     0x20, 0x00, 0x00, 0x00, 0x00,
 
     // key
-    0x11, 0x22, 0x33,
+    0x01, 0x00, 0x00,
 
     // slab3 (count) [3]
     0x03, 0x00, 0x00,
@@ -22,37 +22,37 @@
 BOOST_AUTO_TEST_SUITE(neutrino_tests)
 
 using namespace system;
-const table::neutrino::key key1{ 0x01, 0x02, 0x03 };
-const table::neutrino::key key2{ 0xa1, 0xa2, 0xa3 };
+const table::neutrino::key key1{ 0x01, 0x00, 0x00 };
+const table::neutrino::key key2{ 0x03, 0x00, 0x00 };
 const table::neutrino::slab slab1{ {}, null_hash, { 0x42 } };
 const table::neutrino::slab slab2{ {}, one_hash,  { 0xab, 0xcd, 0xef } };
 const data_chunk expected_head = base16_chunk
 (
     "0000000000"
     "ffffffffff"
-    "2a00000000"
-    "ffffffffff"
+    "0000000000"
     "ffffffffff"
+    "2a00000000"
     "ffffffffff"
 );
 const data_chunk closed_head = base16_chunk
 (
     "5600000000"
     "ffffffffff"
-    "2a00000000"
-    "ffffffffff"
+    "0000000000"
     "ffffffffff"
+    "2a00000000"
     "ffffffffff"
 );
 const data_chunk expected_body = base16_chunk
 (
     "ffffffffff"
-    "010203"     // key1
+    "010000"     // key1
     "0000000000000000000000000000000000000000000000000000000000000000" // null_hash
     "0142"       // size/bytes
 
-    "0000000000" // next->
-    "a1a2a3"     // key2
+    "ffffffffff" // next->end
+    "030000"     // key2
     "0100000000000000000000000000000000000000000000000000000000000000" // one_hash
     "03abcdef"   // size/bytes
 );
@@ -76,6 +76,12 @@ BOOST_AUTO_TEST_CASE(neutrino__put__two__expected)
     BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
     BOOST_REQUIRE(instance.close());
     BOOST_REQUIRE_EQUAL(head_store.buffer(), closed_head);
+
+    table::neutrino::slab out{};
+    BOOST_REQUIRE(instance.find(key1, out));
+    BOOST_REQUIRE(out == slab1);
+    BOOST_REQUIRE(instance.find(key2, out));
+    BOOST_REQUIRE(out == slab2);
 }
 
 BOOST_AUTO_TEST_CASE(neutrino__get__two__expected)
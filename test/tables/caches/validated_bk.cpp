@@ -22,37 +22,37 @@
 BOOST_AUTO_TEST_SUITE(validated_bk_tests)
 
 using namespace system;
-const table::validated_bk::key key1{ 0x01, 0x02, 0x03 };
-const table::validated_bk::key key2{ 0xa1, 0xa2, 0xa3 };
+const table::validated_bk::key key1{ 0x01, 0x00, 0x00 };
+const table::validated_bk::key key2{ 0x03, 0x00, 0x00 };
 const table::validated_bk::slab slab1{ {}, 0x42, 0x1122334455667788 };
 const table::validated_bk::slab slab2{ {}, 0xab, 0x0000000000000042 };
 const data_chunk expected_head = base16_chunk
 (
     "000000"
     "ffffff"
-    "100000"
-    "ffffff"
+    "000000"
     "ffffff"
+    "100000"
     "ffffff"
 );
 const data_chunk closed_head = base16_chunk
 (
     "180000"
     "ffffff"
-    "100000"
-    "ffffff"
+    "000000"
     "ffffff"
+    "100000"
     "ffffff"
 );
 const data_chunk expected_body = base16_chunk
 (
     "ffffff"  // next->end
-    "010203"  // key1
+    "010000"  // key1
     "42"      // code1
     "ff8877665544332211" // fees1
 
-    "000000"  // next->
-    "a1a2a3"  // key2
+    "ffffff"  // next->end
+    "030000"  // key2
     "ab"      // code2
     "42"      // fees2
 );
@@ -76,6 +76,12 @@ BOOST_AUTO_TEST_CASE(validated_bk__put__two__expected)
     BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
     BOOST_REQUIRE(instance.close());
     BOOST_REQUIRE_EQUAL(head_store.buffer(), closed_head);
+
+    table::validated_bk::slab out{};
+    BOOST_REQUIRE(instance.find(key1, out));
+    BOOST_REQUIRE(out == slab1);
+    BOOST_REQUIRE(instance.find(key2, out));
+    BOOST_REQUIRE(out == slab2);
 }
 
 BOOST_AUTO_TEST_CASE(validated_bk__get__two__expected)
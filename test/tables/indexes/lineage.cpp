@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test.hpp"
+#include "../../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(lineage_tests)
+
+using namespace system;
+const table::lineage::record in1{ {}, 0xaabbccdd, 0x01020304, 0x11121314, 0x21222324, 0xaa000001, true };
+const table::lineage::record in2{ {}, 0x00ffffff, 0x05060708, 0x15161718, 0x25262728, 0x00000000, true };
+const table::lineage::record out1{ {}, 0x00bbccdd, 0x01020304, 0x11121314, 0x21222324, 0x00000001, true };
+const table::lineage::record out2 = in2;
+const data_chunk expected_head = base16_chunk
+(
+    "000000"
+);
+const data_chunk closed_head = base16_chunk
+(
+    "030000"
+);
+const data_chunk expected_body = base16_chunk
+(
+    "ddccbb"   // parent_fk1
+    "04030201" // version1
+    "14131211" // timestamp1
+    "24232221" // bits1
+    "010000"   // height1
+    "01"       // set1
+
+    "000000"   // zero (not set)
+    "00000000"
+    "00000000"
+    "00000000"
+    "000000"
+    "00"
+
+    "ffffff"   // parent_fk2 (genesis)
+    "08070605" // version2
+    "18171615" // timestamp2
+    "28272625" // bits2
+    "000000"   // height2
+    "01"       // set2
+);
+
+BOOST_AUTO_TEST_CASE(lineage__set__two__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::lineage instance{ head_store, body_store };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.set(2u, in2));
+    BOOST_REQUIRE(instance.set(0u, in1));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), expected_head);
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), closed_head);
+}
+
+BOOST_AUTO_TEST_CASE(lineage__get__three__expected)
+{
+    auto head = expected_head;
+    auto body = expected_body;
+    test::chunk_storage head_store{ head };
+    test::chunk_storage body_store{ body };
+    table::lineage instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), expected_head);
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::lineage::record out{};
+    BOOST_REQUIRE(instance.get(0u, out));
+    BOOST_REQUIRE(out == out1);
+    BOOST_REQUIRE(out.is_set());
+    BOOST_REQUIRE(instance.get(1u, out));
+    BOOST_REQUIRE(!out.is_set());
+    BOOST_REQUIRE(instance.get(2u, out));
+    BOOST_REQUIRE(out == out2);
+    BOOST_REQUIRE(out.is_set());
+    BOOST_REQUIRE(!instance.get(3u, out));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2011-2023 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test.hpp"
+#include "../../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(strong_tests)
+
+using namespace system;
+const table::strong::record in1{ {}, 0xaabbccdd, true, true };
+const table::strong::record in2{ {}, 0x11223344, false, true };
+const table::strong::record out1{ {}, 0x00bbccdd, true, true };
+const table::strong::record out2{ {}, 0x00223344, false, true };
+const data_chunk expected_head = base16_chunk
+(
+    "00000000"
+);
+const data_chunk closed_head = base16_chunk
+(
+    "03000000"
+);
+const data_chunk expected_body = base16_chunk
+(
+    "ddccbb"   // header_fk1
+    "01"       // positive
+    "01"       // set
+
+    "000000"   // zero (not set)
+    "00"
+    "00"
+
+    "443322"   // header_fk2
+    "00"       // negative
+    "01"       // set
+);
+
+BOOST_AUTO_TEST_CASE(strong__set__two__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::strong instance{ head_store, body_store };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.set(2u, in2));
+    BOOST_REQUIRE(instance.set(0u, in1));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), expected_head);
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+    BOOST_REQUIRE(instance.close());
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), closed_head);
+}
+
+BOOST_AUTO_TEST_CASE(strong__get__three__expected)
+{
+    auto head = expected_head;
+    auto body = expected_body;
+    test::chunk_storage head_store{ head };
+    test::chunk_storage body_store{ body };
+    table::strong instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(head_store.buffer(), expected_head);
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::strong::record out{};
+    BOOST_REQUIRE(instance.get(0u, out));
+    BOOST_REQUIRE(out == out1);
+    BOOST_REQUIRE(out.is_strong());
+    BOOST_REQUIRE(instance.get(1u, out));
+    BOOST_REQUIRE(!out.is_set());
+    BOOST_REQUIRE(!out.is_strong());
+    BOOST_REQUIRE(instance.get(2u, out));
+    BOOST_REQUIRE(out == out2);
+    BOOST_REQUIRE(!out.is_strong());
+}
+
+BOOST_AUTO_TEST_SUITE_END()